@@ -19,6 +19,7 @@
 */
 
 #include "LucyRTL8125Ethernet.hpp"
+#include "LucyRTL8125Offload.hpp"
 
 #pragma mark --- function prototypes ---
 
@@ -47,6 +48,19 @@ bool LucyRTL8125::init(OSDictionary *properties)
         txQueue = NULL;
         interruptSource = NULL;
         timerSource = NULL;
+        txStallSource = NULL;
+        pktGenSource = NULL;
+        captureSource = NULL;
+        statsPageSource = NULL;
+        ptpTxSource = NULL;
+        txStallTimeout = 0;
+        txStallPauses = 0;
+        bringUpLock = NULL;
+        bringUpCall = NULL;
+        phyConfigured = false;
+        bringUpPending = false;
+        bringUpDone = false;
+        phaseCount = 0;
         netif = NULL;
         netStats = NULL;
         etherStats = NULL;
@@ -59,10 +73,79 @@ bool LucyRTL8125::init(OSDictionary *properties)
         spareNum = 0;
         txMbufCursor = NULL;
         rxBufArrayMem = NULL;
+        rxDescArray = NULL;
+        rxDescV3 = false;
         txBufArrayMem = NULL;
         statBufDesc = NULL;
         statPhyAddr = (IOPhysicalAddress64)NULL;
         statData = NULL;
+        statDict = NULL;
+        statCount = kStatLegacyCount;
+        bzero(statTotals, sizeof(statTotals));
+        bzero(statLast, sizeof(statLast));
+        bzero(statNums, sizeof(statNums));
+        pathCounters = NULL;
+        pathDict = NULL;
+        bzero(pathNums, sizeof(pathNums));
+        bzero(latHist, sizeof(latHist));
+        bzero(traceRing, sizeof(traceRing));
+        traceCount = 0;
+        latDict = NULL;
+        bzero(latNums, sizeof(latNums));
+        statsPageDesc = NULL;
+        statsPage = NULL;
+        genBufDesc = NULL;
+        genDmaCmd = NULL;
+        genBuf = NULL;
+        genPhyAddr = (IOPhysicalAddress64)NULL;
+        selfTestSize = 0;
+        selfTestRxFrames = selfTestRxErrors = selfTestRxBusy = 0;
+        bzero(&pktGenParams, sizeof(pktGenParams));
+        pktGenSent = pktGenDropped = pktGenRingFull = 0;
+        pktGenCredit = pktGenStamp = 0;
+        pktGenStartTime = pktGenStopTime = 0;
+        pktGenSlot = 0;
+        captureDesc = NULL;
+        captureHdr = NULL;
+        captureOwner = NULL;
+        captureLock[kRtlCaptureRx] = captureLock[kRtlCaptureTx] = NULL;
+        bzero(captureState, sizeof(captureState));
+        captureSnapLen = 0;
+        captureBlockSize = 0;
+        captureBlockCount = 0;
+        userQueueDesc = NULL;
+        userQueueDmaCmd = NULL;
+        userTxBufDesc = NULL;
+        userTxDmaCmd = NULL;
+        userQueueHdr = NULL;
+        userQueueOwner = NULL;
+        userQueueSlots[kRtlUserQueueTx] = userQueueSlots[kRtlUserQueueRx] = NULL;
+        userQueueBufs = NULL;
+        userTxDescArray = NULL;
+        userTxPhyAddr = (IOPhysicalAddress64)NULL;
+        bzero(userQueuePages, sizeof(userQueuePages));
+        userQueueLock = NULL;
+        userTxNextIndex = userTxTail = userTxDescIndex = 0;
+        userTxTailPtr = userTxClosePtr = 0;
+        userRxTail = 0;
+        userRxEtherType = 0;
+        ptpLock = NULL;
+        bzero(&ptpClock, sizeof(ptpClock));
+        bzero(ptpStamps, sizeof(ptpStamps));
+        ptpStampHead = ptpStampCount = ptpStampDrops = 0;
+        ptpTxSkipped = ptpTxTimeouts = 0;
+        bzero(&ptpTxStamp, sizeof(ptpTxStamp));
+        ptpTxStart = 0;
+        ptpSavedTime = 0;
+        ptpSavedStamp = 0;
+        ptpTxPending = false;
+        ptpStampEnable = false;
+        ptpStarted = false;
+        latEnable[kLatPathRx] = false;
+        latEnable[kLatPathTx] = false;
+        recoveryTier = kRecoveryQueue;
+        recoveryStart = 0;
+        bzero(recoveryStats, sizeof(recoveryStats));
 
         /* Initialize state flags. */
         stateFlags = 0;
@@ -84,6 +167,7 @@ bool LucyRTL8125::init(OSDictionary *properties)
         pciDeviceData.subsystem_vendor = 0;
         pciDeviceData.subsystem_device = 0;
         linuxData.pci_dev = &pciDeviceData;
+        rtl8125_init_ocp_shadow(&linuxData);
         pollInterval2500 = 0;
         wolCapable = false;
         wolActive = false;
@@ -117,6 +201,26 @@ void LucyRTL8125::free()
             workLoop->removeEventSource(timerSource);
             RELEASE(timerSource);
         }
+        if (txStallSource) {
+            workLoop->removeEventSource(txStallSource);
+            RELEASE(txStallSource);
+        }
+        if (pktGenSource) {
+            workLoop->removeEventSource(pktGenSource);
+            RELEASE(pktGenSource);
+        }
+        if (captureSource) {
+            workLoop->removeEventSource(captureSource);
+            RELEASE(captureSource);
+        }
+        if (statsPageSource) {
+            workLoop->removeEventSource(statsPageSource);
+            RELEASE(statsPageSource);
+        }
+        if (ptpTxSource) {
+            workLoop->removeEventSource(ptpTxSource);
+            RELEASE(ptpTxSource);
+        }
         workLoop->release();
         workLoop = NULL;
     }
@@ -135,7 +239,19 @@ void LucyRTL8125::free()
     freeTxResources();
     freeRxResources();
     freeStatResources();
+    freeGenResources();
+    freeCaptureResources();
+    freeUserQueueResources();
+    freePtpResources();
     
+    if (bringUpCall) {
+        thread_call_free(bringUpCall);
+        bringUpCall = NULL;
+    }
+    if (bringUpLock) {
+        IOLockFree(bringUpLock);
+        bringUpLock = NULL;
+    }
     DebugLog("free() <===\n");
     
     super::free();
@@ -145,6 +261,8 @@ bool LucyRTL8125::start(IOService *provider)
 {
     bool result;
     
+    markPhase(kPhaseStart);
+
     result = super::start(provider);
     
     if (!result) {
@@ -206,11 +324,35 @@ bool LucyRTL8125::start(IOService *provider)
         goto error_dma3;
     }
 
+    if (!setupGenResources())
+        IOLog("Self test and packet generator not available.\n");
+
+    if (!setupCaptureResources())
+        IOLog("Packet capture not available.\n");
+
+    if (!setupUserQueueResources())
+        IOLog("User queue not available.\n");
+
+    if (linuxData.HwSuppPtpVer && !setupPtpResources())
+        IOLog("PTP clock not available.\n");
+    
     if (!initEventSources(provider)) {
         IOLog("initEventSources() failed.\n");
         goto error_src;
     }
     
+    /*
+     * Power up the chip, configure the EPHY and patch the PHY in the
+     * background while the interface is registered. enable() waits for
+     * it to complete. Without the thread call it is done by enable().
+     */
+    bringUpLock = IOLockAlloc();
+    bringUpCall = thread_call_allocate(bringUpThread, this);
+    
+    if (bringUpLock && bringUpCall) {
+        bringUpPending = true;
+        thread_call_enter(bringUpCall);
+    }
     result = attachInterface(reinterpret_cast<IONetworkInterface**>(&netif));
 
     if (!result) {
@@ -224,6 +366,11 @@ done:
     return result;
 
 error_src:
+    waitForBringUp();
+    freePtpResources();
+    freeUserQueueResources();
+    freeCaptureResources();
+    freeGenResources();
     freeStatResources();
 
 error_dma3:
@@ -251,6 +398,8 @@ void LucyRTL8125::stop(IOService *provider)
 {
     UInt32 i;
     
+    waitForBringUp();
+
     if (netif) {
         detachInterface(netif);
         netif = NULL;
@@ -264,6 +413,26 @@ void LucyRTL8125::stop(IOService *provider)
             workLoop->removeEventSource(timerSource);
             RELEASE(timerSource);
         }
+        if (txStallSource) {
+            workLoop->removeEventSource(txStallSource);
+            RELEASE(txStallSource);
+        }
+        if (pktGenSource) {
+            workLoop->removeEventSource(pktGenSource);
+            RELEASE(pktGenSource);
+        }
+        if (captureSource) {
+            workLoop->removeEventSource(captureSource);
+            RELEASE(captureSource);
+        }
+        if (statsPageSource) {
+            workLoop->removeEventSource(statsPageSource);
+            RELEASE(statsPageSource);
+        }
+        if (ptpTxSource) {
+            workLoop->removeEventSource(ptpTxSource);
+            RELEASE(ptpTxSource);
+        }
         workLoop->release();
         workLoop = NULL;
     }
@@ -274,6 +443,10 @@ void LucyRTL8125::stop(IOService *provider)
     for (i = MEDIUM_INDEX_AUTO; i < MEDIUM_INDEX_COUNT; i++)
         mediumTable[i] = NULL;
 
+    freePtpResources();
+    freeUserQueueResources();
+    freeCaptureResources();
+    freeGenResources();
     freeStatResources();
     freeRxResources();
     freeTxResources();
@@ -317,6 +490,10 @@ IOReturn LucyRTL8125::setPowerState(unsigned long powerStateOrdinal, IOService *
     }
     DebugLog("switching to power state %lu.\n", powerStateOrdinal);
     
+    /* The chip loses the background bring-up's work in D3. */
+    waitForBringUp();
+    bringUpDone = false;
+    
     if (powerStateOrdinal == kPowerStateOff)
         commandGate->runAction(setPowerStateSleepAction);
     else
@@ -334,6 +511,8 @@ void LucyRTL8125::systemWillShutdown(IOOptionBits specifier)
 {
     DebugLog("systemWillShutdown() ===>\n");
     
+    waitForBringUp();
+
     if ((kIOMessageSystemWillPowerOff | kIOMessageSystemWillRestart) & specifier) {
         disable(netif);
         
@@ -360,6 +539,8 @@ IOReturn LucyRTL8125::enable(IONetworkInterface *netif)
         result = kIOReturnSuccess;
         goto done;
     }
+    waitForBringUp();
+
     if (!pciDevice || pciDevice->isOpen()) {
         IOLog("Unable to open PCI device.\n");
         goto done;
@@ -380,9 +561,13 @@ IOReturn LucyRTL8125::enable(IONetworkInterface *netif)
 
     txDescDoneCount = txDescDoneLast = 0;
     deadlockWarn = 0;
+    recoveryTier = kRecoveryQueue;
+    recoveryStart = 0;
     needsUpdate = false;
     set_bit(__ENABLED, &stateFlags);
     clear_bit(__POLL_MODE, &stateFlags);
+    
+    statsPageSource->setTimeoutMS(kStatsPageMS);
 
     result = kIOReturnSuccess;
     
@@ -421,8 +606,16 @@ IOReturn LucyRTL8125::disable(IONetworkInterface *netif)
     clear_mask((__ENABLED_M | __LINK_UP_M | __POLL_MODE_M | __POLLING_M), &stateFlags);
 
     timerSource->cancelTimeout();
+    txStallSource->cancelTimeout();
+    statsPageSource->cancelTimeout();
+    ptpTxSource->cancelTimeout();
+    ptpTxPending = false;
+    clear_bit(__TX_WATCH, &stateFlags);
     needsUpdate = false;
     txDescDoneCount = txDescDoneLast = 0;
+    
+    if (test_bit(__PKTGEN, &stateFlags))
+        pktGenStop();
 
     /* Disable interrupt as we are using msi. */
     interruptSource->disable();
@@ -430,6 +623,7 @@ IOReturn LucyRTL8125::disable(IONetworkInterface *netif)
     disableRTL8125();
     
     clearRxTxRings();
+    updateStatsPage();
     
     if (pciDevice && pciDevice->isOpen())
         pciDevice->close(this);
@@ -449,6 +643,7 @@ IOReturn LucyRTL8125::outputStart(IONetworkInterface *interface, IOOptionBits op
     UInt32 cmd;
     UInt32 opts2;
     UInt32 offloadFlags;
+    UInt32 offloadClass;
     UInt32 mss;
     UInt32 len;
     UInt32 tcpOff;
@@ -458,6 +653,8 @@ IOReturn LucyRTL8125::outputStart(IONetworkInterface *interface, IOOptionBits op
     UInt32 lastSeg;
     UInt32 index;
     UInt32 i;
+    UInt64 *txCount = pathCounters[kPathContextTx].count;
+    UInt64 now = 0;
     
     //DebugLog("outputStart() ===>\n");
     
@@ -465,6 +662,8 @@ IOReturn LucyRTL8125::outputStart(IONetworkInterface *interface, IOOptionBits op
         DebugLog("Interface down. Dropping packets.\n");
         goto done;
     }
+    txCount[kPathTxCalls]++;
+
     while ((txNumFreeDesc > (kMaxSegs + 3)) && (interface->dequeueOutputPackets(1, &m, NULL, NULL, NULL) == kIOReturnSuccess)) {
         cmd = 0;
         opts2 = 0;
@@ -478,55 +677,36 @@ IOReturn LucyRTL8125::outputStart(IONetworkInterface *interface, IOOptionBits op
             continue;
         }
         if (offloadFlags & (MBUF_TSO_IPV4 | MBUF_TSO_IPV6)) {
-            if (offloadFlags & MBUF_TSO_IPV4) {
-                if ((len - kMacHdrLen) > mtu) {
-                    /*
-                     * Fix the pseudo header checksum, get the
-                     * TCP header size and set paylen.
-                     */
+            if ((len - kMacHdrLen) > mtu) {
+                /*
+                 * Fix the pseudo header checksum, get the
+                 * TCP header size and set paylen.
+                 */
+                if (offloadFlags & MBUF_TSO_IPV4) {
                     prepareTSO4(m, &tcpOff, &mss);
-                    
-                    cmd = (GiantSendv4 | (tcpOff << GTTCPHO_SHIFT));
-                    opts2 = ((mss & MSSMask) << MSSShift_8125);
+                    offloadClass = kTxOffloadTSO4;
                 } else {
-                    /*
-                     * There is no need for a TSO4 operation as the packet
-                     * can be sent in one frame.
-                     */
-                    offloadFlags = kChecksumTCP;
-                    opts2 = (TxIPCS_C | TxTCPCS_C);
-                }
-            } else {
-                if ((len - kMacHdrLen) > mtu) {
-                    /* The pseudoheader checksum has to be adjusted first. */
                     prepareTSO6(m, &tcpOff, &mss);
-                    
-                    cmd = (GiantSendv6 | (tcpOff << GTTCPHO_SHIFT));
-                    opts2 = ((mss & MSSMask) << MSSShift_8125);
-                } else {
-                    /*
-                     * There is no need for a TSO6 operation as the packet
-                     * can be sent in one frame.
-                     */
-                    offloadFlags = kChecksumTCPIPv6;
-                    opts2 = (TxTCPCS_C | TxIPV6F_C | (((kMacHdrLen + kIPv6HdrLen) & TCPHO_MAX) << TCPHO_SHIFT));
+                    offloadClass = kTxOffloadTSO6;
                 }
+                cmd = (tcpOff << GTTCPHO_SHIFT);
+                opts2 = ((mss & MSSMask) << MSSShift_8125);
+            } else {
+                /*
+                 * There is no need for a TSO operation as the packet
+                 * can be sent in one frame.
+                 */
+                offloadClass = (offloadFlags & MBUF_TSO_IPV4) ? kTxOffloadTCPv4 : kTxOffloadTCPv6;
             }
         } else {
             /* We use mss as a dummy here because it isn't needed anymore. */
             mbuf_get_csum_requested(m, &offloadFlags, &mss);
-            
-            if (offloadFlags & kChecksumTCP)
-                opts2 = (TxIPCS_C | TxTCPCS_C);
-            else if (offloadFlags & kChecksumTCPIPv6)
-                opts2 = (TxTCPCS_C | TxIPV6F_C | (((kMacHdrLen + kIPv6HdrLen) & TCPHO_MAX) << TCPHO_SHIFT));
-            else if (offloadFlags & kChecksumUDP)
-                opts2 = (TxIPCS_C | TxUDPCS_C);
-            else if (offloadFlags & kChecksumUDPIPv6)
-                opts2 = (TxUDPCS_C | TxIPV6F_C | (((kMacHdrLen + kIPv6HdrLen) & TCPHO_MAX) << TCPHO_SHIFT));
-            else if (offloadFlags & kChecksumIP)
-                opts2 = TxIPCS_C;
+            offloadClass = txCsumClassMap[txCsumClassIndex(offloadFlags)];
         }
+        /* Merge in the precomputed offload bits. */
+        cmd |= txDescTmplTable[offloadClass].opts1;
+        opts2 |= txDescTmplTable[offloadClass].opts2;
+
         /* Finally get the physical segments. */
         numSegs = txMbufCursor->getPhysicalSegmentsWithCoalesce(m, &txSegments[0], kMaxSegs);
 
@@ -537,9 +717,12 @@ IOReturn LucyRTL8125::outputStart(IONetworkInterface *interface, IOOptionBits op
          */
         if (!numSegs) {
             DebugLog("getPhysicalSegmentsWithCoalesce() failed. Dropping packet.\n");
+            txCount[kPathTxCoalesceFail]++;
             freePacket(m);
             continue;
         }
+        txCount[kPathTxPackets]++;
+        txCount[kPathTxDescs] += numSegs;
         OSAddAtomic(-numSegs, &txNumFreeDesc);
         index = txNextDescIndex;
         txNextDescIndex = (txNextDescIndex + numSegs) & kTxDescMask;
@@ -550,6 +733,17 @@ IOReturn LucyRTL8125::outputStart(IONetworkInterface *interface, IOOptionBits op
         /* Next fill in the VLAN tag. */
         opts2 |= (getVlanTagDemand(m, &vlanTag)) ? (OSSwapInt16(vlanTag) | TxVlanTag) : 0;
         
+        if (unlikely(test_bit(__CAPTURE, &stateFlags)))
+            captureFrame(kRtlCaptureTx, m, len, 0, (opts2 & TxVlanTag) ? vlanTag : 0);
+        
+        if (unlikely(ptpStampEnable))
+            ptpTxFrame(m);
+        
+        if (latEnable[kLatPathTx]) {
+            clock_get_uptime(&now);
+            txLatStamp[(index + lastSeg) & kTxDescMask] = now;
+        }
+        
         /* And finally fill in the descriptors. */
         for (i = 0; i < numSegs; i++) {
             desc = &txDescArray[index];
@@ -574,17 +768,125 @@ IOReturn LucyRTL8125::outputStart(IONetworkInterface *interface, IOOptionBits op
         }
         firstDesc->opts1 |= DescOwn;
     }
+    /* The generator's frames queue up behind the stack's packets. */
+    if (unlikely(test_bit(__PKTGEN, &stateFlags)))
+        pktGenPost();
+    
     /* Update tail pointer. */
     WriteReg16(SW_TAIL_PTR0_8125, txTailPtr0 & 0xffff);
+    txCount[kPathTxTailWrites]++;
+    traceEvent(kTraceTxTail, txTailPtr0 & 0xffff, txNumFreeDesc);
+
+    /* Arm the stall detector in case the ring has been idle. */
+    if ((txNumFreeDesc < kNumTxDesc) && !test_and_set_bit(__TX_WATCH, &stateFlags)) {
+        txStallClosePtr = ReadReg16(HW_CLO_PTR0_8125);
+        clock_get_uptime(&txStallStamp);
+        txStallSource->setTimeoutMS(kTxStallCheckMS);
+    }
 
     result = (txNumFreeDesc > (kMaxSegs + 3)) ? kIOReturnSuccess : kIOReturnNoResources;
     
+    if (result == kIOReturnNoResources)
+        txCount[kPathTxRingFull]++;
+    
 done:
     //DebugLog("outputStart() <===\n");
     
     return result;
 }
 
+/*
+ * Post count single segment frames to the tx ring, cycling through the
+ * first slots template frames at addr starting with *slot. The
+ * descriptors have no mbuf attached, so that txInterrupt() just
+ * reclaims them. The same reserve as in outputStart() is kept. Must not
+ * run concurrently with outputStart() and the caller has to update the
+ * tail pointer. Returns the number of frames posted.
+ */
+UInt32 LucyRTL8125::genPostFrames(UInt64 addr, UInt32 size, UInt32 count, UInt32 slots, UInt32 *slot)
+{
+    RtlTxDesc *desc;
+    UInt32 opts1;
+    UInt32 posted = 0;
+    
+    while ((posted < count) && (txNumFreeDesc > (kMaxSegs + 3))) {
+        desc = &txDescArray[txNextDescIndex];
+        opts1 = (size | FirstFrag | LastFrag | DescOwn);
+        
+        if (txNextDescIndex == kTxLastDesc)
+            opts1 |= RingEnd;
+        
+        txMbufArray[txNextDescIndex] = NULL;
+        
+        desc->addr = OSSwapHostToLittleInt64(addr + (*slot * kGenSlotSize));
+        desc->opts2 = 0;
+        desc->opts1 = OSSwapHostToLittleInt32(opts1);
+        
+        if (++(*slot) >= slots)
+            *slot = 0;
+        
+        OSDecrementAtomic(&txNumFreeDesc);
+        ++txNextDescIndex &= kTxDescMask;
+        txTailPtr0++;
+        posted++;
+    }
+    return posted;
+}
+
+/*
+ * Called from outputStart(), which serializes the generator with the
+ * stack's packets. It posts as many frames as the rate allows, leaving
+ * kPktGenReserve descriptors for normal traffic. Credit is accounted in
+ * frames * 10^9, so that the rate doesn't need to be a multiple of the
+ * kick interval.
+ */
+void LucyRTL8125::pktGenPost()
+{
+    UInt64 now, elapsed;
+    UInt64 frames, limit;
+    UInt32 room;
+    UInt32 n;
+    
+    clock_get_uptime(&now);
+    absolutetime_to_nanoseconds(now - pktGenStamp, &elapsed);
+    pktGenStamp = now;
+    
+    if (pktGenParams.rate) {
+        limit = (UInt64)pktGenParams.burst * kSecondScale;
+        
+        if (elapsed > kSecondScale)
+            elapsed = kSecondScale;
+        
+        pktGenCredit += elapsed * pktGenParams.rate;
+        
+        if (pktGenCredit > limit) {
+            pktGenDropped += (pktGenCredit - limit) / kSecondScale;
+            pktGenCredit = limit;
+        }
+        frames = pktGenCredit / kSecondScale;
+    } else {
+        frames = pktGenParams.burst;
+    }
+    if (pktGenParams.count && (frames > (pktGenParams.count - pktGenSent)))
+        frames = pktGenParams.count - pktGenSent;
+    
+    if (!frames)
+        return;
+    
+    room = (txNumFreeDesc > kPktGenReserve) ? (txNumFreeDesc - kPktGenReserve) : 0;
+    
+    if (frames > room) {
+        frames = room;
+        pktGenRingFull++;
+    }
+    n = genPostFrames(genPhyAddr, pktGenParams.frameSize, (UInt32)frames, pktGenParams.flows, &pktGenSlot);
+    
+    if (pktGenParams.rate)
+        pktGenCredit -= (UInt64)n * kSecondScale;
+
+    pktGenSent += n;
+}
+
 void LucyRTL8125::getPacketBufferConstraints(IOPacketBufferConstraints *constraints) const
 {
     DebugLog("getPacketBufferConstraints() ===>\n");
@@ -727,6 +1029,8 @@ IOReturn LucyRTL8125::setPromiscuousMode(bool active)
 
     DebugLog("setPromiscuousMode() ===>\n");
     
+    waitForBringUp();
+    
     if (active) {
         DebugLog("Promiscuous mode enabled.\n");
         rxMode = (AcceptBroadcast | AcceptMulticast | AcceptMyPhys | AcceptAllPhys);
@@ -760,6 +1064,8 @@ IOReturn LucyRTL8125::setMulticastMode(bool active)
 
     DebugLog("setMulticastMode() ===>\n");
     
+    waitForBringUp();
+    
     if (active) {
         rxMode = (AcceptBroadcast | AcceptMulticast | AcceptMyPhys);
         mcFilter[0] = *filterAddr++;
@@ -791,6 +1097,8 @@ IOReturn LucyRTL8125::setMulticastList(IOEthernetAddress *addrs, UInt32 count)
     
     DebugLog("setMulticastList() ===>\n");
     
+    waitForBringUp();
+    
     if (count <= kMCFilterLimit) {
         for (i = 0; i < count; i++, addrs++) {
             bitNumber = ether_crc(6, reinterpret_cast<unsigned char *>(addrs)) >> 26;
@@ -888,6 +1196,8 @@ IOReturn LucyRTL8125::setHardwareAddress(const IOEthernetAddress *addr)
     
     DebugLog("setHardwareAddress() ===>\n");
     
+    waitForBringUp();
+    
     if (addr) {
         bcopy(addr->bytes, &currMacAddr.bytes, kIOEthernetAddressSize);
         rtl8125_rar_set(&linuxData, (UInt8 *)&currMacAddr.bytes);
@@ -905,6 +1215,13 @@ IOReturn LucyRTL8125::selectMedium(const IONetworkMedium *medium)
     
     DebugLog("selectMedium() ===>\n");
     
+    waitForBringUp();
+    
+    /* The self test owns the rings. */
+    if (test_bit(__SELF_TEST, &stateFlags)) {
+        result = kIOReturnBusy;
+        goto done;
+    }
     if (medium) {
         autoneg = AUTONEG_DISABLE;
         flowCtl = kFlowControlOff;
@@ -1043,6 +1360,8 @@ IOReturn LucyRTL8125::setMaxPacketSize(UInt32 maxSize)
 
     DebugLog("setMaxPacketSize() ===>\n");
     
+    waitForBringUp();
+    
     if (maxSize <= (rxBufferSize - 2)) {
         mtu = maxSize - (ETH_HLEN + ETH_FCS_LEN);
         DebugLog("maxSize: %u, mtu: %u\n", maxSize, mtu);
@@ -1067,11 +1386,18 @@ IOReturn LucyRTL8125::setMaxPacketSize(UInt32 maxSize)
         }
         if (ifnet_set_offload(ifnet, offload))
             IOLog("Error setting hardware offload: %x!\n", offload);
-        /* Force reinitialization. */
-        setLinkDown();
-        timerSource->cancelTimeout();
-        restartRTL8125();
-        
+
+        /*
+         * The Rx buffers and RxMaxSize are always sized for the
+         * largest packet we accept, so that the rings and the PHY
+         * can stay as they are. The only MAC register depending on
+         * the MTU is the EEE Tx idle timer. Packets already queued
+         * for transmission have been checked against the old MTU
+         * and are still valid.
+         */
+        if (test_bit(__ENABLED, &stateFlags))
+            WriteReg16(EEE_TXIDLE_TIMER_8125, mtu + ETH_HLEN + 0x20);
+
         result = kIOReturnSuccess;
     }
     
@@ -1088,14 +1414,20 @@ void LucyRTL8125::pciErrorInterrupt()
     UInt16 statusReg = pciDevice->configRead16(kIOPCIConfigStatus);
     
     DebugLog("PCI error: cmdReg=0x%x, statusReg=0x%x\n", cmdReg, statusReg);
+    traceEvent(kTracePciError, cmdReg, statusReg);
+    snapshotTrace(kTracePciError);
 
     cmdReg |= (kIOPCICommandSERR | kIOPCICommandParityError);
     statusReg &= (kIOPCIStatusParityErrActive | kIOPCIStatusSERRActive | kIOPCIStatusMasterAbortActive | kIOPCIStatusTargetAbortActive | kIOPCIStatusTargetAbortCapable);
     pciDevice->configWrite16(kIOPCIConfigCommand, cmdReg);
     pciDevice->configWrite16(kIOPCIConfigStatus, statusReg);
     
-    /* Reset the NIC in order to resume operation. */
-    restartRTL8125();
+    /*
+     * Reset the NIC in order to resume operation. A ring reset
+     * doesn't reset the DMA engine so that we start with a MAC
+     * reset at least.
+     */
+    recoverRTL8125((recoveryTier > kRecoveryMAC) ? recoveryTier : kRecoveryMAC);
 }
 
 void LucyRTL8125::txInterrupt()
@@ -1104,6 +1436,7 @@ void LucyRTL8125::txInterrupt()
     UInt32 nextClosePtr = ReadReg16(HW_CLO_PTR0_8125);
     UInt32 oldDirtyIndex = txDirtyDescIndex;
     UInt32 numDone;
+    UInt64 now = 0;
 
     numDone = ((nextClosePtr - txClosePtr0) & 0xffff);
     
@@ -1111,12 +1444,22 @@ void LucyRTL8125::txInterrupt()
     
     txClosePtr0 = nextClosePtr;
 
+    if (numDone)
+        traceEvent(kTraceTxClose, nextClosePtr, numDone);
+    
     while (numDone-- > 0) {
         m = txMbufArray[txDirtyDescIndex];
         txMbufArray[txDirtyDescIndex] = NULL;
 
-        if (m)
+        if (m) {
+            if (latEnable[kLatPathTx]) {
+                if (!now)
+                    clock_get_uptime(&now);
+                
+                addLatencySample(kLatPathTx, now - txLatStamp[txDirtyDescIndex]);
+            }
             freePacket(m, kDelayFree);
+        }
 
         txDescDoneCount++;
         OSIncrementAtomic(&txNumFreeDesc);
@@ -1133,22 +1476,69 @@ void LucyRTL8125::txInterrupt()
 UInt32 LucyRTL8125::rxInterrupt(IONetworkInterface *interface, uint32_t maxCount, IOMbufQueue *pollQueue, void *context)
 {
     IOPhysicalSegment rxSegment;
-    RtlRxDesc *desc = &rxDescArray[rxNextDescIndex];
+    RtlRxDescV3 *ptpDesc;
+    RtlPtpStamp ptpRxStamp;
+    const UInt8 *ptpHdr;
     mbuf_t bufPkt, newPkt;
     UInt64 addr;
+    UInt64 ptpTime, stamp;
     UInt32 opts1, opts2;
     UInt32 descStatus1, descStatus2;
+    UInt32 ptpStatus;
     UInt32 pktSize;
     UInt32 goodPkts = 0;
+    UInt64 *rxCount = pathCounters[kPathContextRx].count;
+    UInt64 testStart = 0, testEnd;
     bool replaced;
     
-    while (!((descStatus1 = OSSwapLittleToHostInt32(desc->opts1)) & DescOwn) && (goodPkts < maxCount)) {
+    /* Status bits which differ between the descriptor formats. */
+    const UInt32 fragMask = rxDescV3 ? (FirstFrag_V3 | LastFrag_V3) : (FirstFrag | LastFrag);
+    const UInt32 errMask = rxDescV3 ? RxRES_V3 : RxRES;
+    const UInt32 lenErrMask = rxDescV3 ? (RxRWT_V3 | RxRUNT_V3) : (RxRWT | RxRUNT);
+    const UInt32 crcMask = rxDescV3 ? RxCRC_V3 : RxCRC;
+    const UInt32 sizeMask = rxDescV3 ? 0x3fff : 0x1fff;
+    
+    rxCount[kPathRxCalls]++;
+    
+    if (unlikely(test_bit(__SELF_TEST, &stateFlags)))
+        clock_get_uptime(&testStart);
+
+    while (!((descStatus1 = OSSwapLittleToHostInt32(*rxDescOpts1(rxNextDescIndex))) & DescOwn) && (goodPkts < maxCount)) {
         opts1 = (rxNextDescIndex == kRxLastDesc) ? (RingEnd | DescOwn) : DescOwn;
         opts2 = 0;
         addr = 0;
+        ptpTime = 0;
+        
+        /*
+         * The chip follows the descriptor of a PTP event message with
+         * one holding its time stamp. It's taken together with the
+         * frame, so that the time stamp's descriptor just needs to be
+         * returned to the chip with its buffer's address restored.
+         */
+        if (unlikely(rxDescV3 && (rxDescTypeV3(descStatus1) != RXDESC_TYPE_NORMAL))) {
+            if (rxDescTypeV3(descStatus1) == RXDESC_TYPE_PTP) {
+                rearmRxDesc(rxNextDescIndex);
+                ++rxNextDescIndex &= kRxDescMask;
+                continue;
+            }
+            ptpDesc = &((RtlRxDescV3 *)rxDescArray)[(rxNextDescIndex + 1) & kRxDescMask];
+            ptpStatus = OSSwapLittleToHostInt32(ptpDesc->opts1);
+            
+            /* Come back when the chip has written the time stamp too. */
+            if (ptpStatus & DescOwn)
+                break;
+            
+            if (rxDescTypeV3(ptpStatus) == RXDESC_TYPE_PTP) {
+                stamp = OSSwapLittleToHostInt64(ptpDesc->addr);
+                ptpTime = ((((UInt64)(OSSwapLittleToHostInt32(ptpDesc->opts2) & 0xffff)) << 32) | (stamp >> 32)) * kPtpNsPerSec;
+                ptpTime += (stamp & 0xffffffff);
+            }
+        }
+        if (latEnable[kLatPathRx] && (goodPkts < kNumRxDesc))
+            clock_get_uptime(&rxLatStamp[goodPkts]);
         
         /* As we don't support fragmented packets we treat them as errors. */
-        if (unlikely((descStatus1 & (FirstFrag|LastFrag)) != (FirstFrag|LastFrag))) {
+        if (unlikely((descStatus1 & fragMask) != fragMask)) {
             DebugLog("Fragmented packet.\n");
             etherStats->dot3StatsEntry.frameTooLongs++;
             opts1 |= rxBufferSize;
@@ -1156,21 +1546,21 @@ UInt32 LucyRTL8125::rxInterrupt(IONetworkInterface *interface, uint32_t maxCount
         }
         
         /* Drop packets with receive errors. */
-        if (unlikely(descStatus1 & RxRES)) {
+        if (unlikely(descStatus1 & errMask)) {
             DebugLog("Rx error.\n");
             
-            if (descStatus1 & (RxRWT | RxRUNT))
+            if (descStatus1 & lenErrMask)
                 etherStats->dot3StatsEntry.frameTooLongs++;
 
-            if (descStatus1 & RxCRC)
+            if (descStatus1 & crcMask)
                 etherStats->dot3StatsEntry.fcsErrors++;
 
             opts1 |= rxBufferSize;
             goto nextDesc;
         }
         
-        descStatus2 = OSSwapLittleToHostInt32(desc->opts2);
-        pktSize = (descStatus1 & 0x1fff) - kIOEthernetCRCSize;
+        descStatus2 = OSSwapLittleToHostInt32(*rxDescOpts2(rxNextDescIndex));
+        pktSize = (descStatus1 & sizeMask) - kIOEthernetCRCSize;
         bufPkt = rxMbufArray[rxNextDescIndex];
         //DebugLog("rxInterrupt(): descStatus1=0x%x, descStatus2=0x%x, pktSize=%u\n", descStatus1, descStatus2, pktSize);
         
@@ -1184,6 +1574,7 @@ UInt32 LucyRTL8125::rxInterrupt(IONetworkInterface *interface, uint32_t maxCount
             if (spareNum > 1) {
                 DebugLog("Use spare packet to replace buffer (%d available).\n", spareNum);
                 OSDecrementAtomic(&spareNum);
+                rxCount[kPathRxSpareUsed]++;
 
                 newPkt = bufPkt;
                 replaced = true;
@@ -1199,11 +1590,14 @@ UInt32 LucyRTL8125::rxInterrupt(IONetworkInterface *interface, uint32_t maxCount
              */
             DebugLog("replaceOrCopyPacket() failed.\n");
             etherStats->dot3RxExtraEntry.resourceErrors++;
+            rxCount[kPathRxNoBuffer]++;
             opts1 |= rxBufferSize;
             goto nextDesc;
         }
 handle_pkt:
         /* If the packet was replaced we have to update the descriptor's buffer address. */
+        rxCount[replaced ? kPathRxReplaced : kPathRxCopied]++;
+
         if (replaced) {
             if (rxMbufCursor->getPhysicalSegments(bufPkt, &rxSegment, 1) != 1) {
                 DebugLog("getPhysicalSegments() failed.\n");
@@ -1221,40 +1615,73 @@ handle_pkt:
         /* Set the length of the buffer. */
         mbuf_setlen(newPkt, pktSize);
 
-        getChecksumResult(newPkt, descStatus1, descStatus2);
+        getChecksumResult(newPkt, rxDescV3 ? rxCsumIndexV3(descStatus2) : rxCsumIndex(descStatus1, descStatus2));
 
         /* Also get the VLAN tag if there is any. */
         if (descStatus2 & RxVlanTag)
             setVlanTag(newPkt, OSSwapInt16(descStatus2 & 0xffff));
 
         mbuf_pkthdr_setlen(newPkt, pktSize);
-        interface->enqueueInputPacket(newPkt, pollQueue);
+        
+        if (unlikely(ptpTime) && ptpStampEnable) {
+            ptpHdr = ptpEventHeader((const UInt8 *)mbuf_data(newPkt), (UInt32)mbuf_len(newPkt));
+            
+            if (ptpHdr) {
+                ptpFillStamp(&ptpRxStamp, ptpHdr, 0, kRtlPtpStampRx);
+                ptpQueueStamp(&ptpRxStamp, ptpTime);
+            }
+        }
+        
+        if (unlikely(test_bit(__CAPTURE, &stateFlags)))
+            captureFrame(kRtlCaptureRx, newPkt, pktSize, descStatus1, (descStatus2 & RxVlanTag) ? OSSwapInt16(descStatus2 & 0xffff) : 0);
+        
+        /* Frames looped back by the self test don't go up the stack. */
+        if (likely(!testStart) || !selfTestReceive(newPkt, pktSize)) {
+            if (likely(!userRxEtherType) || !userQueueReceive(newPkt, pktSize))
+                interface->enqueueInputPacket(newPkt, pollQueue);
+        }
+        
         goodPkts++;
         
         /* Finally update the descriptor and get the next one to examine. */
     nextDesc:
         if (addr)
-            desc->addr = OSSwapHostToLittleInt64(addr);
+            *rxDescAddr(rxNextDescIndex) = OSSwapHostToLittleInt64(addr);
         
-        desc->opts2 = OSSwapHostToLittleInt32(opts2);
-        desc->opts1 = OSSwapHostToLittleInt32(opts1);
+        *rxDescOpts2(rxNextDescIndex) = OSSwapHostToLittleInt32(opts2);
+        *rxDescOpts1(rxNextDescIndex) = OSSwapHostToLittleInt32(opts1);
         
         ++rxNextDescIndex &= kRxDescMask;
-        desc = &rxDescArray[rxNextDescIndex];
     }
+    rxCount[kPathRxPackets] += goodPkts;
+    traceEvent(kTraceRx, rxNextDescIndex, goodPkts);
+    
+    if (unlikely(testStart)) {
+        clock_get_uptime(&testEnd);
+        selfTestRxBusy += testEnd - testStart;
+    }
+
     return goodPkts;
 }
 
 void LucyRTL8125::checkLinkStatus()
 {
     struct rtl8125_private *tp = &linuxData;
+    UInt64 linkUpStart, linkUpEnd;
+    UInt64 linkUpTime;
     UInt16 currLinkState;
     
     DebugLog("Link change interrupt: Check link status.\n");
 
+    /* Deferred to selfTestStop() as the self test owns the rings. */
+    if (test_bit(__SELF_TEST, &stateFlags))
+        return;
+
     currLinkState = ReadReg16(PHYstatus);
     
     if (currLinkState & LinkStatus) {
+        markPhase(kPhaseAutoneg);
+        
         /* Get EEE mode. */
         eeeMode = getEEEMode();
         
@@ -1287,22 +1714,14 @@ void LucyRTL8125::checkLinkStatus()
                 duplex = DUPLEX_HALF;
             }
         }
-        setupRTL8125();
-        
-        if (tp->mcfg == CFG_METHOD_2) {
-            if (ReadReg16(PHYstatus) & FullDup)
-                WriteReg32(TxConfig, (ReadReg32(TxConfig) | (BIT_24 | BIT_25)) & ~BIT_19);
-            else
-                WriteReg32(TxConfig, (ReadReg32(TxConfig) | BIT_25) & ~(BIT_19 | BIT_24));
-        }
-
-        if ((tp->mcfg == CFG_METHOD_2 || tp->mcfg == CFG_METHOD_3 ||
-             tp->mcfg == CFG_METHOD_4 || tp->mcfg == CFG_METHOD_5) &&
-            (ReadReg16(PHYstatus) & _10bps))
-                rtl8125_enable_eee_plus(tp);
-
+        clock_get_uptime(&linkUpStart);
+        setupLinkRTL8125();
         setLinkUp();
         timerSource->setTimeoutMS(kTimeoutMS);
+        clock_get_uptime(&linkUpEnd);
+        
+        absolutetime_to_nanoseconds(linkUpEnd - linkUpStart, &linkUpTime);
+        DebugLog("Link up handled in %lluµs.\n", linkUpTime / 1000);
         
         rtl8125_mdio_write(tp, 0x1F, 0x0000);
         linuxData.phy_reg_anlpar = rtl8125_mdio_read(tp, MII_LPA);
@@ -1325,6 +1744,7 @@ void LucyRTL8125::interruptHandler(OSObject *client, IOInterruptEventSource *src
 {
     UInt32 packets;
     UInt32 status;
+    UInt32 oldMask = intrMask;
     
     status = ReadReg32(ISR0_8125);
     
@@ -1337,6 +1757,9 @@ void LucyRTL8125::interruptHandler(OSObject *client, IOInterruptEventSource *src
     WriteReg32(IMR0_8125, 0x0000);
     WriteReg32(ISR0_8125, (status & ~RxFIFOOver));
 
+    countInterruptCauses(status);
+    traceEvent(kTraceIntr, status, intrMask);
+
     if (status & SYSErr) {
         pciErrorInterrupt();
         goto done;
@@ -1347,8 +1770,12 @@ void LucyRTL8125::interruptHandler(OSObject *client, IOInterruptEventSource *src
         if (status & (RxOK | RxDescUnavail)) {
             packets = rxInterrupt(netif, kNumRxDesc, NULL, NULL);
             
-            if (packets)
+            if (packets) {
                 netif->flushInputQueue();
+                
+                if (latEnable[kLatPathRx])
+                    rxLatencyDone(packets);
+            }
             
             etherStats->dot3RxExtraEntry.interrupts++;
             
@@ -1384,8 +1811,17 @@ void LucyRTL8125::interruptHandler(OSObject *client, IOInterruptEventSource *src
     }
 done:
     WriteReg32(IMR0_8125, intrMask);
+    
+    if (intrMask != oldMask)
+        traceEvent(kTraceIntrMask, intrMask);
 }
 
+static const char* recoveryTierNames[kRecoveryTierCount] = {
+    "queue",
+    "MAC",
+    "chip"
+};
+
 bool LucyRTL8125::txHangCheck()
 {
     bool deadlock = false;
@@ -1412,16 +1848,84 @@ bool LucyRTL8125::txHangCheck()
 #endif
             IOLog("Tx stalled? Resetting chipset. ISR0=0x%x, IMR0=0x%x.\n", ReadReg32(ISR0_8125),
                   ReadReg32(IMR0_8125));
+            traceEvent(kTraceTxHang, ReadReg16(HW_CLO_PTR0_8125), txTailPtr0 & 0xffff);
+            snapshotTrace(kTraceTxHang);
             etherStats->dot3TxExtraEntry.resets++;
-            restartRTL8125();
-            deadlock = true;
+            deadlock = recoverRTL8125(recoveryTier);
         }
     } else {
+        /* The transmitter is making progress again. */
+        if (txDescDoneCount != txDescDoneLast)
+            recoveryTier = kRecoveryQueue;
+
         deadlockWarn = 0;
     }
     return deadlock;
 }
 
+/*
+ * Try to resume operation with the least invasive reset. Each
+ * attempt escalates the tier for the next one until txHangCheck()
+ * sees the transmitter making progress again. Returns true in case
+ * the link has been taken down.
+ */
+bool LucyRTL8125::recoverRTL8125(UInt32 tier)
+{
+    bool linkDown = false;
+    
+    /* Don't pull the rings from under the self test. */
+    if (test_bit(__SELF_TEST, &stateFlags))
+        return false;
+    
+    IOLog("Recovery on en%u: %s reset.\n", netif->getUnitNumber(), recoveryTierNames[tier]);
+    
+    clock_get_uptime(&recoveryStart);
+    recoveryStats[tier].count++;
+    traceEvent(kTraceRecovery, tier);
+
+    if (tier < kRecoveryTierCount - 1)
+        recoveryTier = tier + 1;
+    
+    switch (tier) {
+        case kRecoveryQueue:
+            resetQueuesRTL8125();
+            recoveryDone(tier);
+            break;
+            
+        case kRecoveryMAC:
+            resetMacRTL8125();
+            recoveryDone(tier);
+            break;
+            
+        default:
+            /* Outage ends with the next link up. */
+            restartRTL8125();
+            linkDown = true;
+            break;
+    }
+    return linkDown;
+}
+
+void LucyRTL8125::recoveryDone(UInt32 tier)
+{
+    RtlRecoveryStat *stat = &recoveryStats[tier];
+    UInt64 now, outage;
+    
+    clock_get_uptime(&now);
+    absolutetime_to_nanoseconds(now - recoveryStart, &outage);
+    recoveryStart = 0;
+    
+    stat->lastOutage = (UInt32)(outage / 1000);
+    
+    if (stat->lastOutage > stat->maxOutage)
+        stat->maxOutage = stat->lastOutage;
+    
+    traceEvent(kTraceRecoveryDone, tier, stat->lastOutage);
+    
+    IOLog("Recovery on en%u: %s reset done, outage %uµs (max %uµs, count %u).\n",
+          netif->getUnitNumber(), recoveryTierNames[tier], stat->lastOutage, stat->maxOutage, stat->count);
+}
+
 #pragma mark --- rx poll methods ---
 
 IOReturn LucyRTL8125::setInputPacketPollingEnable(IONetworkInterface *interface, bool enabled)
@@ -1439,6 +1943,7 @@ IOReturn LucyRTL8125::setInputPacketPollingEnable(IONetworkInterface *interface,
             intrMask = intrMaskRxTx;
         }
         WriteReg32(IMR0_8125, intrMask);
+        traceEvent(kTracePollMode, enabled, intrMask);
     }
     DebugLog("Input polling %s.\n", enabled ? "enabled" : "disabled");
 
@@ -1449,12 +1954,18 @@ IOReturn LucyRTL8125::setInputPacketPollingEnable(IONetworkInterface *interface,
 
 void LucyRTL8125::pollInputPackets(IONetworkInterface *interface, uint32_t maxCount, IOMbufQueue *pollQueue, void *context )
 {
+    UInt32 packets;
+    
     //DebugLog("pollInputPackets() ===>\n");
     
     if (test_bit(__POLL_MODE, &stateFlags) &&
         !test_and_set_bit(__POLLING, &stateFlags)) {
 
-        rxInterrupt(interface, maxCount, pollQueue, context);
+        packets = rxInterrupt(interface, maxCount, pollQueue, context);
+        
+        /* The stack takes over pollQueue as soon as we return. */
+        if (packets && latEnable[kLatPathRx])
+            rxLatencyDone(packets);
         
         /* Finally cleanup the transmitter ring. */
         txInterrupt();
@@ -1469,21 +1980,39 @@ void LucyRTL8125::pollInputPackets(IONetworkInterface *interface, uint32_t maxCo
 
 #pragma mark --- hardware specific methods ---
 
-inline void LucyRTL8125::getChecksumResult(mbuf_t m, UInt32 status1, UInt32 status2)
+/* index is the descriptor's rxCsumIndex() or rxCsumIndexV3(). */
+inline void LucyRTL8125::getChecksumResult(mbuf_t m, UInt32 index)
 {
-    mbuf_csum_performed_flags_t performed = 0;
-    UInt32 value = 0;
+    const RtlRxCsumResult *result = &rxCsumResultTable[index];
 
-    if ((status2 & RxV4F) && !(status1 & RxIPF))
-        performed |= (MBUF_CSUM_DID_IP | MBUF_CSUM_IP_GOOD);
+    if (result->performed)
+        mbuf_set_csum_performed(m, result->performed, result->value);
+}
+
+static const struct {
+    UInt32 mask;
+    UInt32 index;
+} intrCauseTable[] = {
+    { RxOK, kPathIntrRxOK },
+    { RxDescUnavail, kPathIntrRxDescUnavail },
+    { RxFIFOOver, kPathIntrRxFIFOOver },
+    { TxOK, kPathIntrTxOK },
+    { PCSTimeout, kPathIntrTimer },
+    { LinkChg, kPathIntrLinkChg },
+    { SYSErr, kPathIntrSYSErr }
+};
 
-    if (((status1 & RxTCPT) && !(status1 & RxTCPF)) ||
-        ((status1 & RxUDPT) && !(status1 & RxUDPF))) {
-        performed |= (MBUF_CSUM_DID_DATA | MBUF_CSUM_PSEUDO_HDR);
-        value = 0xffff; // fake a valid checksum value
+inline void LucyRTL8125::countInterruptCauses(UInt32 status)
+{
+    UInt64 *intrCount = pathCounters[kPathContextIntr].count;
+    UInt32 i;
+    
+    intrCount[kPathIntrTotal]++;
+    
+    for (i = 0; i < sizeof(intrCauseTable) / sizeof(intrCauseTable[0]); i++) {
+        if (status & intrCauseTable[i].mask)
+            intrCount[intrCauseTable[i].index]++;
     }
-    if (performed)
-        mbuf_set_csum_performed(m, performed, value);
 }
 
 static const char *speed25GName = "2.5 Gigabit";
@@ -1619,9 +2148,18 @@ void LucyRTL8125::setLinkUp()
     netif->setPacketPollingParameters(&pParams, 0);
     DebugLog("pollIntervalTime: %lluµs\n", (pParams.pollIntervalTime / 1000));
 
+    setTxStallTimeout();
+
     netif->startOutputThread();
 
     IOLog("Link up on en%u, %s, %s, %s%s\n", netif->getUnitNumber(), speedName, duplexName, flowName, eeeName);
+    
+    markPhase(kPhaseLinkUp);
+    publishPhaseMarkers();
+    
+    /* A full chip restart is over as soon as the link is back. */
+    if (recoveryStart)
+        recoveryDone(kRecoveryChip);
 }
 
 void LucyRTL8125::setLinkDown()
@@ -1629,6 +2167,9 @@ void LucyRTL8125::setLinkDown()
     deadlockWarn = 0;
     needsUpdate = false;
 
+    txStallSource->cancelTimeout();
+    clear_bit(__TX_WATCH, &stateFlags);
+
     /* Stop output thread and flush output queue. */
     netif->stopOutputThread();
     netif->flushOutputQueue();
@@ -1637,10 +2178,12 @@ void LucyRTL8125::setLinkDown()
     clear_mask((__LINK_UP_M | __POLL_MODE_M), &stateFlags);
     setLinkStatus(kIONetworkLinkValid);
 
-    rtl8125_nic_reset(&linuxData);
-
-    /* Cleanup descriptor ring. */
-    clearRxTxRings();
+    /*
+     * Stop DMA but don't reset the chip so that the MAC needn't be
+     * reconfigured when the link comes back. The rings stay as they
+     * are and DMA resumes where it stopped.
+     */
+    stopRxTxRTL8125();
     
     setPhyMedium();
     
@@ -1649,26 +2192,29 @@ void LucyRTL8125::setLinkDown()
 
 void LucyRTL8125::updateStatitics()
 {
-    UInt32 sgColl, mlColl;
+    UInt64 sgColl, mlColl;
     UInt32 cmd;
 
     /* Check if a statistics dump has been completed. */
     if (needsUpdate && !(ReadReg32(CounterAddrLow) & CounterDump)) {
         needsUpdate = false;
-        netStats->inputPackets = OSSwapLittleToHostInt64(statData->rxPackets) & 0x00000000ffffffff;
-        netStats->inputErrors = OSSwapLittleToHostInt32(statData->rxErrors);
-        netStats->outputPackets = OSSwapLittleToHostInt64(statData->txPackets) & 0x00000000ffffffff;
-        netStats->outputErrors = OSSwapLittleToHostInt32(statData->txErrors);
+        accumulateStatistics();
+        
+        /* The network stack's counters are 32 bits wide and wrap. */
+        netStats->inputPackets = (UInt32)statTotals[kStatRxPackets];
+        netStats->inputErrors = (UInt32)statTotals[kStatRxErrors];
+        netStats->outputPackets = (UInt32)statTotals[kStatTxPackets];
+        netStats->outputErrors = (UInt32)statTotals[kStatTxErrors];
         
-        sgColl = OSSwapLittleToHostInt32(statData->txOneCollision);
-        mlColl = OSSwapLittleToHostInt32(statData->txMultiCollision);
-        netStats->collisions = sgColl + mlColl;
+        sgColl = statTotals[kStatTxOneCollision];
+        mlColl = statTotals[kStatTxMultiCollision];
+        netStats->collisions = (UInt32)(sgColl + mlColl);
         
-        etherStats->dot3StatsEntry.singleCollisionFrames = sgColl;
-        etherStats->dot3StatsEntry.multipleCollisionFrames = mlColl;
-        etherStats->dot3StatsEntry.alignmentErrors = OSSwapLittleToHostInt16(statData->alignErrors);
-        etherStats->dot3StatsEntry.missedFrames = OSSwapLittleToHostInt16(statData->rxMissed);
-        etherStats->dot3TxExtraEntry.underruns = OSSwapLittleToHostInt16(statData->txUnderun);
+        etherStats->dot3StatsEntry.singleCollisionFrames = (UInt32)sgColl;
+        etherStats->dot3StatsEntry.multipleCollisionFrames = (UInt32)mlColl;
+        etherStats->dot3StatsEntry.alignmentErrors = (UInt32)statTotals[kStatAlignErrors];
+        etherStats->dot3StatsEntry.missedFrames = (UInt32)statTotals[kStatRxMissed];
+        etherStats->dot3TxExtraEntry.underruns = (UInt32)statTotals[kStatTxUnderrun];
     }
     /* Some chips are unable to dump the tally counter while the receiver is disabled. */
     if (test_bit(__LINK_UP, &stateFlags) && (ReadReg8(ChipCmd) & CmdRxEnb)) {
@@ -1695,12 +2241,14 @@ void LucyRTL8125::timerActionRTL8125(IOTimerEventSource *timer)
 #endif
     
     updateStatitics();
+    updatePathStatistics();
+    updateLatencyStatistics();
 
     if (!test_bit(__LINK_UP, &stateFlags))
         goto done;
 
-    /* Check for tx deadlock. */
-    if (txHangCheck())
+    /* Check for tx deadlock unless the self test owns the tx ring. */
+    if (!test_bit(__SELF_TEST, &stateFlags) && txHangCheck())
         goto done;
     
     timerSource->setTimeoutMS(kTimeoutMS);
@@ -1710,60 +2258,2099 @@ done:
     
 }
 
-#pragma mark --- miscellaneous functions ---
+/*
+ * Derive the tx stall timeout from the link speed. The transmitter
+ * must complete at least one descriptor within the time it takes to
+ * send the largest burst. With flow-control the link partner may
+ * legitimately hold us off for the longest pause it can request.
+ * Longer holds are recognized by txStallAction() from the rx pause
+ * counter.
+ */
+void LucyRTL8125::setTxStallTimeout()
+{
+    UInt64 ns = kTxStallMinMS * 1000000ULL;
+    
+    ns += (kTxStallMaxBurst * 8ULL * 1000) / speed;
+    
+    if (flowCtl == kFlowControlOn)
+        ns += (kTxStallMaxPause * 1000ULL) / speed;
+    
+    nanoseconds_to_absolutetime(ns, &txStallTimeout);
+    
+    DebugLog("Tx stall timeout: %lluµs\n", ns / 1000);
+}
 
-static inline void prepareTSO4(mbuf_t m, UInt32 *tcpOffset, UInt32 *mss)
+/*
+ * Runs every kTxStallCheckMS as long as descriptors are outstanding
+ * and watches the hardware's close pointer for progress.
+ */
+void LucyRTL8125::txStallAction(IOTimerEventSource *timer)
 {
-    UInt8 *p = (UInt8 *)mbuf_data(m) + kMacHdrLen;
-    struct ip4_hdr_be *ip = (struct ip4_hdr_be *)p;
-    struct tcp_hdr_be *tcp;
-    UInt32 csum32 = 6;
-    //UInt32 max;
-    UInt32 i, il, tl;
+    UInt64 now, stalled;
+    UInt32 closePtr;
     
-    for (i = 0; i < 4; i++) {
-        csum32 += ntohs(ip->addr[i]);
-        csum32 += (csum32 >> 16);
-        csum32 &= 0xffff;
+    if (!test_bit(__LINK_UP, &stateFlags) || test_bit(__SELF_TEST, &stateFlags))
+        goto stop;
+
+    closePtr = ReadReg16(HW_CLO_PTR0_8125);
+    clock_get_uptime(&now);
+
+    if (closePtr != txStallClosePtr) {
+        /* The transmitter made progress. */
+        txStallClosePtr = closePtr;
+        txStallStamp = now;
+    } else if (closePtr == (txTailPtr0 & 0xffff)) {
+        /* All descriptors have been completed. */
+        goto stop;
+    } else if ((now - txStallStamp) > txStallTimeout) {
+        /* The link partner keeps sending pause frames. */
+        if ((flowCtl == kFlowControlOn) && (statCount == kStatCount) && dumpStatistics() &&
+            (statTotals[kStatRxPauseOn] != txStallPauses)) {
+            txStallPauses = statTotals[kStatRxPauseOn];
+            txStallStamp = now;
+            timer->setTimeoutMS(kTxStallCheckMS);
+            return;
+        }
+        absolutetime_to_nanoseconds(now - txStallStamp, &stalled);
+        
+        IOLog("Tx stalled for %lluµs. tail=%u, close=%u, ISR0=0x%x, IMR0=0x%x.\n",
+              stalled / 1000, txTailPtr0 & 0xffff, closePtr, ReadReg32(ISR0_8125), ReadReg32(IMR0_8125));
+        traceEvent(kTraceTxHang, closePtr, txTailPtr0 & 0xffff);
+        snapshotTrace(kTraceTxHang);
+        
+        etherStats->dot3TxExtraEntry.timeouts++;
+        etherStats->dot3TxExtraEntry.resets++;
+        recoverRTL8125(recoveryTier);
+        goto stop;
     }
-    il = ((ip->hdr_len & 0x0f) << 2);
+    timer->setTimeoutMS(kTxStallCheckMS);
+    return;
+
+stop:
+    clear_bit(__TX_WATCH, &stateFlags);
     
-    tcp = (struct tcp_hdr_be *)(p + il);
-    tl = ((tcp->dat_off & 0xf0) >> 2);
-    //max = ETH_DATA_LEN - (il + tl);
+    /* outputStart() may have added descriptors since the last check. */
+    if (test_bit(__LINK_UP, &stateFlags) && !test_bit(__SELF_TEST, &stateFlags) &&
+        (ReadReg16(HW_CLO_PTR0_8125) != (txTailPtr0 & 0xffff)) &&
+        !test_and_set_bit(__TX_WATCH, &stateFlags)) {
+        txStallClosePtr = ReadReg16(HW_CLO_PTR0_8125);
+        clock_get_uptime(&txStallStamp);
+        timer->setTimeoutMS(kTxStallCheckMS);
+    }
+}
 
-    /* Fill in the pseudo header checksum for TSOv4. */
-    tcp->csum = htons((UInt16)csum32);
+#pragma mark --- diagnostics methods ---
+
+static_assert(offsetof(RtlStatData, txOctets) == kStatLegacySize, "Bad legacy tally layout");
+static_assert(sizeof(RtlStatData) == 192, "Bad extended tally layout");
+
+#define STAT_COUNTER(group, name, field, width) \
+    { group, name, offsetof(RtlStatData, field), width }
+
+/*
+ * The extended block repeats some legacy counters with a larger width.
+ * These duplicates aren't exported separately, see statLegacyWide.
+ */
+const struct RtlStatCounter statCounters[kStatCount] = {
+    STAT_COUNTER("Transmit", "Packets", txPackets, 8),
+    STAT_COUNTER("Receive", "Packets", rxPackets, 8),
+    STAT_COUNTER("Transmit", "Errors", txErrors, 8),
+    STAT_COUNTER("Receive", "Errors", rxErrors, 4),
+    STAT_COUNTER("Drops", "Rx Missed", rxMissed, 2),
+    STAT_COUNTER("Receive", "Alignment Errors", alignErrors, 2),
+    STAT_COUNTER("Transmit", "Single Collisions", txOneCollision, 4),
+    STAT_COUNTER("Transmit", "Multiple Collisions", txMultiCollision, 4),
+    STAT_COUNTER("Receive", "Unicast", rxUnicast, 8),
+    STAT_COUNTER("Receive", "Broadcast", rxBroadcast, 8),
+    STAT_COUNTER("Receive", "Multicast", rxMulticast, 4),
+    STAT_COUNTER("Transmit", "Aborted", txAborted, 2),
+    STAT_COUNTER("Transmit", "Underruns", txUnderun, 2),
+    /* extended tally counters */
+    STAT_COUNTER("Transmit", "Octets", txOctets, 8),
+    STAT_COUNTER("Receive", "Octets", rxOctets, 8),
+    STAT_COUNTER("Transmit", "Unicast", txUnicast64, 8),
+    STAT_COUNTER("Transmit", "Broadcast", txBroadcast64, 8),
+    STAT_COUNTER("Transmit", "Multicast", txMulticast64, 8),
+    STAT_COUNTER("Flow Control", "Tx Pause On", txPauseOn, 4),
+    STAT_COUNTER("Flow Control", "Tx Pause Off", txPauseOff, 4),
+    STAT_COUNTER("Flow Control", "Tx Pause All", txPauseAll, 4),
+    STAT_COUNTER("Transmit", "Deferred", txDeferred, 4),
+    STAT_COUNTER("Transmit", "Late Collisions", txLateCollision, 4),
+    STAT_COUNTER("Transmit", "All Collisions", txAllCollision, 4),
+    STAT_COUNTER("Receive", "Frames Too Long", rxFrameTooLong, 4),
+    STAT_COUNTER("Receive", "Runts", rxRunt, 4),
+    STAT_COUNTER("Flow Control", "Rx Pause On", rxPauseOn, 4),
+    STAT_COUNTER("Flow Control", "Rx Pause Off", rxPauseOff, 4),
+    STAT_COUNTER("Flow Control", "Rx Pause All", rxPauseAll, 4),
+    STAT_COUNTER("Receive", "Unknown Opcodes", rxUnknownOpcode, 4),
+    STAT_COUNTER("Receive", "MAC Errors", rxMacError, 4),
+    STAT_COUNTER("Drops", "Rx FIFO Missed", rxMacMissed, 4),
+    STAT_COUNTER("Drops", "Rx TCAM Dropped", rxTcamDropped, 4),
+    STAT_COUNTER("Drops", "Tx Descriptor Unavailable", txDescUnavail, 4),
+    STAT_COUNTER("Drops", "Rx Descriptor Unavailable", rxDescUnavail, 4)
+};
 
-    *tcpOffset = kMacHdrLen + il;
+/*
+ * Legacy counters read from their wide duplicates when the chip dumps
+ * the extended block, as the 16-bit ones wrap quickly.
+ */
+static const struct RtlStatCounter statLegacyWide[kStatLegacyCount] = {
+    STAT_COUNTER("Transmit", "Packets", txPackets, 8),
+    STAT_COUNTER("Receive", "Packets", rxPackets, 8),
+    STAT_COUNTER("Transmit", "Errors", txErrors, 8),
+    STAT_COUNTER("Receive", "Errors", rxErrors, 4),
+    STAT_COUNTER("Drops", "Rx Missed", rxMissed, 2),
+    STAT_COUNTER("Receive", "Alignment Errors", alignErrors32, 4),
+    STAT_COUNTER("Transmit", "Single Collisions", txOneCollision, 4),
+    STAT_COUNTER("Transmit", "Multiple Collisions", txMultiCollision, 4),
+    STAT_COUNTER("Receive", "Unicast", rxUnicast, 8),
+    STAT_COUNTER("Receive", "Broadcast", rxBroadcast, 8),
+    STAT_COUNTER("Receive", "Multicast", rxMulticast64, 8),
+    STAT_COUNTER("Transmit", "Aborted", txAborted32, 4),
+    STAT_COUNTER("Transmit", "Underruns", txUnderrun32, 4)
+};
+
+const char *pathCounterNames[kPathCount] = {
+    "Rx Calls",
+    "Rx Packets",
+    "Rx Copied",
+    "Rx Replaced",
+    "Rx Spare Used",
+    "Rx No Buffer",
+    "Tx Calls",
+    "Tx Packets",
+    "Tx Descriptors",
+    "Tx Tail Writes",
+    "Tx Ring Full",
+    "Tx Coalesce Failed",
+    "Interrupts",
+    "Interrupts RxOK",
+    "Interrupts RxDescUnavail",
+    "Interrupts RxFIFOOver",
+    "Interrupts TxOK",
+    "Interrupts Timer",
+    "Interrupts LinkChg",
+    "Interrupts SYSErr"
+};
+
+/*
+ * Sum up the per context blocks of the data path counters and update
+ * the numbers in "DataPathStatistics". The blocks are read without
+ * synchronization as the values are only informative.
+ */
+void LucyRTL8125::updatePathStatistics()
+{
+    UInt64 sum;
+    UInt32 i, j;
     
-    if (*mss > MSS_MAX)
-        *mss = MSS_MAX;
+    for (i = 0; i < kPathCount; i++) {
+        for (sum = 0, j = 0; j < kPathContextCount; j++)
+            sum += pathCounters[j].count[i];
+        
+        if (pathNums[i])
+            pathNums[i]->setValue(sum);
+    }
 }
 
-static inline void prepareTSO6(mbuf_t m, UInt32 *tcpOffset, UInt32 *mss)
+/*
+ * Add the increments since the previous tally dump to the 64 bit
+ * totals. Counters narrower than 64 bits wrap, so their increments are
+ * computed modulo their width. A reset of the chip clears the tally,
+ * which shows up as a decrease of a 64 bit counter. In this case the
+ * dumped values are the increments since the reset.
+ */
+void LucyRTL8125::accumulateStatistics()
 {
-    UInt8 *p = (UInt8 *)mbuf_data(m) + kMacHdrLen;
-    struct ip6_hdr_be *ip6 = (struct ip6_hdr_be *)p;
-    struct tcp_hdr_be *tcp;
-    UInt32 csum32 = 6;
-    UInt32 i, tl;
-    //UInt32 max;
+    const struct RtlStatCounter *table = (statCount == kStatCount) ? statLegacyWide : statCounters;
+    const struct RtlStatCounter *counter;
+    UInt8 *data = (UInt8 *)statData;
+    UInt64 curr[kStatCount];
+    UInt64 delta, mask;
+    bool reset = false;
+    UInt32 i;
+    
+    for (i = 0; i < statCount; i++) {
+        counter = (i < kStatLegacyCount) ? &table[i] : &statCounters[i];
+        
+        switch (counter->width) {
+            case 8:
+                curr[i] = OSReadLittleInt64(data, counter->offset);
+                
+                if (curr[i] < statLast[i])
+                    reset = true;
+                
+                break;
+                
+            case 4:
+                curr[i] = OSReadLittleInt32(data, counter->offset);
+                break;
+                
+            default:
+                curr[i] = OSReadLittleInt16(data, counter->offset);
+                break;
+        }
+    }
+    if (reset)
+        DebugLog("Tally counters have been reset.\n");
+    
+    for (i = 0; i < statCount; i++) {
+        if (reset) {
+            delta = curr[i];
+        } else {
+            counter = (i < kStatLegacyCount) ? &table[i] : &statCounters[i];
+            mask = (counter->width < 8) ? ((1ULL << (counter->width * 8)) - 1) : ~0ULL;
+            delta = (curr[i] - statLast[i]) & mask;
+        }
+        statTotals[i] += delta;
+        statLast[i] = curr[i];
+        
+        if (statNums[i])
+            statNums[i]->setValue(statTotals[i]);
+    }
+}
 
-    ip6->pay_len = 0;
+/*
+ * The chip's reset clears the tally counters and a reset can't be told
+ * apart from a wrap of the narrower ones. Fold the counters into the
+ * totals before every reset and count from zero again afterwards.
+ */
+void LucyRTL8125::saveStatistics()
+{
+    /* Some chips are unable to dump the tally counter while the receiver is disabled. */
+    if (ReadReg8(ChipCmd) & CmdRxEnb)
+        dumpStatistics();
+    
+    bzero(statLast, sizeof(statLast));
+    needsUpdate = false;
+}
+
+/*
+ * Dump the tally counters and wait for the dump to complete, then
+ * accumulate them. Returns false in case the chip didn't finish in time.
+ */
+bool LucyRTL8125::dumpStatistics()
+{
+    UInt32 cmd;
+    UInt32 i;
+    
+    /* Let a dump started by updateStatitics() finish first. */
+    for (i = 0; (ReadReg32(CounterAddrLow) & CounterDump) && (i < kStatDumpPolls); i++)
+        IODelay(10);
+    
+    WriteReg32(CounterAddrHigh, (statPhyAddr >> 32));
+    cmd = (statPhyAddr & 0x00000000ffffffff);
+    WriteReg32(CounterAddrLow, cmd);
+    WriteReg32(CounterAddrLow, cmd | CounterDump);
+    
+    for (i = 0; (ReadReg32(CounterAddrLow) & CounterDump) && (i < kStatDumpPolls); i++)
+        IODelay(10);
+    
+    if (i == kStatDumpPolls)
+        return false;
+    
+    accumulateStatistics();
+    
+    return true;
+}
+
+static const char* phaseNames[kPhaseCount] = {
+    "start",
+    "identifyChip",
+    "initRTL8125",
+    "exitOOB",
+    "hw_init",
+    "ephy config",
+    "PHY MCU patch",
+    "PHY config",
+    "setupRTL8125",
+    "setPhyMedium",
+    "autonegotiation complete",
+    "setLinkUp"
+};
+
+/*
+ * Record the completion of a start-up or link-up phase. Markers may be
+ * set from the background bring-up and from the workloop concurrently,
+ * therefore the slot is claimed atomically. A time of zero means now.
+ */
+void LucyRTL8125::markPhase(UInt32 phase, UInt64 time)
+{
+    RtlPhaseMarker *marker;
+    
+    if (!time)
+        clock_get_uptime(&time);
+    
+    marker = &phaseRing[(UInt32)OSIncrementAtomic(&phaseCount) & (kPhaseRingSize - 1)];
+    marker->time = time;
+    marker->phase = phase;
+}
+
+/*
+ * Export the phase markers, oldest first, as property "PhaseMarkers".
+ * Each entry holds the phase name, its time since boot and the time
+ * elapsed since the previous marker, both in µs.
+ */
+void LucyRTL8125::publishPhaseMarkers()
+{
+    OSArray *markers;
+    OSDictionary *entry;
+    OSString *name;
+    OSNumber *num;
+    RtlPhaseMarker *marker;
+    UInt64 time, last = 0;
+    UInt32 count = (UInt32)phaseCount;
+    UInt32 first = (count > kPhaseRingSize) ? (count - kPhaseRingSize) : 0;
+    UInt32 i;
+    
+    markers = OSArray::withCapacity(count - first);
+    
+    if (!markers)
+        return;
+    
+    for (i = first; i < count; i++) {
+        marker = &phaseRing[i & (kPhaseRingSize - 1)];
+        
+        if (marker->phase >= kPhaseCount)
+            continue;
+        
+        entry = OSDictionary::withCapacity(3);
+        
+        if (!entry)
+            break;
+        
+        absolutetime_to_nanoseconds(marker->time, &time);
+        time /= 1000;
+        
+        name = OSString::withCStringNoCopy(phaseNames[marker->phase]);
+        
+        if (name) {
+            entry->setObject("Phase", name);
+            name->release();
+        }
+        num = OSNumber::withNumber(time, 64);
+        
+        if (num) {
+            entry->setObject("Time", num);
+            num->release();
+        }
+        num = OSNumber::withNumber((last && (time > last)) ? (time - last) : 0, 64);
+        
+        if (num) {
+            entry->setObject("Delta", num);
+            num->release();
+        }
+        last = time;
+        
+        markers->setObject(entry);
+        entry->release();
+    }
+    setProperty("PhaseMarkers", markers);
+    markers->release();
+}
+
+static const char* traceEventNames[kTraceEventCount] = {
+    "interrupt",
+    "intrMask",
+    "pollMode",
+    "rx",
+    "txTail",
+    "txClose",
+    "txHang",
+    "pciError",
+    "recovery",
+    "recoveryDone"
+};
+
+/*
+ * Record an event in the trace ring. Slots are claimed atomically so
+ * that the interrupt, poll and output contexts can trace concurrently
+ * without a lock.
+ */
+void LucyRTL8125::traceEvent(UInt32 event, UInt32 arg0, UInt32 arg1)
+{
+    RtlTraceEntry *entry;
+    UInt32 seq = (UInt32)OSIncrementAtomic(&traceCount);
+    
+    entry = &traceRing[seq & (kTraceRingSize - 1)];
+    entry->seq = 0;
+    smp_wmb();
+    
+    clock_get_uptime(&entry->time);
+    entry->event = event;
+    entry->arg0 = arg0;
+    entry->arg1 = arg1;
+    
+    smp_wmb();
+    entry->seq = seq + 1;
+}
+
+/*
+ * Decode the trace ring, oldest entry first, into the property
+ * "TraceSnapshot". Entries which are being overwritten while the
+ * snapshot is taken are skipped. Each entry holds the event name,
+ * its time since boot in µs and the two arguments.
+ */
+void LucyRTL8125::snapshotTrace(UInt32 event)
+{
+    OSDictionary *snapshot;
+    OSArray *entries;
+    OSDictionary *dict;
+    OSString *name;
+    OSNumber *num;
+    volatile RtlTraceEntry *src;
+    RtlTraceEntry entry;
+    UInt64 time;
+    UInt32 seq;
+    UInt32 count = (UInt32)traceCount;
+    UInt32 first = (count > kTraceRingSize) ? (count - kTraceRingSize) : 0;
+    UInt32 i;
+    
+    snapshot = OSDictionary::withCapacity(2);
+    entries = OSArray::withCapacity(count - first);
+    
+    if (!snapshot || !entries)
+        goto done;
+    
+    for (i = first; i < count; i++) {
+        src = &traceRing[i & (kTraceRingSize - 1)];
+        seq = src->seq;
+        smp_rmb();
+        
+        entry.time = src->time;
+        entry.event = src->event;
+        entry.arg0 = src->arg0;
+        entry.arg1 = src->arg1;
+        
+        /* Skip entries which are incomplete or have been reused during the copy. */
+        smp_rmb();
+        
+        if ((seq != (i + 1)) || (src->seq != seq) || (entry.event >= kTraceEventCount))
+            continue;
+        
+        dict = OSDictionary::withCapacity(4);
+        
+        if (!dict)
+            break;
+        
+        absolutetime_to_nanoseconds(entry.time, &time);
+        
+        name = OSString::withCStringNoCopy(traceEventNames[entry.event]);
+        
+        if (name) {
+            dict->setObject("Event", name);
+            name->release();
+        }
+        num = OSNumber::withNumber(time / 1000, 64);
+        
+        if (num) {
+            dict->setObject("Time", num);
+            num->release();
+        }
+        num = OSNumber::withNumber(entry.arg0, 32);
+        
+        if (num) {
+            dict->setObject("Arg0", num);
+            num->release();
+        }
+        num = OSNumber::withNumber(entry.arg1, 32);
+        
+        if (num) {
+            dict->setObject("Arg1", num);
+            num->release();
+        }
+        entries->setObject(dict);
+        dict->release();
+    }
+    name = OSString::withCStringNoCopy(traceEventNames[event]);
+    
+    if (name) {
+        snapshot->setObject("Reason", name);
+        name->release();
+    }
+    snapshot->setObject("Entries", entries);
+    setProperty("TraceSnapshot", snapshot);
+    
+    DebugLog("Trace snapshot taken (%s, %u entries).\n", traceEventNames[event], entries->getCount());
+    
+done:
+    RELEASE(entries);
+    RELEASE(snapshot);
+}
+
+static_assert(kStatCount <= kRtlStatsPageMaxTally, "Too many tally counters for the stats page");
+static_assert(kPathCount <= kRtlStatsPageMaxPath, "Too many path counters for the stats page");
+
+/* Keeps the statistics page current while the interface is enabled. */
+void LucyRTL8125::statsPageTimerAction(IOTimerEventSource *timer)
+{
+    updateStatsPage();
+    
+    if (test_bit(__ENABLED, &stateFlags))
+        timer->setTimeoutMS(kStatsPageMS);
+}
+
+/*
+ * Copy the statistics into the page shared with user space. The
+ * sequence number is odd while the copy is in progress, see
+ * RtlStatsPage.
+ */
+void LucyRTL8125::updateStatsPage()
+{
+    RtlStatsPage *page = statsPage;
+    UInt64 now;
+    UInt32 i, j;
+    
+    if (!page)
+        return;
+    
+    clock_get_uptime(&now);
+    
+    page->seq++;
+    smp_wmb();
+    
+    absolutetime_to_nanoseconds(now, &page->updateTime);
+    page->linkUp = test_bit(__LINK_UP, &stateFlags) ? 1 : 0;
+    page->speed = page->linkUp ? speed : 0;
+    page->duplex = duplex;
+    page->flowControl = flowCtl;
+    page->mtu = mtu;
+    page->txFreeDesc = (UInt32)txNumFreeDesc;
+    page->rxSpareBuffers = (UInt32)spareNum;
+    page->tallyCount = statCount;
+    
+    memcpy(&page->netStats, netStats, sizeof(IONetworkStats));
+    memcpy(&page->etherStats, etherStats, sizeof(IOEthernetStats));
+    memcpy(page->tally, statTotals, statCount * sizeof(UInt64));
+    
+    for (i = 0; i < kPathCount; i++) {
+        for (page->path[i] = 0, j = 0; j < kPathContextCount; j++)
+            page->path[i] += pathCounters[j].count[i];
+    }
+    smp_wmb();
+    page->seq++;
+}
+
+static_assert(kRtlDumpMaxSize >= (sizeof(RtlDumpHeader) + sizeof(RtlRingState) + kNumTxDesc * sizeof(RtlTxDesc)), "Dump buffer too small");
+
+/*
+ * Take a snapshot of registers, tally totals or a descriptor ring for
+ * a user client. On entry size is the capacity of buffer, on return
+ * the size of the dump.
+ */
+IOReturn LucyRTL8125::dumpState(UInt32 type, void *buffer, UInt32 *size)
+{
+    if (type >= kRtlDumpTypeCount)
+        return kIOReturnBadArgument;
+    
+    /* Don't interfere with the background bring-up's PHY access. */
+    waitForBringUp();
+    
+    return commandGate->runAction(dumpAction, (void *)(uintptr_t)type, buffer, size);
+}
+
+IOReturn LucyRTL8125::dumpAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4)
+{
+    LucyRTL8125 *ethCtlr = OSDynamicCast(LucyRTL8125, owner);
+    IOReturn result = kIOReturnError;
+    
+    if (ethCtlr)
+        result = ethCtlr->dumpStateGated((UInt32)(uintptr_t)arg1, arg2, (UInt32 *)arg3);
+    
+    return result;
+}
+
+IOReturn LucyRTL8125::dumpStateGated(UInt32 type, void *buffer, UInt32 *size)
+{
+    struct rtl8125_private *tp = &linuxData;
+    RtlDumpHeader *header = (RtlDumpHeader *)buffer;
+    RtlRingState *ring;
+    UInt8 *data = (UInt8 *)(header + 1);
+    UInt32 count, elementSize, total;
+    UInt64 now;
+    UInt32 i;
+    IOReturn result = kIOReturnSuccess;
+    
+    switch (type) {
+        case kRtlDumpMacRegs:
+            count = R8125_MAC_REGS_SIZE;
+            elementSize = 1;
+            break;
+            
+        case kRtlDumpExtRegs:
+            count = R8125_ERI_REGS_SIZE / 4;
+            elementSize = 4;
+            break;
+            
+        case kRtlDumpEthPhy:
+            count = R8125_PHY_REGS_SIZE / 2;
+            elementSize = 2;
+            break;
+            
+        case kRtlDumpPciePhy:
+            count = R8125_EPHY_REGS_SIZE / 2;
+            elementSize = 2;
+            break;
+            
+        case kRtlDumpTally:
+            count = statCount;
+            elementSize = sizeof(UInt64);
+            break;
+            
+        case kRtlDumpRxRing:
+            count = kNumRxDesc;
+            elementSize = rxDescV3 ? sizeof(RtlRxDescV3) : sizeof(RtlRxDesc);
+            break;
+            
+        default:
+            count = kNumTxDesc;
+            elementSize = sizeof(RtlTxDesc);
+            break;
+    }
+    total = sizeof(RtlDumpHeader) + count * elementSize;
+    
+    if ((type == kRtlDumpRxRing) || (type == kRtlDumpTxRing))
+        total += sizeof(RtlRingState);
+    
+    if (*size < total) {
+        result = kIOReturnNoSpace;
+        goto done;
+    }
+    /* Registers can't be accessed while the chip is in D3. */
+    if ((type < kRtlDumpTally) && (powerState != kPowerStateOn)) {
+        result = kIOReturnNotReady;
+        goto done;
+    }
+    clock_get_uptime(&now);
+    
+    header->type = type;
+    header->version = kRtlDumpVersion;
+    header->count = count;
+    header->elementSize = elementSize;
+    absolutetime_to_nanoseconds(now, &header->time);
+    
+    switch (type) {
+        case kRtlDumpMacRegs:
+            for (i = 0; i < count; i++)
+                data[i] = ReadReg8(i);
+            
+            break;
+            
+        case kRtlDumpExtRegs:
+            for (i = 0; i < count; i++)
+                ((UInt32 *)data)[i] = rtl8125_eri_read(tp, i * 4, 4, ERIAR_ExGMAC);
+            
+            break;
+            
+        case kRtlDumpEthPhy:
+            rtl8125_mdio_write(tp, 0x1f, 0x0000);
+            
+            for (i = 0; i < count; i++)
+                ((UInt16 *)data)[i] = rtl8125_mdio_read(tp, i);
+            
+            break;
+            
+        case kRtlDumpPciePhy:
+            for (i = 0; i < count; i++)
+                ((UInt16 *)data)[i] = rtl8125_ephy_read(tp, i);
+            
+            break;
+            
+        case kRtlDumpTally:
+            memcpy(data, statTotals, count * elementSize);
+            break;
+            
+        case kRtlDumpRxRing:
+            ring = (RtlRingState *)data;
+            bzero(ring, sizeof(RtlRingState));
+            ring->numDesc = kNumRxDesc;
+            ring->nextIndex = rxNextDescIndex;
+            memcpy(ring + 1, rxDescArray, count * elementSize);
+            break;
+            
+        default:
+            ring = (RtlRingState *)data;
+            ring->numDesc = kNumTxDesc;
+            ring->nextIndex = txNextDescIndex;
+            ring->dirtyIndex = txDirtyDescIndex;
+            ring->numFree = (UInt32)txNumFreeDesc;
+            ring->swTailPtr = txTailPtr0 & 0xffff;
+            ring->hwClosePtr = (powerState == kPowerStateOn) ? ReadReg16(HW_CLO_PTR0_8125) : 0;
+            memcpy(ring + 1, txDescArray, count * elementSize);
+            break;
+    }
+    *size = total;
+    
+done:
+    return result;
+}
+
+/*
+ * Serve a PTP clock request of a user client. The arguments and results
+ * are passed in values, see kRtlMethodPtpGetTime and following.
+ */
+IOReturn LucyRTL8125::ptpRequest(UInt32 request, UInt64 *values)
+{
+    return commandGate->runAction(ptpAction, (void *)(uintptr_t)request, values);
+}
+
+IOReturn LucyRTL8125::ptpAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4)
+{
+    LucyRTL8125 *ethCtlr = OSDynamicCast(LucyRTL8125, owner);
+    IOReturn result = kIOReturnError;
+    
+    if (ethCtlr)
+        result = ethCtlr->ptpRequestGated((UInt32)(uintptr_t)arg1, (UInt64 *)arg2);
+    
+    return result;
+}
+
+IOReturn LucyRTL8125::ptpRequestGated(UInt32 request, UInt64 *values)
+{
+    UInt64 before, after;
+    UInt64 hw, time;
+    SInt64 ppb;
+    IOReturn result = kIOReturnSuccess;
+    
+    if (!linuxData.HwSuppPtpVer || !ptpLock) {
+        result = kIOReturnUnsupported;
+        goto done;
+    }
+    /* The clock runs only while the interface is enabled. */
+    if (!test_bit(__ENABLED, &stateFlags) || (powerState != kPowerStateOn)) {
+        result = kIOReturnNotReady;
+        goto done;
+    }
+    switch (request) {
+        case kRtlMethodPtpGetTime:
+            /* Bracket the read to correlate the clock with the host. */
+            clock_get_uptime(&before);
+            hw = ptpHwTime();
+            clock_get_uptime(&after);
+            
+            IOSimpleLockLock(ptpLock);
+            time = ptpClockTime(&ptpClock, hw);
+            IOSimpleLockUnlock(ptpLock);
+        
+            values[0] = time / kPtpNsPerSec;
+            values[1] = time % kPtpNsPerSec;
+            absolutetime_to_nanoseconds(before + ((after - before) / 2), &values[2]);
+            break;
+            
+        case kRtlMethodPtpSetTime:
+            if (values[1] >= kPtpNsPerSec) {
+                result = kIOReturnBadArgument;
+                break;
+            }
+            hw = ptpHwTime();
+        
+            IOSimpleLockLock(ptpLock);
+            ptpClockSet(&ptpClock, hw, (values[0] * kPtpNsPerSec) + values[1]);
+            IOSimpleLockUnlock(ptpLock);
+            break;
+            
+        case kRtlMethodPtpAdjTime:
+            hw = ptpHwTime();
+        
+            IOSimpleLockLock(ptpLock);
+            ptpClockAdjust(&ptpClock, hw, (SInt64)values[0]);
+            IOSimpleLockUnlock(ptpLock);
+            break;
+        
+        case kRtlMethodPtpAdjFreq:
+            ppb = (SInt64)values[0];
+        
+            if ((ppb > kRtlPtpMaxFreqPpb) || (ppb < -kRtlPtpMaxFreqPpb)) {
+                result = kIOReturnBadArgument;
+                break;
+            }
+            hw = ptpHwTime();
+        
+            IOSimpleLockLock(ptpLock);
+            ptpClockSetRate(&ptpClock, hw, ppb);
+            IOSimpleLockUnlock(ptpLock);
+            break;
+        
+        case kRtlMethodPtpStamps:
+            if (values[0] && !ptpStampEnable) {
+                IOSimpleLockLock(ptpLock);
+                ptpStampHead = ptpStampCount = ptpStampDrops = 0;
+                ptpTxSkipped = ptpTxTimeouts = 0;
+                IOSimpleLockUnlock(ptpLock);
+            }
+            ptpStampEnable = (values[0] != 0);
+            break;
+            
+        default:
+            result = kIOReturnBadArgument;
+            break;
+    }
+    
+done:
+    return result;
+}
+
+/*
+ * Queue a time stamp record taken at the chip's time hwTime, which is
+ * converted to PTP time here. Called from rxInterrupt() and
+ * ptpTxTimerAction(). The oldest stamps are kept when the queue is
+ * full, so that a client which isn't reading them sees the drops.
+ */
+void LucyRTL8125::ptpQueueStamp(RtlPtpStamp *stamp, UInt64 hwTime)
+{
+    IOSimpleLockLock(ptpLock);
+    
+    if (ptpStampCount < kRtlPtpMaxStamps) {
+        stamp->time = ptpClockTime(&ptpClock, hwTime);
+        ptpStamps[(ptpStampHead + ptpStampCount) % kRtlPtpMaxStamps] = *stamp;
+        ptpStampCount++;
+    } else {
+        ptpStampDrops++;
+    }
+    IOSimpleLockUnlock(ptpLock);
+}
+
+/*
+ * Hand the queued time stamps to a user client and empty the queue.
+ * Called from the client's thread.
+ */
+IOReturn LucyRTL8125::ptpGetStamps(RtlPtpStampBuffer *buffer)
+{
+    UInt32 i;
+    
+    if (!linuxData.HwSuppPtpVer || !ptpLock)
+        return kIOReturnUnsupported;
+    
+    bzero(buffer, sizeof(RtlPtpStampBuffer));
+    
+    IOSimpleLockLock(ptpLock);
+    
+    for (i = 0; i < ptpStampCount; i++)
+        buffer->stamp[i] = ptpStamps[(ptpStampHead + i) % kRtlPtpMaxStamps];
+    
+    buffer->count = ptpStampCount;
+    buffer->dropped = ptpStampDrops;
+    buffer->txSkipped = ptpTxSkipped;
+    buffer->txTimeouts = ptpTxTimeouts;
+    
+    ptpStampHead = ptpStampCount = ptpStampDrops = 0;
+    ptpTxSkipped = ptpTxTimeouts = 0;
+    
+    IOSimpleLockUnlock(ptpLock);
+    
+    return kIOReturnSuccess;
+}
+
+/*
+ * Called from outputStart() for each frame while time stamps are
+ * enabled. The chip latches the egress time of only one event message,
+ * so that a second one sent before the first one's stamp has been read
+ * goes without a stamp and is counted in ptpTxSkipped.
+ */
+void LucyRTL8125::ptpTxFrame(mbuf_t m)
+{
+    const UInt8 *hdr = ptpEventHeader((const UInt8 *)mbuf_data(m), (UInt32)mbuf_len(m));
+    
+    if (!hdr)
+        return;
+    
+    if (ptpTxPending) {
+        IOSimpleLockLock(ptpLock);
+        ptpTxSkipped++;
+        IOSimpleLockUnlock(ptpLock);
+        return;
+    }
+    ptpFillStamp(&ptpTxStamp, hdr, 0, kRtlPtpStampTx);
+    
+    /* Clear a stale latch before the frame is posted. */
+    WriteReg8(PTP_ISR_8125, PTP_ISR_TOK | PTP_ISR_TER);
+    clock_get_uptime(&ptpTxStart);
+    
+    smp_wmb();
+    ptpTxPending = true;
+    
+    ptpTxSource->setTimeoutMS(kPtpTxPollMS);
+}
+
+/*
+ * Poll for the egress time stamp of the event message recorded by
+ * ptpTxFrame(). Runs on the workloop.
+ */
+void LucyRTL8125::ptpTxTimerAction(IOTimerEventSource *timer)
+{
+    UInt64 now, elapsed;
+    UInt64 hw;
+    
+    if (!ptpTxPending)
+        return;
+    
+    if (ReadReg8(PTP_ISR_8125) & PTP_ISR_TOK) {
+        hw = ptpEgressTime();
+        WriteReg8(PTP_ISR_8125, PTP_ISR_TOK | PTP_ISR_TER);
+        ptpQueueStamp(&ptpTxStamp, hw);
+        
+        ptpTxPending = false;
+        goto done;
+    }
+    clock_get_uptime(&now);
+    absolutetime_to_nanoseconds(now - ptpTxStart, &elapsed);
+    
+    if (elapsed > (kPtpTxTimeoutMS * 1000000ULL)) {
+        WriteReg8(PTP_ISR_8125, PTP_ISR_TOK | PTP_ISR_TER);
+        
+        IOSimpleLockLock(ptpLock);
+        ptpTxTimeouts++;
+        IOSimpleLockUnlock(ptpLock);
+        
+        ptpTxPending = false;
+        goto done;
+    }
+    timer->setTimeoutMS(kPtpTxPollMS);
+    
+done:
+    return;
+}
+
+/*
+ * Send frames in MAC loopback mode and receive them back through
+ * rxInterrupt(). The frames are posted directly to the tx ring from
+ * the client's thread while the output thread is stopped. Works
+ * without a link partner, but normal traffic is interrupted for the
+ * duration of the test.
+ */
+IOReturn LucyRTL8125::runSelfTest(const RtlSelfTestParams *params, RtlSelfTestResult *res)
+{
+    UInt64 start, now, deadline;
+    UInt64 t0, busy = 0;
+    UInt64 ns;
+    UInt32 timeout;
+    UInt32 sent = 0;
+    UInt32 slot = 0;
+    UInt32 n;
+    IOReturn result;
+    
+    if ((params->mode >= kRtlLoopbackCount) || (params->frameSize < ETH_ZLEN) ||
+        (params->frameSize > (mtu + ETH_HLEN)) || !params->count)
+        return kIOReturnBadArgument;
+    
+    if (!genBuf)
+        return kIOReturnNoMemory;
+    
+    timeout = (params->timeoutMS && (params->timeoutMS < kSelfTestMaxTimeout)) ? params->timeoutMS : kSelfTestMaxTimeout;
+    
+    waitForBringUp();
+    
+    result = commandGate->runAction(selfTestAction, (void *)(uintptr_t)params->frameSize);
+    
+    if (result != kIOReturnSuccess)
+        return result;
+    
+    IOLog("Self test on en%u: %u frames of %u bytes.\n", netif->getUnitNumber(), params->count, params->frameSize);
+
+    clock_get_uptime(&start);
+    clock_interval_to_deadline(timeout, kMillisecondScale, &deadline);
+    
+    while (sent < params->count) {
+        clock_get_uptime(&t0);
+        n = genPostFrames(genPhyAddr, params->frameSize, params->count - sent, 1, &slot);
+        
+        if (n)
+            WriteReg16(SW_TAIL_PTR0_8125, txTailPtr0 & 0xffff);
+        
+        clock_get_uptime(&now);
+        
+        if (n) {
+            busy += now - t0;
+            sent += n;
+        } else {
+            /* Ring full, give txInterrupt() a chance. */
+            IODelay(10);
+        }
+        if (now > deadline)
+            break;
+    }
+    /* Wait for the frames in flight. */
+    while (((selfTestRxFrames + selfTestRxErrors) < sent) && (now < deadline)) {
+        IODelay(10);
+        clock_get_uptime(&now);
+    }
+    commandGate->runAction(selfTestAction, NULL);
+    
+    bzero(res, sizeof(RtlSelfTestResult));
+    res->txFrames = sent;
+    res->rxFrames = selfTestRxFrames;
+    res->errorFrames = selfTestRxErrors;
+    res->lostFrames = (sent > (selfTestRxFrames + selfTestRxErrors)) ? (sent - selfTestRxFrames - selfTestRxErrors) : 0;
+    
+    absolutetime_to_nanoseconds(now - start, &res->duration);
+    
+    if (res->duration) {
+        res->framesPerSec = (res->rxFrames * 1000000000ULL) / res->duration;
+        res->mbitPerSec = (res->rxFrames * params->frameSize * 8000ULL) / res->duration;
+    }
+    if (sent) {
+        absolutetime_to_nanoseconds(busy + selfTestRxBusy, &ns);
+        res->cpuPerFrame = ns / sent;
+    }
+    IOLog("Self test on en%u: %llu pps, %llu Mbit/s, %llu lost, %llu errors.\n", netif->getUnitNumber(),
+          res->framesPerSec, res->mbitPerSec, res->lostFrames, res->errorFrames);
+    
+    return kIOReturnSuccess;
+}
+
+/* Starts the self test when arg1 is the frame size, else stops it. */
+IOReturn LucyRTL8125::selfTestAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4)
+{
+    LucyRTL8125 *ethCtlr = OSDynamicCast(LucyRTL8125, owner);
+    IOReturn result = kIOReturnError;
+    
+    if (ethCtlr) {
+        if (arg1) {
+            result = ethCtlr->selfTestStart((UInt32)(uintptr_t)arg1);
+        } else {
+            ethCtlr->selfTestStop();
+            result = kIOReturnSuccess;
+        }
+    }
+    return result;
+}
+
+IOReturn LucyRTL8125::selfTestStart(UInt32 frameSize)
+{
+    struct rtl8125_private *tp = &linuxData;
+    UInt8 *p = genBuf;
+    UInt32 i;
+    
+    if (!test_bit(__ENABLED, &stateFlags) || (powerState != kPowerStateOn))
+        return kIOReturnNotReady;
+    
+    if (test_bit(__PKTGEN, &stateFlags) || test_and_set_bit(__SELF_TEST, &stateFlags))
+        return kIOReturnBusy;
+    
+    netif->stopOutputThread();
+    
+    /* Build the test frame: addressed to ourself, magic and a pattern. */
+    memcpy(p, currMacAddr.bytes, ETH_ALEN);
+    memcpy(p + ETH_ALEN, currMacAddr.bytes, ETH_ALEN);
+    OSWriteBigInt16(p, 2 * ETH_ALEN, kSelfTestEtherType);
+    OSWriteBigInt32(p, ETH_HLEN, kSelfTestMagic);
+    
+    for (i = ETH_HLEN + 4; i < frameSize; i++)
+        p[i] = (UInt8)i;
+    
+    selfTestSize = frameSize;
+    selfTestRxFrames = selfTestRxErrors = selfTestRxBusy = 0;
+
+    /* Without a link DMA has been stopped by setLinkDown(). */
+    if (!test_bit(__LINK_UP, &stateFlags)) {
+        rtl8125_disable_rxdvgate(tp);
+        WriteReg8(ChipCmd, CmdTxEnb | CmdRxEnb);
+    }
+    WriteReg32(TxConfig, ReadReg32(TxConfig) | TxMACLoopBack);
+    
+    return kIOReturnSuccess;
+}
+
+void LucyRTL8125::selfTestStop()
+{
+    bool linkUp;
+    
+    WriteReg32(TxConfig, ReadReg32(TxConfig) & ~TxMACLoopBack);
+    
+    if (test_bit(__LINK_UP, &stateFlags))
+        netif->startOutputThread();
+    else
+        stopRxTxRTL8125();
+    
+    clear_bit(__SELF_TEST, &stateFlags);
+    
+    /* Handle a link change which has been ignored during the test. */
+    linkUp = (ReadReg16(PHYstatus) & LinkStatus) != 0;
+    
+    if (linkUp != (test_bit(__LINK_UP, &stateFlags) != 0))
+        checkLinkStatus();
+}
+
+/*
+ * Control the packet generator. Unlike the self test it doesn't take
+ * over the rings: its frames are posted from outputStart() next to the
+ * stack's packets. The output thread is kicked by a timer, so that the
+ * generator keeps running when the stack is idle.
+ */
+IOReturn LucyRTL8125::pktGenRequest(UInt32 request, const RtlPktGenParams *params, RtlPktGenStatus *status)
+{
+    if (request == kRtlMethodPktGenStart) {
+        if ((params->frameSize < ETH_ZLEN) || (params->frameSize > (mtu + ETH_HLEN)) ||
+            (params->frameSize > kGenSlotSize) || !params->flows ||
+            (params->flows > kRtlPktGenMaxFlows) || !params->burst)
+            return kIOReturnBadArgument;
+        
+        if (!genBuf)
+            return kIOReturnNoMemory;
+        
+        waitForBringUp();
+    }
+    return commandGate->runAction(pktGenAction, (void *)(uintptr_t)request, (void *)params, (void *)status);
+}
+
+IOReturn LucyRTL8125::pktGenAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4)
+{
+    LucyRTL8125 *ethCtlr = OSDynamicCast(LucyRTL8125, owner);
+    IOReturn result = kIOReturnError;
+    
+    if (ethCtlr) {
+        switch ((UInt32)(uintptr_t)arg1) {
+            case kRtlMethodPktGenStart:
+                result = ethCtlr->pktGenStart((const RtlPktGenParams *)arg2);
+                break;
+                
+            case kRtlMethodPktGenStop:
+                if (test_bit(__PKTGEN, &ethCtlr->stateFlags))
+                    ethCtlr->pktGenStop();
+                
+                result = kIOReturnSuccess;
+                break;
+                
+            case kRtlMethodPktGenStatus:
+                ethCtlr->pktGenGetStatus((RtlPktGenStatus *)arg3);
+                result = kIOReturnSuccess;
+                break;
+                
+            default:
+                result = kIOReturnBadArgument;
+                break;
+        }
+    }
+    return result;
+}
+
+IOReturn LucyRTL8125::pktGenStart(const RtlPktGenParams *params)
+{
+    UInt32 i;
+    
+    if (!test_bit(__ENABLED, &stateFlags) || (powerState != kPowerStateOn))
+        return kIOReturnNotReady;
+    
+    if (test_bit(__SELF_TEST, &stateFlags) || test_bit(__PKTGEN, &stateFlags))
+        return kIOReturnBusy;
+    
+    pktGenParams = *params;
+    
+    for (i = 0; i < pktGenParams.flows; i++)
+        pktGenBuildFrame(genBuf + (i * kGenSlotSize), i);
+    
+    pktGenSent = pktGenDropped = pktGenRingFull = 0;
+    pktGenCredit = 0;
+    pktGenSlot = 0;
+    clock_get_uptime(&pktGenStartTime);
+    pktGenStamp = pktGenStartTime;
+    pktGenStopTime = 0;
+    
+    /* Make sure the frames are in place before outputStart() sees the bit. */
+    OSSynchronizeIO();
+    set_bit(__PKTGEN, &stateFlags);
+
+    pktGenSource->setTimeoutMS(kPktGenTickMS);
+    netif->signalOutputThread();
+    
+    IOLog("Packet generator on en%u: %u byte frames, %u pps, %u flows.\n", netif->getUnitNumber(), pktGenParams.frameSize, pktGenParams.rate, pktGenParams.flows);
+
+    return kIOReturnSuccess;
+}
+
+void LucyRTL8125::pktGenStop()
+{
+    clear_bit(__PKTGEN, &stateFlags);
+    pktGenSource->cancelTimeout();
+    clock_get_uptime(&pktGenStopTime);
+    
+    IOLog("Packet generator on en%u: %llu frames sent, %llu dropped.\n", netif->getUnitNumber(), pktGenSent, pktGenDropped);
+}
+
+void LucyRTL8125::pktGenGetStatus(RtlPktGenStatus *status)
+{
+    UInt64 end;
+    
+    bzero(status, sizeof(RtlPktGenStatus));
+    
+    if (!pktGenStartTime)
+        return;
+    
+    status->running = test_bit(__PKTGEN, &stateFlags) ? 1 : 0;
+    status->sentFrames = pktGenSent;
+    status->droppedFrames = pktGenDropped;
+    status->ringFull = pktGenRingFull;
+    
+    if (status->running)
+        clock_get_uptime(&end);
+    else
+        end = pktGenStopTime;
+    
+    absolutetime_to_nanoseconds(end - pktGenStartTime, &status->duration);
+    
+    if (status->duration) {
+        status->framesPerSec = (pktGenSent * 1000000000ULL) / status->duration;
+        status->mbitPerSec = (pktGenSent * pktGenParams.frameSize * 8000ULL) / status->duration;
+    }
+}
+
+/* Build the template frame of a flow, a UDP datagram to the discard port. */
+void LucyRTL8125::pktGenBuildFrame(UInt8 *p, UInt32 flow)
+{
+    static const UInt8 bcastAddr[ETH_ALEN] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+    static const UInt8 zeroAddr[ETH_ALEN] = { 0, 0, 0, 0, 0, 0 };
+    UInt8 *ip = p + ETH_HLEN;
+    UInt8 *udp = ip + 20;
+    UInt32 size = pktGenParams.frameSize;
+    UInt32 sum = 0;
+    UInt32 i;
+    
+    if (memcmp(pktGenParams.dstAddr, zeroAddr, ETH_ALEN))
+        memcpy(p, pktGenParams.dstAddr, ETH_ALEN);
+    else
+        memcpy(p, bcastAddr, ETH_ALEN);
+    
+    memcpy(p + ETH_ALEN, currMacAddr.bytes, ETH_ALEN);
+    OSWriteBigInt16(p, 2 * ETH_ALEN, ETHERTYPE_IP);
+    
+    /* IPv4 header from 198.18.0.1 to 198.18.0.2 (RFC 2544). */
+    bzero(ip, 20);
+    ip[0] = 0x45;
+    OSWriteBigInt16(ip, 2, size - ETH_HLEN);
+    OSWriteBigInt16(ip, 4, flow);
+    OSWriteBigInt16(ip, 6, 0x4000);
+    ip[8] = 64;
+    ip[9] = IPPROTO_UDP;
+    OSWriteBigInt32(ip, 12, 0xC6120001);
+    OSWriteBigInt32(ip, 16, 0xC6120002);
+    
+    for (i = 0; i < 20; i += 2)
+        sum += OSReadBigInt16(ip, i);
+    
+    while (sum >> 16)
+        sum = (sum & 0xffff) + (sum >> 16);
+    
+    OSWriteBigInt16(ip, 10, ~sum & 0xffff);
+    
+    /* UDP header without checksum, one source port per flow. */
+    OSWriteBigInt16(udp, 0, 1024 + flow);
+    OSWriteBigInt16(udp, 2, 9);
+    OSWriteBigInt16(udp, 4, size - ETH_HLEN - 20);
+    OSWriteBigInt16(udp, 6, 0);
+    
+    for (i = ETH_HLEN + 28; i < size; i++)
+        p[i] = (UInt8)i;
+}
+
+/*
+ * Kicks the output thread, so that outputStart() gets a chance to post
+ * frames when the stack is idle, and stops the generator after count
+ * frames.
+ */
+void LucyRTL8125::pktGenTimerAction(IOTimerEventSource *timer)
+{
+    if (!test_bit(__PKTGEN, &stateFlags))
+        return;
+    
+    if (pktGenParams.count && (pktGenSent >= pktGenParams.count)) {
+        pktGenStop();
+        return;
+    }
+    netif->signalOutputThread();
+    pktGenSource->setTimeoutMS(kPktGenTickMS);
+}
+
+/*
+ * Called by a user client which is going away. Stops everything the
+ * client has started, so that nothing keeps running without a consumer.
+ */
+void LucyRTL8125::releaseClient(OSObject *client)
+{
+    if (commandGate)
+        commandGate->runAction(releaseClientAction, client);
+}
+
+IOReturn LucyRTL8125::releaseClientAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4)
+{
+    LucyRTL8125 *ethCtlr = OSDynamicCast(LucyRTL8125, owner);
+    OSObject *client = (OSObject *)arg1;
+    
+    if (ethCtlr) {
+        if (test_bit(__CAPTURE, &ethCtlr->stateFlags) && (ethCtlr->captureOwner == client))
+            ethCtlr->captureStop();
+        
+        if (test_bit(__USER_QUEUE, &ethCtlr->stateFlags) && (ethCtlr->userQueueOwner == client))
+            ethCtlr->userQueueStop();
+    }
+    return kIOReturnSuccess;
+}
+
+/*
+ * Packet capture. The taps in rxInterrupt() and outputStart() copy the
+ * first snapLen bytes of each frame into a block ring shared with the
+ * consumer. rx and tx have separate rings, each one protected by a
+ * spinlock against captureTimerAction(), which retires partially
+ * filled blocks when traffic stops. A slow consumer loses packets, but
+ * never stalls the data path.
+ */
+IOReturn LucyRTL8125::captureRequest(OSObject *client, UInt32 request, const UInt64 *values)
+{
+    if (!captureLock[kRtlCaptureRx])
+        return kIOReturnNoMemory;
+    
+    return commandGate->runAction(captureAction, (void *)(uintptr_t)request, (void *)values, client);
+}
+
+IOReturn LucyRTL8125::captureAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4)
+{
+    LucyRTL8125 *ethCtlr = OSDynamicCast(LucyRTL8125, owner);
+    const UInt64 *values = (const UInt64 *)arg2;
+    OSObject *client = (OSObject *)arg3;
+    IOReturn result = kIOReturnError;
+    
+    if (ethCtlr) {
+        switch ((UInt32)(uintptr_t)arg1) {
+            case kRtlMethodCaptureStart:
+                result = ethCtlr->captureStart(client, (UInt32)values[0], (UInt32)values[1], (UInt32)values[2]);
+                break;
+                
+            case kRtlMethodCaptureStop:
+                result = kIOReturnSuccess;
+                
+                if (test_bit(__CAPTURE, &ethCtlr->stateFlags)) {
+                    if (ethCtlr->captureOwner == client)
+                        ethCtlr->captureStop();
+                    else
+                        result = kIOReturnNotPermitted;
+                }
+                break;
+                
+            default:
+                result = kIOReturnBadArgument;
+                break;
+        }
+    }
+    return result;
+}
+
+IOReturn LucyRTL8125::captureStart(OSObject *client, UInt32 snapLen, UInt32 blockSize, UInt32 blockCount)
+{
+    UInt32 size;
+    UInt32 i;
+    
+    if (test_bit(__CAPTURE, &stateFlags))
+        return kIOReturnBusy;
+    
+    if (!snapLen)
+        snapLen = kRtlCaptureDefaultSnapLen;
+    
+    if (!blockSize)
+        blockSize = kRtlCaptureDefaultBlockSize;
+    
+    if (!blockCount)
+        blockCount = kRtlCaptureDefaultBlocks;
+    
+    if ((snapLen > kRtlCaptureMaxSnapLen) || (blockSize > kRtlCaptureMaxBlockSize) ||
+        (blockSize & PAGE_MASK) || (blockCount > kRtlCaptureMaxBlocks) ||
+        (blockSize < (sizeof(RtlCaptureBlock) + sizeof(RtlCapturePacket) + snapLen + 7)))
+        return kIOReturnBadArgument;
+    
+    size = PAGE_SIZE + (kRtlCaptureRingCount * blockCount * blockSize);
+    
+    /* Drop our reference to the previous area, clients may still map it. */
+    RELEASE(captureDesc);
+    
+    captureDesc = IOBufferMemoryDescriptor::withOptions(kIODirectionInOut | kIOMemoryKernelUserShared, size, PAGE_SIZE);
+    
+    if (!captureDesc) {
+        IOLog("Couldn't alloc captureDesc.\n");
+        return kIOReturnNoMemory;
+    }
+    captureHdr = (RtlCaptureHeader *)captureDesc->getBytesNoCopy();
+    bzero(captureHdr, size);
+    
+    captureHdr->version = kRtlCaptureVersion;
+    captureHdr->size = size;
+    captureHdr->blockSize = blockSize;
+    captureHdr->snapLen = snapLen;
+    captureHdr->retireMS = kRtlCaptureRetireMS;
+    
+    for (i = 0; i < kRtlCaptureRingCount; i++) {
+        captureHdr->ring[i].firstBlock = PAGE_SIZE + (i * blockCount * blockSize);
+        captureHdr->ring[i].blockCount = blockCount;
+    }
+    bzero(captureState, sizeof(captureState));
+    captureSnapLen = snapLen;
+    captureBlockSize = blockSize;
+    captureBlockCount = blockCount;
+    captureOwner = client;
+    
+    set_bit(__CAPTURE, &stateFlags);
+    captureSource->setTimeoutMS(kRtlCaptureRetireMS);
+    
+    IOLog("Capture on en%u: snap length %u, %u blocks of %u bytes per ring.\n", netif->getUnitNumber(), snapLen, blockCount, blockSize);
+
+    return kIOReturnSuccess;
+}
+
+/*
+ * Hand the last blocks to the consumer and stop the taps. The area
+ * remains valid for the consumer as long as it's mapped.
+ */
+void LucyRTL8125::captureStop()
+{
+    UInt32 i;
+    
+    IOSimpleLockLock(captureLock[kRtlCaptureRx]);
+    IOSimpleLockLock(captureLock[kRtlCaptureTx]);
+    
+    for (i = 0; i < kRtlCaptureRingCount; i++) {
+        if (captureState[i].numPackets)
+            captureRetire(i);
+    }
+    clear_bit(__CAPTURE, &stateFlags);
+    
+    IOSimpleLockUnlock(captureLock[kRtlCaptureTx]);
+    IOSimpleLockUnlock(captureLock[kRtlCaptureRx]);
+    
+    captureSource->cancelTimeout();
+    captureOwner = NULL;
+    
+    IOLog("Capture on en%u: %llu rx and %llu tx packets, %llu and %llu dropped.\n", netif->getUnitNumber(),
+          captureHdr->ring[kRtlCaptureRx].packets, captureHdr->ring[kRtlCaptureTx].packets,
+          captureHdr->ring[kRtlCaptureRx].drops, captureHdr->ring[kRtlCaptureTx].drops);
+}
+
+/* Retains the memory descriptor at arg1 and returns it in arg2. */
+static IOReturn copyMemoryAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4)
+{
+    IOBufferMemoryDescriptor *desc = *(IOBufferMemoryDescriptor **)arg1;
+    
+    if (desc)
+        desc->retain();
+    
+    *(IOMemoryDescriptor **)arg2 = desc;
+    
+    return kIOReturnSuccess;
+}
+
+/* Returns a retained reference to the capture area or NULL. */
+IOMemoryDescriptor *LucyRTL8125::copyCaptureMemory()
+{
+    IOMemoryDescriptor *desc = NULL;
+    
+    commandGate->runAction(copyMemoryAction, &captureDesc, &desc);
+    
+    return desc;
+}
+
+/*
+ * The layout is taken from our own copy of the parameters, as the
+ * consumer may write to the shared header.
+ */
+inline RtlCaptureBlock *LucyRTL8125::captureBlock(UInt32 ring, UInt32 index)
+{
+    return (RtlCaptureBlock *)((UInt8 *)captureHdr + PAGE_SIZE + (((ring * captureBlockCount) + index) * captureBlockSize));
+}
+
+void LucyRTL8125::captureFrame(UInt32 ring, mbuf_t m, UInt32 len, UInt32 status, UInt16 vlanTag)
+{
+    RtlCaptureState *state = &captureState[ring];
+    RtlCaptureBlock *block;
+    RtlCapturePacket *pkt;
+    UInt64 now;
+    UInt32 capLen;
+    UInt32 size;
+    
+    clock_get_uptime(&now);
+    absolutetime_to_nanoseconds(now, &now);
+    
+    IOSimpleLockLock(captureLock[ring]);
+    
+    if (!test_bit(__CAPTURE, &stateFlags))
+        goto done;
+    
+    capLen = (len < captureSnapLen) ? len : captureSnapLen;
+    size = (sizeof(RtlCapturePacket) + capLen + 7) & ~7;
+    
+    /* Close the current block if the packet doesn't fit or it's too old. */
+    if (state->numPackets && (((state->offset + size) > captureBlockSize) ||
+        ((now - state->firstTime) >= (kRtlCaptureRetireMS * 1000000ULL))))
+        captureRetire(ring);
+    
+    block = captureBlock(ring, state->block);
+    
+    if (!state->numPackets) {
+        if (block->status != kRtlBlockKernel) {
+            captureHdr->ring[ring].drops++;
+            goto done;
+        }
+        state->offset = sizeof(RtlCaptureBlock);
+        state->firstTime = now;
+    }
+    pkt = (RtlCapturePacket *)((UInt8 *)block + state->offset);
+    pkt->nextOffset = size;
+    pkt->capLen = capLen;
+    pkt->wireLen = len;
+    pkt->status = status;
+    pkt->time = now;
+    pkt->vlanTag = vlanTag;
+    
+    mbuf_copydata(m, 0, capLen, pkt + 1);
+    
+    state->offset += size;
+    state->numPackets++;
+    state->lastTime = now;
+    captureHdr->ring[ring].packets++;
+    
+done:
+    IOSimpleLockUnlock(captureLock[ring]);
+}
+
+/* Hand the current block of a ring to the consumer. Called with the ring's lock held. */
+void LucyRTL8125::captureRetire(UInt32 ring)
+{
+    RtlCaptureState *state = &captureState[ring];
+    RtlCaptureBlock *block = captureBlock(ring, state->block);
+    
+    block->numPackets = state->numPackets;
+    block->firstOffset = sizeof(RtlCaptureBlock);
+    block->length = state->offset;
+    block->seq = state->seq++;
+    block->firstTime = state->firstTime;
+    block->lastTime = state->lastTime;
+    
+    /* The block's content must be visible before its status. */
+    smp_wmb();
+    block->status = kRtlBlockUser;
+    
+    if (++state->block >= captureBlockCount)
+        state->block = 0;
+    
+    state->numPackets = 0;
+}
+
+/* Runs every kRtlCaptureRetireMS as long as the capture is active. */
+void LucyRTL8125::captureTimerAction(IOTimerEventSource *timer)
+{
+    if (!test_bit(__CAPTURE, &stateFlags))
+        return;
+    
+    captureFlush();
+    timer->setTimeoutMS(kRtlCaptureRetireMS);
+}
+
+/* Retire blocks which have been waiting too long for more packets. */
+void LucyRTL8125::captureFlush()
+{
+    UInt64 now;
+    UInt32 i;
+    
+    clock_get_uptime(&now);
+    absolutetime_to_nanoseconds(now, &now);
+    
+    for (i = 0; i < kRtlCaptureRingCount; i++) {
+        IOSimpleLockLock(captureLock[i]);
+        
+        if (test_bit(__CAPTURE, &stateFlags) && captureState[i].numPackets &&
+            ((now - captureState[i].firstTime) >= (kRtlCaptureRetireMS * 1000000ULL)))
+            captureRetire(i);
+        
+        IOSimpleLockUnlock(captureLock[i]);
+    }
+}
+
+/*
+ * User queue. The consumer's tx slots are sent through the chip's
+ * second tx queue, whose descriptors are private to the driver, so
+ * that every buffer address is validated before it's handed to the
+ * chip. rx frames are steered by ethertype in rxInterrupt().
+ */
+IOReturn LucyRTL8125::userQueueRequest(OSObject *client, UInt32 request, UInt32 etherType)
+{
+    if (!userQueueLock)
+        return kIOReturnNoMemory;
+    
+    if (request == kRtlMethodUserQueueStart) {
+        if (etherType > 0xffff)
+            return kIOReturnBadArgument;
+        
+        waitForBringUp();
+    }
+    return commandGate->runAction(userQueueAction, (void *)(uintptr_t)request, (void *)(uintptr_t)etherType, client);
+}
+
+IOReturn LucyRTL8125::userQueueAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4)
+{
+    LucyRTL8125 *ethCtlr = OSDynamicCast(LucyRTL8125, owner);
+    OSObject *client = (OSObject *)arg3;
+    IOReturn result = kIOReturnError;
+    
+    if (ethCtlr) {
+        switch ((UInt32)(uintptr_t)arg1) {
+            case kRtlMethodUserQueueStart:
+                result = ethCtlr->userQueueStart(client, (UInt32)(uintptr_t)arg2);
+                break;
+                
+            case kRtlMethodUserQueueStop:
+                result = kIOReturnSuccess;
+                
+                if (test_bit(__USER_QUEUE, &ethCtlr->stateFlags)) {
+                    if (ethCtlr->userQueueOwner == client)
+                        ethCtlr->userQueueStop();
+                    else
+                        result = kIOReturnNotPermitted;
+                }
+                break;
+                
+            case kRtlMethodUserQueueTxSync:
+                if (test_bit(__USER_QUEUE, &ethCtlr->stateFlags) && (ethCtlr->userQueueOwner != client))
+                    result = kIOReturnNotPermitted;
+                else
+                    result = ethCtlr->userQueueTxSync();
+                break;
+                
+            default:
+                result = kIOReturnBadArgument;
+                break;
+        }
+    }
+    return result;
+}
+
+IOReturn LucyRTL8125::userQueueStart(OSObject *client, UInt32 etherType)
+{
+    RtlUserRing *ring;
+    UInt32 i;
+    
+    if (!test_bit(__ENABLED, &stateFlags) || (powerState != kPowerStateOn))
+        return kIOReturnNotReady;
+    
+    if (test_bit(__USER_QUEUE, &stateFlags) || test_bit(__SELF_TEST, &stateFlags))
+        return kIOReturnBusy;
+    
+    if (!setupUserQueueArea())
+        return kIOReturnNoMemory;
+    
+    userQueueHdr->version = kRtlUserQueueVersion;
+    userQueueHdr->size = kUserQueueSize;
+    userQueueHdr->numBufs = kRtlUserQueueBufs;
+    userQueueHdr->bufSize = kRtlUserQueueBufSize;
+    userQueueHdr->bufOffset = kUserQueueBufOffset;
+    userQueueHdr->etherType = etherType;
+    
+    /* Initially each slot has its own buffer, the rest are spare. */
+    for (i = 0; i < kRtlUserQueueRingCount; i++) {
+        ring = &userQueueHdr->ring[i];
+        ring->numSlots = kRtlUserQueueSlots;
+        ring->slotOffset = kUserQueueSlotOffset + (i * kRtlUserQueueSlots * sizeof(RtlUserSlot));
+    }
+    for (i = 0; i < kRtlUserQueueSlots; i++) {
+        userQueueSlots[kRtlUserQueueTx][i].bufIndex = i;
+        userQueueSlots[kRtlUserQueueRx][i].bufIndex = kRtlUserQueueSlots + i;
+    }
+
+    /* The consumer may fill all tx slots but one. */
+    userTxNextIndex = 0;
+    userTxDescIndex = 0;
+    userTxTail = kRtlUserQueueSlots - 1;
+    userQueueHdr->ring[kRtlUserQueueTx].tail = userTxTail;
+    userRxTail = 0;
+    userQueueOwner = client;
+    
+    set_bit(__USER_QUEUE, &stateFlags);
+    
+    /* Reset the MAC in order to enable the second tx queue. */
+    resetMacRTL8125();
+    
+    userRxEtherType = etherType;
+    
+    IOLog("User queue on en%u started, rx ethertype 0x%04x.\n", netif->getUnitNumber(), etherType);
+
+    return kIOReturnSuccess;
+}
+
+void LucyRTL8125::userQueueStop()
+{
+    IOSimpleLockLock(userQueueLock);
+    userRxEtherType = 0;
+    clear_bit(__USER_QUEUE, &stateFlags);
+    IOSimpleLockUnlock(userQueueLock);
+    
+    /* Stop DMA and disable the second tx queue before its ring goes away. */
+    if (test_bit(__ENABLED, &stateFlags) && (powerState == kPowerStateOn))
+        resetMacRTL8125();
+    
+    IOLog("User queue on en%u: %llu tx and %llu rx packets, %llu rx dropped.\n", netif->getUnitNumber(),
+          userQueueHdr->ring[kRtlUserQueueTx].packets, userQueueHdr->ring[kRtlUserQueueRx].packets,
+          userQueueHdr->ring[kRtlUserQueueRx].drops);
+
+    freeUserQueueArea();
+    userQueueOwner = NULL;
+}
+
+/*
+ * Send the tx slots the consumer has released up to head and return
+ * the completed ones by advancing tail. Stops at the first invalid
+ * slot, which is left to the consumer. head must lie between the next
+ * slot to send and tail, otherwise the consumer would hand back slots
+ * which are still in flight.
+ */
+IOReturn LucyRTL8125::userQueueTxSync()
+{
+    RtlUserRing *ring;
+    RtlUserSlot *slot;
+    RtlTxDesc *desc;
+    UInt64 addr;
+    UInt32 head;
+    UInt32 index;
+    UInt32 len;
+    UInt32 opts1;
+    UInt32 posted = 0;
+    UInt32 inFlight;
+    UInt32 nextClosePtr;
+    UInt32 numDone;
+    IOReturn result = kIOReturnSuccess;
+    
+    if (!test_bit(__USER_QUEUE, &stateFlags))
+        return kIOReturnNotReady;
+    
+    ring = &userQueueHdr->ring[kRtlUserQueueTx];
+    head = ring->head;
+    
+    if ((head >= kRtlUserQueueSlots) ||
+        (((head + kRtlUserQueueSlots - userTxNextIndex) % kRtlUserQueueSlots) >
+         ((userTxTail + kRtlUserQueueSlots - userTxNextIndex) % kRtlUserQueueSlots))) {
+        ring->errors++;
+        return kIOReturnBadArgument;
+    }
+    /* Read the slots the consumer has released only after head. */
+    smp_rmb();
+    
+    /* Without a link DMA is stopped and the slots wait. */
+    if (!test_bit(__LINK_UP, &stateFlags))
+        return kIOReturnNotReady;
+    
+    while ((userTxNextIndex != head) && (userTxNextIndex != userTxTail)) {
+        slot = &userQueueSlots[kRtlUserQueueTx][userTxNextIndex];
+        index = slot->bufIndex;
+        len = slot->len;
+        
+        if ((index >= kRtlUserQueueBufs) || (len < ETH_ZLEN) || (len > kRtlUserQueueBufSize)) {
+            ring->errors++;
+            result = kIOReturnBadArgument;
+            break;
+        }
+        addr = (UInt64)index * kRtlUserQueueBufSize;
+        addr = userQueuePages[addr / PAGE_SIZE] + (addr & PAGE_MASK);
+        
+        desc = &userTxDescArray[userTxDescIndex];
+        opts1 = (len | FirstFrag | LastFrag | DescOwn);
+        
+        if (userTxDescIndex == (kRtlUserQueueSlots - 1))
+            opts1 |= RingEnd;
+        
+        desc->addr = OSSwapHostToLittleInt64(addr);
+        desc->opts2 = 0;
+        desc->opts1 = OSSwapHostToLittleInt32(opts1);
+        
+        if (++userTxDescIndex >= kRtlUserQueueSlots)
+            userTxDescIndex = 0;
+        
+        if (++userTxNextIndex >= kRtlUserQueueSlots)
+            userTxNextIndex = 0;
+        
+        userTxTailPtr++;
+        posted++;
+    }
+    if (posted)
+        WriteReg16(SW_TAIL_PTR1_8125, userTxTailPtr & 0xffff);
+    
+    /* Reclaim completed descriptors. */
+    nextClosePtr = ReadReg16(HW_CLO_PTR1_8125);
+    numDone = ((nextClosePtr - userTxClosePtr) & 0xffff);
+    inFlight = (userTxNextIndex + kRtlUserQueueSlots - userTxTail - 1) % kRtlUserQueueSlots;
+    
+    if (numDone > inFlight)
+        numDone = inFlight;
+    
+    userTxClosePtr += numDone;
+    userTxTail = (userTxTail + numDone) % kRtlUserQueueSlots;
+    ring->packets += numDone;
+    ring->tail = userTxTail;
+    
+    return result;
+}
+
+/*
+ * Copy a frame of the steered ethertype to the next rx slot. Returns
+ * true in case the frame has been consumed.
+ */
+bool LucyRTL8125::userQueueReceive(mbuf_t m, UInt32 size)
+{
+    RtlUserRing *ring;
+    RtlUserSlot *slot;
+    UInt32 head;
+    UInt32 next;
+    UInt32 index;
+    bool result = false;
+    
+    if ((size < ETH_HLEN) || (OSReadBigInt16(mbuf_data(m), 2 * ETH_ALEN) != userRxEtherType))
+        goto done;
+    
+    IOSimpleLockLock(userQueueLock);
+    
+    if (!test_bit(__USER_QUEUE, &stateFlags)) {
+        IOSimpleLockUnlock(userQueueLock);
+        goto done;
+    }
+    ring = &userQueueHdr->ring[kRtlUserQueueRx];
+    head = ring->head;
+    next = (userRxTail + 1) % kRtlUserQueueSlots;
+    slot = &userQueueSlots[kRtlUserQueueRx][userRxTail];
+    index = slot->bufIndex;
+    
+    if ((head >= kRtlUserQueueSlots) || (next == head)) {
+        ring->drops++;
+    } else if ((index >= kRtlUserQueueBufs) || (size > kRtlUserQueueBufSize)) {
+        ring->errors++;
+    } else {
+        mbuf_copydata(m, 0, size, userQueueBufs + (index * kRtlUserQueueBufSize));
+        slot->len = size;
+        slot->flags = 0;
+        ring->packets++;
+        
+        /* The slot must be complete before the consumer sees it. */
+        smp_wmb();
+        userRxTail = next;
+        ring->tail = next;
+    }
+    IOSimpleLockUnlock(userQueueLock);
+    
+    freePacket(m);
+    result = true;
+
+done:
+    return result;
+}
+
+/*
+ * Called by clearRxTxRings() with DMA stopped. Frames which haven't
+ * been sent are lost, their slots are returned to the consumer.
+ */
+void LucyRTL8125::clearUserQueue()
+{
+    UInt32 i;
+    
+    for (i = 0; i < kRtlUserQueueSlots; i++)
+        userTxDescArray[i].opts1 = OSSwapHostToLittleInt32((i != (kRtlUserQueueSlots - 1)) ? 0 : RingEnd);
+    
+    userTxDescIndex = 0;
+    userTxTailPtr = userTxClosePtr = 0;
+    
+    if (userQueueHdr) {
+        userTxTail = (userTxNextIndex + kRtlUserQueueSlots - 1) % kRtlUserQueueSlots;
+        userQueueHdr->ring[kRtlUserQueueTx].tail = userTxTail;
+    }
+}
+
+/* Returns a retained reference to the user queue's area or NULL. */
+IOMemoryDescriptor *LucyRTL8125::copyUserQueueMemory()
+{
+    IOMemoryDescriptor *desc = NULL;
+    
+    commandGate->runAction(copyMemoryAction, &userQueueDesc, &desc);
+    
+    return desc;
+}
+
+/*
+ * Check a frame received during the self test. Frames of other
+ * ethertypes aren't consumed and take the normal path, so that traffic
+ * received while the link is up isn't lost and doesn't count as test
+ * frames.
+ */
+bool LucyRTL8125::selfTestReceive(mbuf_t m, UInt32 size)
+{
+    UInt8 *p = (UInt8 *)mbuf_data(m);
+    
+    if ((size < ETH_HLEN) || (OSReadBigInt16(p, 2 * ETH_ALEN) != kSelfTestEtherType))
+        return false;
+    
+    if ((size == selfTestSize) &&
+        (OSReadBigInt32(p, ETH_HLEN) == kSelfTestMagic) &&
+        (p[size - 1] == (UInt8)(size - 1)))
+        selfTestRxFrames++;
+    else
+        selfTestRxErrors++;
+    
+    freePacket(m);
+    
+    return true;
+}
+
+const char *latPathNames[kLatPathCount] = {
+    "Receive",
+    "Transmit"
+};
+
+const char *latValueNames[kLatValueCount] = {
+    "Samples",
+    "p50 ns",
+    "p99 ns",
+    "p999 ns"
+};
+
+static inline UInt32 latBucketIndex(UInt64 value)
+{
+    UInt32 msb, shift;
+    
+    if (value < kLatSubBuckets)
+        return (UInt32)value;
+    
+    msb = 63 - __builtin_clzll(value);
+    
+    if (msb >= kLatMaxBits)
+        return kLatBucketCount - 1;
+    
+    shift = msb - kLatSubBits;
+    
+    return ((shift + 1) << kLatSubBits) + (UInt32)((value >> shift) & (kLatSubBuckets - 1));
+}
+
+/* Returns the largest value which falls into bucket index. */
+static inline UInt64 latBucketLimit(UInt32 index)
+{
+    UInt32 shift;
+    
+    if (index < kLatSubBuckets)
+        return index;
+    
+    shift = (index >> kLatSubBits) - 1;
+    
+    return (((UInt64)(kLatSubBuckets + (index & (kLatSubBuckets - 1))) + 1) << shift) - 1;
+}
+
+/*
+ * Returns the value below or at which perMille of the samples lie,
+ * converted to nanoseconds.
+ */
+static UInt64 latPercentile(const RtlLatHist *hist, UInt32 perMille)
+{
+    UInt64 target, sum = 0;
+    UInt64 ns = 0;
+    UInt32 i;
+    
+    if (!hist->samples)
+        goto done;
+    
+    target = (hist->samples * perMille + 999) / 1000;
+    
+    for (i = 0; i < kLatBucketCount; i++) {
+        sum += hist->bucket[i];
+        
+        if (sum >= target)
+            break;
+    }
+    if (i == kLatBucketCount)
+        i--;
+    
+    absolutetime_to_nanoseconds(latBucketLimit(i), &ns);
+    
+done:
+    return ns;
+}
+
+void LucyRTL8125::addLatencySample(UInt32 path, UInt64 latency)
+{
+    RtlLatHist *hist = &latHist[path];
+    
+    hist->bucket[latBucketIndex(latency)]++;
+    hist->samples++;
+}
+
+/*
+ * Called after packets have been handed over to the stack. The
+ * discovery time of each packet has been recorded by rxInterrupt().
+ */
+void LucyRTL8125::rxLatencyDone(UInt32 packets)
+{
+    UInt64 now;
+    UInt32 i;
+    
+    clock_get_uptime(&now);
+    
+    if (packets > kNumRxDesc)
+        packets = kNumRxDesc;
+    
+    for (i = 0; i < packets; i++)
+        addLatencySample(kLatPathRx, now - rxLatStamp[i]);
+}
+
+void LucyRTL8125::updateLatencyStatistics()
+{
+    static const UInt32 perMille[kLatValueCount] = { 0, 500, 990, 999 };
+    UInt32 i, j;
+    
+    for (i = 0; i < kLatPathCount; i++) {
+        if (!latEnable[i] || !latNums[i][kLatSamples])
+            continue;
+        
+        latNums[i][kLatSamples]->setValue(latHist[i].samples);
+        
+        for (j = kLatP50; j < kLatValueCount; j++) {
+            if (latNums[i][j])
+                latNums[i][j]->setValue(latPercentile(&latHist[i], perMille[j]));
+        }
+    }
+}
+
+#pragma mark --- miscellaneous functions ---
+
+static inline void prepareTSO4(mbuf_t m, UInt32 *tcpOffset, UInt32 *mss)
+{
+    UInt8 *p = (UInt8 *)mbuf_data(m) + kMacHdrLen;
+    struct ip4_hdr_be *ip = (struct ip4_hdr_be *)p;
+    struct tcp_hdr_be *tcp;
+    UInt16 csum;
+    //UInt32 max;
+    UInt32 il, tl;
+    
+    csum = pseudoHdrCsum(ip->addr, sizeof(ip->addr));
+    il = ((ip->hdr_len & 0x0f) << 2);
+    
+    tcp = (struct tcp_hdr_be *)(p + il);
+    tl = ((tcp->dat_off & 0xf0) >> 2);
+    //max = ETH_DATA_LEN - (il + tl);
+
+    /* Fill in the pseudo header checksum for TSOv4. */
+    tcp->csum = csum;
+
+    *tcpOffset = kMacHdrLen + il;
+    
+    if (*mss > MSS_MAX)
+        *mss = MSS_MAX;
+}
+
+static inline void prepareTSO6(mbuf_t m, UInt32 *tcpOffset, UInt32 *mss)
+{
+    UInt8 *p = (UInt8 *)mbuf_data(m) + kMacHdrLen;
+    struct ip6_hdr_be *ip6 = (struct ip6_hdr_be *)p;
+    struct tcp_hdr_be *tcp;
+    UInt16 csum;
+    UInt32 tl;
+    //UInt32 max;
+
+    ip6->pay_len = 0;
+
+    csum = pseudoHdrCsum(ip6->addr, sizeof(ip6->addr));
 
-    for (i = 0; i < 16; i++) {
-        csum32 += ntohs(ip6->addr[i]);
-        csum32 += (csum32 >> 16);
-        csum32 &= 0xffff;
-    }
     /* Get the length of the TCP header. */
     tcp = (struct tcp_hdr_be *)(p + kIPv6HdrLen);
     tl = ((tcp->dat_off & 0xf0) >> 2);
     //max = ETH_DATA_LEN - (kIPv6HdrLen + tl);
 
     /* Fill in the pseudo header checksum for TSOv6. */
-    tcp->csum = htons((UInt16)csum32);
+    tcp->csum = csum;
 
     *tcpOffset = kMacHdrLen + kIPv6HdrLen;
     
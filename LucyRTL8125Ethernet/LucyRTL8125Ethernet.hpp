@@ -21,6 +21,8 @@
 #include <IOKit/IODMACommand.h>
 
 #include "LucyRTL8125Linux-900501.hpp"
+#include "LucyRTL8125UserClient.hpp"
+#include "LucyRTL8125Ptp.hpp"
 
 #ifdef DEBUG
 #define DebugLog(args...) IOLog(args)
@@ -122,6 +124,11 @@ enum RtlStateFlags {
     __M_CAST = 3,       /* multicast mode enabled */
     __POLL_MODE = 4,    /* poll mode is active */
     __POLLING = 5,      /* poll routine is polling */
+    __TX_WATCH = 6,     /* tx stall detector is armed */
+    __SELF_TEST = 7,    /* self test owns the rings */
+    __PKTGEN = 8,       /* packet generator is running */
+    __CAPTURE = 9,      /* capture tap is active */
+    __USER_QUEUE = 10,  /* second tx queue belongs to user space */
 };
 
 enum RtlStateMask {
@@ -131,6 +138,11 @@ enum RtlStateMask {
     __M_CAST_M = (1 << __M_CAST),
     __POLL_MODE_M = (1 << __POLL_MODE),
     __POLLING_M = (1 << __POLLING),
+    __TX_WATCH_M = (1 << __TX_WATCH),
+    __SELF_TEST_M = (1 << __SELF_TEST),
+    __PKTGEN_M = (1 << __PKTGEN),
+    __CAPTURE_M = (1 << __CAPTURE),
+    __USER_QUEUE_M = (1 << __USER_QUEUE),
 };
 
 /* RTL8125's Rx descriptor. */
@@ -140,6 +152,23 @@ typedef struct RtlRxDesc {
     UInt64 addr;
 } RtlRxDesc;
 
+/*
+ * RTL8125's Rx descriptor in the v3 format, which is used on chips with a
+ * PTP clock. A frame's time stamp is written to the descriptor following
+ * its own one: addr holds ns and the lower 32 bits of the seconds, opts2
+ * the upper 16 bits of the seconds.
+ */
+typedef struct RtlRxDescV3 {
+    UInt64 reserved0;
+    UInt64 reserved1;
+    UInt64 addr;
+    UInt32 opts2;
+    UInt32 opts1;
+} RtlRxDescV3;
+
+/* Types of v3 Rx descriptors in opts1. */
+#define rxDescTypeV3(opts1) (((opts1) >> 26) & 0x0f)
+
 /* RTL8125's Tx descriptor. */
 typedef struct RtlTxDesc {
     UInt32 opts1;
@@ -151,7 +180,48 @@ typedef struct RtlTxDesc {
     UInt32 reserved3; */
 } RtlTxDesc;
 
-/* RTL8125's statistics dump data structure */
+/* Recovery tiers, in the order they are tried after a Tx stall. */
+enum RtlRecoveryTier {
+    kRecoveryQueue = 0, /* restart DMA and resync the rings */
+    kRecoveryMAC,       /* reset the MAC, keep PHY and link */
+    kRecoveryChip,      /* full restart including PHY setup */
+    kRecoveryTierCount
+};
+
+/* Recovery statistics of one tier, outage times in µs. */
+typedef struct RtlRecoveryStat {
+    UInt32 count;
+    UInt32 lastOutage;
+    UInt32 maxOutage;
+} RtlRecoveryStat;
+
+/* Start-up and link-up phases, marked when they have been completed. */
+enum RtlPhase {
+    kPhaseStart = 0,
+    kPhaseIdentifyChip,
+    kPhaseInit,
+    kPhaseExitOOB,
+    kPhaseHwInit,
+    kPhaseEphy,
+    kPhasePhyPatch,
+    kPhasePhyConfig,
+    kPhaseSetup,
+    kPhaseMedium,
+    kPhaseAutoneg,
+    kPhaseLinkUp,
+    kPhaseCount
+};
+
+/* One entry of the phase marker ring, time in absolute time units. */
+typedef struct RtlPhaseMarker {
+    UInt64 time;
+    UInt32 phase;
+} RtlPhaseMarker;
+
+/*
+ * RTL8125's statistics dump data structure. The first 64 bytes are the
+ * legacy tally layout, the RTL8125 family appends an extended block.
+ */
 typedef struct RtlStatData {
     UInt64    txPackets;
     UInt64    rxPackets;
@@ -166,8 +236,197 @@ typedef struct RtlStatData {
     UInt32    rxMulticast;
     UInt16    txAborted;
     UInt16    txUnderun;
+    /* extended tally counters */
+    UInt64    txOctets;
+    UInt64    rxOctets;
+    UInt64    rxMulticast64;
+    UInt64    txUnicast64;
+    UInt64    txBroadcast64;
+    UInt64    txMulticast64;
+    UInt32    txPauseOn;
+    UInt32    txPauseOff;
+    UInt32    txPauseAll;
+    UInt32    txDeferred;
+    UInt32    txLateCollision;
+    UInt32    txAllCollision;
+    UInt32    txAborted32;
+    UInt32    alignErrors32;
+    UInt32    rxFrameTooLong;
+    UInt32    rxRunt;
+    UInt32    rxPauseOn;
+    UInt32    rxPauseOff;
+    UInt32    rxPauseAll;
+    UInt32    rxUnknownOpcode;
+    UInt32    rxMacError;
+    UInt32    txUnderrun32;
+    UInt32    rxMacMissed;
+    UInt32    rxTcamDropped;
+    UInt32    txDescUnavail;
+    UInt32    rxDescUnavail;
 } RtlStatData;
 
+/* Size of the legacy part of RtlStatData. */
+#define kStatLegacySize 64
+
+/* Tally counters accumulated to 64 bits by accumulateStatistics(). */
+enum RtlStatIndex {
+    kStatTxPackets = 0,
+    kStatRxPackets,
+    kStatTxErrors,
+    kStatRxErrors,
+    kStatRxMissed,
+    kStatAlignErrors,
+    kStatTxOneCollision,
+    kStatTxMultiCollision,
+    kStatRxUnicast,
+    kStatRxBroadcast,
+    kStatRxMulticast,
+    kStatTxAborted,
+    kStatTxUnderrun,
+    kStatLegacyCount,
+    kStatTxOctets = kStatLegacyCount,
+    kStatRxOctets,
+    kStatTxUnicast,
+    kStatTxBroadcast,
+    kStatTxMulticast,
+    kStatTxPauseOn,
+    kStatTxPauseOff,
+    kStatTxPauseAll,
+    kStatTxDeferred,
+    kStatTxLateCollision,
+    kStatTxAllCollision,
+    kStatRxFrameTooLong,
+    kStatRxRunt,
+    kStatRxPauseOn,
+    kStatRxPauseOff,
+    kStatRxPauseAll,
+    kStatRxUnknownOpcode,
+    kStatRxMacError,
+    kStatRxMacMissed,
+    kStatRxTcamDropped,
+    kStatTxDescUnavail,
+    kStatRxDescUnavail,
+    kStatCount
+};
+
+/* Polls of 10µs to wait for a synchronous tally dump. */
+#define kStatDumpPolls 100
+
+/*
+ * Group and name in the statistics dictionary, offset in RtlStatData
+ * and width in bytes of a tally counter.
+ */
+typedef struct RtlStatCounter {
+    const char *group;
+    const char *name;
+    UInt32 offset;
+    UInt32 width;
+} RtlStatCounter;
+
+/* Event counters of the data path, published as "DataPathStatistics". */
+enum RtlPathIndex {
+    kPathRxCalls = 0,
+    kPathRxPackets,
+    kPathRxCopied,
+    kPathRxReplaced,
+    kPathRxSpareUsed,
+    kPathRxNoBuffer,
+    kPathTxCalls,
+    kPathTxPackets,
+    kPathTxDescs,
+    kPathTxTailWrites,
+    kPathTxRingFull,
+    kPathTxCoalesceFail,
+    kPathIntrTotal,
+    kPathIntrRxOK,
+    kPathIntrRxDescUnavail,
+    kPathIntrRxFIFOOver,
+    kPathIntrTxOK,
+    kPathIntrTimer,
+    kPathIntrLinkChg,
+    kPathIntrSYSErr,
+    kPathCount
+};
+
+/* Contexts updating the data path counters. */
+enum RtlPathContext {
+    kPathContextRx = 0,     /* rxInterrupt(), interrupt handler or poll thread */
+    kPathContextTx,         /* outputStart(), output thread */
+    kPathContextIntr,       /* interruptHandler(), workloop */
+    kPathContextCount
+};
+
+/*
+ * Each context has a block of its own, so that the counters can be
+ * incremented without atomic operations. The blocks are padded to a
+ * cache line and allocated with IOMallocAligned(), as operator new
+ * doesn't guarantee the alignment of the driver object, to keep the
+ * contexts from sharing cache lines. Note that the blocks are per
+ * context, not per CPU.
+ */
+typedef struct RtlPathCounters {
+    UInt64 count[kPathCount];
+} __attribute__((aligned(64))) RtlPathCounters;
+
+/* Events recorded in the trace ring. */
+enum RtlTraceEvent {
+    kTraceIntr = 0,         /* arg0: ISR0, arg1: intrMask */
+    kTraceIntrMask,         /* arg0: IMR0 written */
+    kTracePollMode,         /* arg0: enabled, arg1: intrMask */
+    kTraceRx,               /* arg0: rxNextDescIndex, arg1: packets */
+    kTraceTxTail,           /* arg0: tail pointer, arg1: txNumFreeDesc */
+    kTraceTxClose,          /* arg0: close pointer, arg1: descriptors done */
+    kTraceTxHang,           /* arg0: close pointer, arg1: tail pointer */
+    kTracePciError,         /* arg0: command, arg1: status register */
+    kTraceRecovery,         /* arg0: tier */
+    kTraceRecoveryDone,     /* arg0: tier, arg1: outage in µs */
+    kTraceEventCount
+};
+
+/*
+ * One entry of the trace ring, time in absolute time units. seq holds
+ * the entry's claim number plus one. It's cleared before the payload
+ * is written and set afterwards, so that snapshotTrace() can tell if
+ * the entry is complete.
+ */
+typedef struct RtlTraceEntry {
+    UInt64 time;
+    UInt32 seq;
+    UInt16 event;
+    UInt16 reserved;
+    UInt32 arg0;
+    UInt32 arg1;
+} RtlTraceEntry;
+
+/*
+ * Latency histograms in absolute time units with log-linear buckets:
+ * each power of 2 is split into kLatSubBuckets linear buckets. Values
+ * of 2^kLatMaxBits or more end up in the last bucket.
+ */
+#define kLatSubBits     3
+#define kLatSubBuckets  (1 << kLatSubBits)
+#define kLatMaxBits     40
+#define kLatBucketCount ((kLatMaxBits - kLatSubBits + 1) * kLatSubBuckets)
+
+enum RtlLatPath {
+    kLatPathRx = 0,     /* descriptor seen until passed to the stack */
+    kLatPathTx,         /* outputStart() until the descriptor is reclaimed */
+    kLatPathCount
+};
+
+enum RtlLatValue {
+    kLatSamples = 0,
+    kLatP50,
+    kLatP99,
+    kLatP999,
+    kLatValueCount
+};
+
+typedef struct RtlLatHist {
+    UInt64 samples;
+    UInt32 bucket[kLatBucketCount];
+} RtlLatHist;
+
 #define kTransmitQueueCapacity  1024
 
 /* With up to 40 segments we should be on the save side. */
@@ -182,6 +441,7 @@ typedef struct RtlStatData {
 #define kRxDescMask    (kNumRxDesc - 1)
 #define kTxDescSize    (kNumTxDesc*sizeof(struct RtlTxDesc))
 #define kRxDescSize    (kNumRxDesc*sizeof(struct RtlRxDesc))
+#define kRxDescSizeV3  (kNumRxDesc*sizeof(struct RtlRxDescV3))
 #define kRxBufArraySize (kNumRxDesc * sizeof(mbuf_t))
 #define kTxBufArraySize (kNumTxDesc * sizeof(mbuf_t))
 
@@ -196,6 +456,9 @@ typedef struct RtlStatData {
 /* statitics timer period in ms. */
 #define kTimeoutMS 1000
 
+/* statistics page update period in ms. */
+#define kStatsPageMS 100
+
 /* Treshhold value to wake a stalled queue */
 #define kTxQueueWakeTreshhold (kNumTxDesc / 10)
 
@@ -203,9 +466,84 @@ typedef struct RtlStatData {
 #define kTxDeadlockTreshhold 6
 #define kTxCheckTreshhold (kTxDeadlockTreshhold - 1)
 
+/* tx stall detector check interval and minimum timeout in ms. */
+#define kTxStallCheckMS 10
+#define kTxStallMinMS 20
+
+/* Largest burst the transmitter may be busy with (one TSO packet) in bytes. */
+#define kTxStallMaxBurst 65536
+
+/* Longest pause a link partner may request with one pause frame in bit times. */
+#define kTxStallMaxPause (0xffff * 512)
+
+/* Number of timed stages in enableRTL8125(). */
+#define kEnableStageCount 8
+
+/* The first stages of enableRTL8125() which bringUpRTL8125() performs. */
+#define kBringUpStageCount 6
+
+/* Number of phase markers kept, must be a power of 2. */
+#define kPhaseRingSize 64
+
+/* Number of trace entries kept, must be a power of 2. */
+#define kTraceRingSize 512
+
+/*
+ * Buffer for the frames posted by the self test and the packet
+ * generator, one slot per template frame.
+ */
+#define kGenBufSize     16384
+#define kGenSlotSize    2048
+
+/* Self test frames: local experimental ethertype and a magic. */
+#define kSelfTestEtherType  0x88B5
+#define kSelfTestMagic      0x4C554359
+#define kSelfTestMaxTimeout 60000
+
+/* Tx descriptors the packet generator leaves to normal traffic. */
+#define kPktGenReserve  (kNumTxDesc / 4)
+
+/* Interval in which the packet generator kicks the output thread. */
+#define kPktGenTickMS   1
+
+/* User queue: header page, slot page and the packet buffers. */
+#define kUserQueueSlotOffset    PAGE_SIZE
+#define kUserQueueBufOffset     (2 * PAGE_SIZE)
+#define kUserQueueSize          (kUserQueueBufOffset + (kRtlUserQueueBufs * kRtlUserQueueBufSize))
+#define kUserQueuePages         ((kRtlUserQueueBufs * kRtlUserQueueBufSize) / PAGE_SIZE)
+#define kUserTxDescSize         (kRtlUserQueueSlots * sizeof(RtlTxDesc))
+
+/* Producer state of a capture ring, kept out of the shared area. */
+typedef struct RtlCaptureState {
+    UInt32 block;
+    UInt32 offset;
+    UInt32 numPackets;
+    UInt32 reserved;
+    UInt64 firstTime;
+    UInt64 lastTime;
+    UInt64 seq;
+} RtlCaptureState;
+
 /* MSS value position */
 #define MSSShift_8125 18
 
+/* Registers of the second tx queue. */
+#define SW_TAIL_PTR1_8125   0x2804
+#define HW_CLO_PTR1_8125    0x2806
+
+/*
+ * MAC OCP registers with the time stamp of the last PTP event message
+ * sent: 30 bits of ns and 48 bits of seconds. They aren't part of the
+ * reference driver, the addresses are those of Realtek's later r8125
+ * releases.
+ */
+#define PTP_EGRESS_TIME_BASE_NS_8125    0xCF20
+#define PTP_EGRESS_TIME_BASE_S_8125     0xCF24
+
+/* Poll interval and timeout of a pending PTP tx time stamp in ms. */
+#define kPtpTxPollMS        1
+#define kPtpTxTimeoutMS     100
+
 /* This definitions should have been in IOPCIDevice.h. */
 enum
 {
@@ -248,14 +586,22 @@ enum
 #define kNameLenght 64
 
 #define kEnableRxPollName "rxPolling"
+#define kRxLatencyName "rxLatencyHistogram"
+#define kTxLatencyName "txLatencyHistogram"
 
 extern const struct RTLChipInfo rtl_chip_info[];
+extern const struct RtlStatCounter statCounters[kStatCount];
+extern const char *pathCounterNames[kPathCount];
+extern const char *latPathNames[kLatPathCount];
+extern const char *latValueNames[kLatValueCount];
 
 class LucyRTL8125 : public super
 {
     
     OSDeclareDefaultStructors(LucyRTL8125)
     
+    friend class LucyRTL8125UserClient;
+    
 public:
     /* IOService (or its superclass) methods. */
     virtual bool start(IOService *provider) override;
@@ -319,28 +665,108 @@ private:
     bool setupRxResources();
     bool setupTxResources();
     bool setupStatResources();
+    bool setupGenResources();
     void freeRxResources();
     void freeTxResources();
     void freeStatResources();
+    void freeGenResources();
     void refillSpareBuffers();
     
     static IOReturn refillAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4);
+    static void bringUpThread(thread_call_param_t param0, thread_call_param_t param1);
 
     void clearRxTxRings();
+    void syncRxTxRings();
     void checkLinkStatus();
     void updateStatitics();
+    void accumulateStatistics();
+    bool dumpStatistics();
+    void saveStatistics();
+    void updatePathStatistics();
+    void addLatencySample(UInt32 path, UInt64 latency);
+    void rxLatencyDone(UInt32 packets);
+    void updateLatencyStatistics();
+    void updateStatsPage();
+    IOReturn dumpState(UInt32 type, void *buffer, UInt32 *size);
+    static IOReturn dumpAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4);
+    IOReturn dumpStateGated(UInt32 type, void *buffer, UInt32 *size);
+    IOReturn ptpRequest(UInt32 request, UInt64 *values);
+    static IOReturn ptpAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4);
+    IOReturn ptpRequestGated(UInt32 request, UInt64 *values);
+    IOReturn ptpGetStamps(RtlPtpStampBuffer *buffer);
+    void ptpQueueStamp(RtlPtpStamp *stamp, UInt64 hwTime);
+    void ptpTxFrame(mbuf_t m);
+    bool setupPtpResources();
+    void freePtpResources();
+    IOReturn runSelfTest(const RtlSelfTestParams *params, RtlSelfTestResult *res);
+    static IOReturn selfTestAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4);
+    IOReturn selfTestStart(UInt32 frameSize);
+    void selfTestStop();
+    bool selfTestReceive(mbuf_t m, UInt32 size);
+    UInt32 genPostFrames(UInt64 addr, UInt32 size, UInt32 count, UInt32 slots, UInt32 *slot);
+    IOReturn pktGenRequest(UInt32 request, const RtlPktGenParams *params, RtlPktGenStatus *status);
+    static IOReturn pktGenAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4);
+    IOReturn pktGenStart(const RtlPktGenParams *params);
+    void pktGenStop();
+    void pktGenGetStatus(RtlPktGenStatus *status);
+    void pktGenBuildFrame(UInt8 *p, UInt32 flow);
+    void pktGenPost();
+    void releaseClient(OSObject *client);
+    static IOReturn releaseClientAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4);
+    IOReturn captureRequest(OSObject *client, UInt32 request, const UInt64 *values);
+    static IOReturn captureAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4);
+    IOReturn captureStart(OSObject *client, UInt32 snapLen, UInt32 blockSize, UInt32 blockCount);
+    void captureStop();
+    IOMemoryDescriptor *copyCaptureMemory();
+    void captureFrame(UInt32 ring, mbuf_t m, UInt32 len, UInt32 status, UInt16 vlanTag);
+    inline RtlCaptureBlock *captureBlock(UInt32 ring, UInt32 index);
+    void captureRetire(UInt32 ring);
+    void captureFlush();
+    bool setupCaptureResources();
+    void freeCaptureResources();
+    IOReturn userQueueRequest(OSObject *client, UInt32 request, UInt32 etherType);
+    static IOReturn userQueueAction(OSObject *owner, void *arg1, void *arg2, void *arg3, void *arg4);
+    IOReturn userQueueStart(OSObject *client, UInt32 etherType);
+    void userQueueStop();
+    IOReturn userQueueTxSync();
+    bool userQueueReceive(mbuf_t m, UInt32 size);
+    void clearUserQueue();
+    IOMemoryDescriptor *copyUserQueueMemory();
+    bool setupUserQueueResources();
+    void freeUserQueueResources();
+    bool setupUserQueueArea();
+    void freeUserQueueArea();
     void setLinkUp();
     void setLinkDown();
     bool txHangCheck();
+    bool recoverRTL8125(UInt32 tier);
+    void recoveryDone(UInt32 tier);
+    void setTxStallTimeout();
+    void markPhase(UInt32 phase, UInt64 time = 0);
+    void publishPhaseMarkers();
+    void traceEvent(UInt32 event, UInt32 arg0 = 0, UInt32 arg1 = 0);
+    void snapshotTrace(UInt32 event);
 
     /* Hardware initialization methods. */
     IOReturn identifyChip();
     bool initRTL8125();
     void enableRTL8125();
+    void bringUpRTL8125();
+    void waitForBringUp();
     void disableRTL8125();
     void setupRTL8125();
+    void setupLinkRTL8125();
     void setOffset79(UInt8 setting);
     void restartRTL8125();
+    void resetQueuesRTL8125();
+    void resetMacRTL8125();
+    void stopRxTxRTL8125();
+    void enablePtpRTL8125();
+    void ptpGetTime(UInt64 *sec, UInt32 *ns);
+    void ptpSetTime(UInt64 sec, UInt32 ns);
+    UInt64 ptpHwTime();
+    UInt64 ptpEgressTime();
+    void ptpSaveTime();
     void setPhyMedium();
     UInt8 csiFun0ReadByte(UInt32 addr);
     void csiFun0WriteByte(UInt32 addr, UInt8 value);
@@ -353,16 +779,27 @@ private:
     void exitOOB();
     void powerDownPLL();
     void configPhyHardware();
+    bool phyConfigIntact();
     void configPhyHardware8125a1();
     void configPhyHardware8125a2();
     void configPhyHardware8125b1();
     void configPhyHardware8125b2();
 
     /* Descriptor related methods. */
-    inline void getChecksumResult(mbuf_t m, UInt32 status1, UInt32 status2);
+    inline void getChecksumResult(mbuf_t m, UInt32 index);
+    inline UInt32 *rxDescOpts1(UInt32 index);
+    inline UInt32 *rxDescOpts2(UInt32 index);
+    inline UInt64 *rxDescAddr(UInt32 index);
+    void rearmRxDesc(UInt32 index);
+    inline void countInterruptCauses(UInt32 status);
     
     /* Watchdog timer method. */
     void timerActionRTL8125(IOTimerEventSource *timer);
+    void txStallAction(IOTimerEventSource *timer);
+    void pktGenTimerAction(IOTimerEventSource *timer);
+    void captureTimerAction(IOTimerEventSource *timer);
+    void ptpTxTimerAction(IOTimerEventSource *timer);
+    void statsPageTimerAction(IOTimerEventSource *timer);
 
 private:
     IOWorkLoop *workLoop;
@@ -374,6 +811,13 @@ private:
     
     IOInterruptEventSource *interruptSource;
     IOTimerEventSource *timerSource;
+    IOTimerEventSource *txStallSource;
+    IOTimerEventSource *pktGenSource;
+    IOTimerEventSource *captureSource;
+    IOTimerEventSource *statsPageSource;
+    IOTimerEventSource *ptpTxSource;
+    IOLock *bringUpLock;
+    thread_call_t bringUpCall;
     IOEthernetInterface *netif;
     IOMemoryMap *baseMap;
     IOMapper *mapper;
@@ -394,12 +838,16 @@ private:
     UInt32 txTailPtr0;
     UInt32 txClosePtr0;
     SInt32 txNumFreeDesc;
+    UInt32 txStallClosePtr;
+    UInt64 txStallStamp;
+    UInt64 txStallPauses;
+    UInt64 txStallTimeout;
 
     /* receiver data */
     IOBufferMemoryDescriptor *rxBufDesc;
     IOPhysicalAddress64 rxPhyAddr;
     IODMACommand *rxDescDmaCmd;
-    struct RtlRxDesc *rxDescArray;
+    void *rxDescArray;
     IOMbufNaturalMemoryCursor *rxMbufCursor;
     mbuf_t *rxMbufArray;
     void *rxBufArrayMem;
@@ -411,6 +859,7 @@ private:
     UInt32 rxConfigReg;
     UInt32 rxConfigMask;
     SInt32 spareNum;
+    bool rxDescV3;
 
     /* power management data */
     unsigned long powerState;
@@ -419,12 +868,105 @@ private:
 
     /* statistics data */
     UInt32 deadlockWarn;
+    UInt32 recoveryTier;
+    UInt64 recoveryStart;
+    RtlRecoveryStat recoveryStats[kRecoveryTierCount];
     IONetworkStats *netStats;
     IOEthernetStats *etherStats;
     IOBufferMemoryDescriptor *statBufDesc;
     IOPhysicalAddress64 statPhyAddr;
     IODMACommand *statDescDmaCmd;
     struct RtlStatData *statData;
+    UInt32 statCount;
+    UInt64 statTotals[kStatCount];
+    UInt64 statLast[kStatCount];
+    OSDictionary *statDict;
+    OSNumber *statNums[kStatCount];
+    RtlPathCounters *pathCounters;
+    OSDictionary *pathDict;
+    OSNumber *pathNums[kPathCount];
+    RtlLatHist latHist[kLatPathCount];
+    UInt64 rxLatStamp[kNumRxDesc];
+    UInt64 txLatStamp[kNumTxDesc];
+    OSDictionary *latDict;
+    OSNumber *latNums[kLatPathCount][kLatValueCount];
+    IOBufferMemoryDescriptor *statsPageDesc;
+    RtlStatsPage *statsPage;
+
+    /* self test data */
+    IOBufferMemoryDescriptor *genBufDesc;
+    IODMACommand *genDmaCmd;
+    UInt8 *genBuf;
+    IOPhysicalAddress64 genPhyAddr;
+    UInt32 selfTestSize;
+    UInt64 selfTestRxFrames;
+    UInt64 selfTestRxErrors;
+    UInt64 selfTestRxBusy;
+
+    /* packet generator data */
+    RtlPktGenParams pktGenParams;
+    UInt64 pktGenSent;
+    UInt64 pktGenDropped;
+    UInt64 pktGenRingFull;
+    UInt64 pktGenCredit;
+    UInt64 pktGenStamp;
+    UInt64 pktGenStartTime;
+    UInt64 pktGenStopTime;
+    UInt32 pktGenSlot;
+
+    /* capture ring data */
+    IOBufferMemoryDescriptor *captureDesc;
+    RtlCaptureHeader *captureHdr;
+    OSObject *captureOwner;
+    IOSimpleLock *captureLock[kRtlCaptureRingCount];
+    RtlCaptureState captureState[kRtlCaptureRingCount];
+    UInt32 captureSnapLen;
+    UInt32 captureBlockSize;
+    UInt32 captureBlockCount;
+
+    /* user queue data */
+    IOBufferMemoryDescriptor *userQueueDesc;
+    IODMACommand *userQueueDmaCmd;
+    IOBufferMemoryDescriptor *userTxBufDesc;
+    IODMACommand *userTxDmaCmd;
+    RtlUserQueueHeader *userQueueHdr;
+    OSObject *userQueueOwner;
+    RtlUserSlot *userQueueSlots[kRtlUserQueueRingCount];
+    UInt8 *userQueueBufs;
+    RtlTxDesc *userTxDescArray;
+    IOPhysicalAddress64 userTxPhyAddr;
+    UInt64 userQueuePages[kUserQueuePages];
+    IOSimpleLock *userQueueLock;
+    UInt32 userTxNextIndex;
+    UInt32 userTxTail;
+    UInt32 userTxDescIndex;
+    UInt32 userTxTailPtr;
+    UInt32 userTxClosePtr;
+    UInt32 userRxTail;
+    UInt32 userRxEtherType;
+
+    /* PTP clock data */
+    IOSimpleLock *ptpLock;
+    RtlPtpClock ptpClock;
+    RtlPtpStamp ptpStamps[kRtlPtpMaxStamps];
+    UInt32 ptpStampHead;
+    UInt32 ptpStampCount;
+    UInt32 ptpStampDrops;
+    UInt32 ptpTxSkipped;
+    UInt32 ptpTxTimeouts;
+    RtlPtpStamp ptpTxStamp;
+    UInt64 ptpTxStart;
+    UInt64 ptpSavedTime;
+    UInt64 ptpSavedStamp;
+    volatile bool ptpTxPending;
+    bool ptpStampEnable;
+    bool ptpStarted;
+
+    UInt64 enableStageTime[kEnableStageCount];
+    RtlPhaseMarker phaseRing[kPhaseRingSize];
+    SInt32 phaseCount;
+    RtlTraceEntry traceRing[kTraceRingSize];
+    SInt32 traceCount;
 
     UInt32 mtu;
     UInt32 speed;
@@ -449,11 +991,15 @@ private:
     UInt32 stateFlags;
     
     bool needsUpdate;
+    bool phyConfigured;
+    bool bringUpPending;
+    bool bringUpDone;
     bool wolCapable;
     bool wolActive;
     bool enableTSO4;
     bool enableTSO6;
     bool enableCSO6;
+    bool latEnable[kLatPathCount];
     
 #ifdef DEBUG
     UInt32 tmrInterrupts;
@@ -462,3 +1008,19 @@ private:
     UInt32 lastTmrIntrupts;
 #endif
 };
+
+/* Fields of Rx descriptor index in the format chosen by initRTL8125(). */
+inline UInt32 *LucyRTL8125::rxDescOpts1(UInt32 index)
+{
+    return rxDescV3 ? &((RtlRxDescV3 *)rxDescArray)[index].opts1 : &((RtlRxDesc *)rxDescArray)[index].opts1;
+}
+
+inline UInt32 *LucyRTL8125::rxDescOpts2(UInt32 index)
+{
+    return rxDescV3 ? &((RtlRxDescV3 *)rxDescArray)[index].opts2 : &((RtlRxDesc *)rxDescArray)[index].opts2;
+}
+
+inline UInt64 *LucyRTL8125::rxDescAddr(UInt32 index)
+{
+    return rxDescV3 ? &((RtlRxDescV3 *)rxDescArray)[index].addr : &((RtlRxDesc *)rxDescArray)[index].addr;
+}
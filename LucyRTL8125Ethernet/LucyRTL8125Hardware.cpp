@@ -203,6 +203,7 @@ bool LucyRTL8125::initRTL8125()
         IOLog("Unsupported chip found. Aborting...\n");
         goto done;
     }
+    markPhase(kPhaseIdentifyChip);
     
     /* Setup EEE support. */
     tp->eee_adv_t = eeeCap = (MDIO_EEE_100TX | MDIO_EEE_1000T);
@@ -488,6 +489,12 @@ bool LucyRTL8125::initRTL8125()
     /* Get the RxConfig parameters. */
     rxConfigReg = rtl_chip_info[tp->chipset].RCR_Cfg;
     rxConfigMask = rtl_chip_info[tp->chipset].RxConfigMask;
+    
+    /* Like Realtek's driver, use v3 descriptors to get PTP time stamps. */
+    rxDescV3 = (tp->HwSuppPtpVer > 0);
+    
+    if (rxDescV3)
+        rxConfigReg |= EnableRxDescV3;
   
     /* Reset the tally counter. */
     WriteReg32(CounterAddrHigh, (statPhyAddr >> 32));
@@ -502,30 +509,124 @@ bool LucyRTL8125::initRTL8125()
     
 #endif
     
+    markPhase(kPhaseInit);
     result = true;
     
 done:
     return result;
 }
 
-void LucyRTL8125::enableRTL8125()
+/* Power up the chip and configure EPHY and PHY. This is the part of
+ * enableRTL8125() which doesn't depend on the interface's settings so
+ * that it can be done in advance by bringUpThread().
+ */
+void LucyRTL8125::bringUpRTL8125()
 {
     struct rtl8125_private *tp = &linuxData;
+    UInt64 stamp[kBringUpStageCount + 1];
+    UInt32 i;
+
+    /* The chip may have lost its configuration while it was disabled. */
+    rtl8125_reset_ocp_shadow(tp);
     
-    setLinkStatus(kIONetworkLinkValid);
-    
-    intrMask = intrMaskRxTx;
-    clear_bit(__POLL_MODE, &stateFlags);
-    
+    clock_get_uptime(&stamp[0]);
     exitOOB();
+    clock_get_uptime(&stamp[1]);
+    markPhase(kPhaseExitOOB, stamp[1]);
     rtl8125_hw_init(tp);
+    clock_get_uptime(&stamp[2]);
+    markPhase(kPhaseHwInit, stamp[2]);
     rtl8125_nic_reset(tp);
+    clock_get_uptime(&stamp[3]);
     rtl8125_powerup_pll(tp);
+    clock_get_uptime(&stamp[4]);
     rtl8125_hw_ephy_config(tp);
+    clock_get_uptime(&stamp[5]);
+    markPhase(kPhaseEphy, stamp[5]);
     configPhyHardware();
+    clock_get_uptime(&stamp[6]);
+    markPhase(kPhasePhyConfig, stamp[6]);
+    
+    for (i = 0; i < kBringUpStageCount; i++)
+        enableStageTime[i] = stamp[i + 1] - stamp[i];
+}
+
+void LucyRTL8125::bringUpThread(thread_call_param_t param0, thread_call_param_t param1)
+{
+    LucyRTL8125 *ethCtlr = (LucyRTL8125 *)param0;
+    
+    ethCtlr->bringUpRTL8125();
+    
+    IOLockLock(ethCtlr->bringUpLock);
+    ethCtlr->bringUpDone = true;
+    ethCtlr->bringUpPending = false;
+    IOLockWakeup(ethCtlr->bringUpLock, &ethCtlr->bringUpPending, false);
+    IOLockUnlock(ethCtlr->bringUpLock);
+    
+    DebugLog("Background bring-up complete.\n");
+}
+
+/*
+ * Wait until a pending background bring-up has completed. Must be
+ * called by every entry point which accesses the chip and may be
+ * invoked while bringUpThread() is still running.
+ */
+void LucyRTL8125::waitForBringUp()
+{
+    if (!bringUpLock)
+        return;
+    
+    IOLockLock(bringUpLock);
+    
+    while (bringUpPending)
+        IOLockSleep(bringUpLock, &bringUpPending, THREAD_UNINT);
+    
+    IOLockUnlock(bringUpLock);
+}
+
+void LucyRTL8125::enableRTL8125()
+{
+    UInt64 stamp[3];
+#ifdef DEBUG
+    UInt64 us[kEnableStageCount];
+    UInt32 i;
+#endif
+    
+    setLinkStatus(kIONetworkLinkValid);
+    
+    intrMask = intrMaskRxTx;
+    clear_bit(__POLL_MODE, &stateFlags);
+    
+    /* Skip the bring-up if it has been done in the background. */
+    if (bringUpDone)
+        bringUpDone = false;
+    else
+        bringUpRTL8125();
+    
+    clock_get_uptime(&stamp[0]);
     setupRTL8125();
+    clock_get_uptime(&stamp[1]);
     
     setPhyMedium();
+    clock_get_uptime(&stamp[2]);
+    
+    markPhase(kPhaseSetup, stamp[1]);
+    markPhase(kPhaseMedium, stamp[2]);
+    publishPhaseMarkers();
+    
+    enableStageTime[kBringUpStageCount] = stamp[1] - stamp[0];
+    enableStageTime[kBringUpStageCount + 1] = stamp[2] - stamp[1];
+
+#ifdef DEBUG
+    for (i = 0; i < kEnableStageCount; i++) {
+        absolutetime_to_nanoseconds(enableStageTime[i], &us[i]);
+        us[i] /= 1000;
+    }
+    DebugLog("Enable stages: exitOOB %lluµs, hw_init %lluµs, nic_reset %lluµs, powerup_pll %lluµs, ephy %lluµs, phy %lluµs, setup %lluµs, medium %lluµs.\n",
+             us[0], us[1], us[2], us[3], us[4], us[5], us[6], us[7]);
+    DebugLog("OCP shadow saved %u MAC OCP and %u PHY OCP reads.\n",
+             linuxData.mac_ocp_shadow.hits, linuxData.phy_ocp_shadow.hits);
+#endif
 }
 
 void LucyRTL8125::disableRTL8125()
@@ -534,8 +635,11 @@ void LucyRTL8125::disableRTL8125()
     
     /* Disable all interrupts by clearing the interrupt mask. */
     WriteReg32(IMR0_8125, 0);
+    traceEvent(kTraceIntrMask, 0);
     WriteReg16(IntrStatus, ReadReg16(IntrStatus));
 
+    ptpSaveTime();
+    saveStatistics();
     rtl8125_nic_reset(tp);
     hardwareD3Para();
     powerDownPLL();
@@ -561,6 +665,7 @@ void LucyRTL8125::restartRTL8125()
     setLinkStatus(kIONetworkLinkValid);
     
     /* Reset NIC and cleanup both descriptor rings. */
+    saveStatistics();
     rtl8125_nic_reset(&linuxData);
 /*
     if (rxInterrupt(netif, kNumRxDesc, NULL, NULL))
@@ -572,12 +677,94 @@ void LucyRTL8125::restartRTL8125()
     enableRTL8125();
 }
 
+/* Restart DMA of both rings without resetting the chip, so that the
+ * MAC keeps its configuration. The chip's ring positions can't be
+ * rewound without a reset, therefore syncRxTxRings() moves the
+ * driver's positions to the chip's instead and the tail pointers are
+ * written again. The PHY and the link are not touched at all.
+ */
+void LucyRTL8125::resetQueuesRTL8125()
+{
+    struct rtl8125_private *tp = &linuxData;
+
+    netif->stopOutputThread();
+
+    WriteReg32(IMR0_8125, 0);
+    traceEvent(kTraceIntrMask, 0);
+    WriteReg32(ISR0_8125, ReadReg32(ISR0_8125));
+
+    stopRxTxRTL8125();
+    syncRxTxRings();
+    clear_bit(__POLL_MODE, &stateFlags);
+    intrMask = intrMaskRxTx;
+    
+    WriteReg16(SW_TAIL_PTR0_8125, txTailPtr0 & 0xffff);
+
+    if (test_bit(__USER_QUEUE, &stateFlags))
+        WriteReg16(SW_TAIL_PTR1_8125, userTxTailPtr & 0xffff);
+
+    rtl8125_disable_rxdvgate(tp);
+    WriteReg8(ChipCmd, CmdTxEnb | CmdRxEnb);
+    WriteReg32(IMR0_8125, intrMask);
+    traceEvent(kTraceIntrMask, intrMask);
+    
+    netif->startOutputThread();
+}
+
+/* Stop DMA after the fifos have been drained. In contrast to
+ * rtl8125_nic_reset() the MAC keeps its configuration.
+ */
+void LucyRTL8125::stopRxTxRTL8125()
+{
+    struct rtl8125_private *tp = &linuxData;
+
+    rtl8125_enable_rxdvgate(tp);
+    rtl8125_wait_txrx_fifo_empty(tp);
+    WriteReg8(ChipCmd, 0);
+}
+
+/* Reset and reconfigure the MAC while the PHY keeps the link up so
+ * that there is no need to wait for autonegotiation. Also used to
+ * enable or disable the second tx queue, whose ring positions only a
+ * reset rewinds. Without a link DMA stays stopped.
+ */
+void LucyRTL8125::resetMacRTL8125()
+{
+    bool linkUp = test_bit(__LINK_UP, &stateFlags);
+    
+    netif->stopOutputThread();
+
+    WriteReg32(IMR0_8125, 0);
+    traceEvent(kTraceIntrMask, 0);
+    WriteReg32(ISR0_8125, ReadReg32(ISR0_8125));
+
+    /* setupRTL8125() resets the chip, stopping DMA is enough here. */
+    stopRxTxRTL8125();
+    clearRxTxRings();
+    clear_bit(__POLL_MODE, &stateFlags);
+    intrMask = intrMaskRxTx;
+
+    setupRTL8125();
+    
+    if (linkUp) {
+        setupLinkRTL8125();
+        
+        /* Enable receiver and transmitter. */
+        WriteReg8(ChipCmd, CmdTxEnb | CmdRxEnb);
+
+        netif->startOutputThread();
+    }
+}
+
 void LucyRTL8125::setupRTL8125()
 {
     struct rtl8125_private *tp = &linuxData;
     UInt32 i;
     UInt16 mac_ocp_data;
     
+    ptpSaveTime();
+    saveStatistics();
+    
     WriteReg32(RxConfig, (RX_DMA_BURST << RxCfgDMAShift));
     
     rtl8125_nic_reset(tp);
@@ -642,6 +829,11 @@ void LucyRTL8125::setupRTL8125()
     WriteReg32(RxDescAddrLow, (rxPhyAddr & 0x00000000ffffffff));
     WriteReg32(RxDescAddrHigh, (rxPhyAddr >> 32));
 
+    if (test_bit(__USER_QUEUE, &stateFlags)) {
+        WriteReg32(TNPDS_Q1_LOW_8125, (userTxPhyAddr & 0x00000000ffffffff));
+        WriteReg32(TNPDS_Q1_LOW_8125 + 4, (userTxPhyAddr >> 32));
+    }
+
     /* Set DMA burst size and Interframe Gap Time */
     WriteReg32(TxConfig, (TX_DMA_BURST_unlimited << TxDMAShift) |
             (InterFrameGap << TxInterFrameGapShift));
@@ -690,10 +882,10 @@ void LucyRTL8125::setupRTL8125()
         
         //rtl8125_set_tx_q_num(tp, tp->HwSuppNumTxQueues);
         
-        /* Set tx queue num to one. */
+        /* Set tx queue num to one, the second is only used by the user queue. */
         mac_ocp_data = rtl8125_mac_ocp_read(tp, 0xE63E);
         mac_ocp_data &= ~(BIT_11 | BIT_10);
-        mac_ocp_data |= ((0 & 0x03) << 10);
+        mac_ocp_data |= (((test_bit(__USER_QUEUE, &stateFlags) ? 1 : 0) & 0x03) << 10);
         rtl8125_mac_ocp_write(tp, 0xE63E, mac_ocp_data);
 
         mac_ocp_data = rtl8125_mac_ocp_read(tp, 0xE63E);
@@ -820,12 +1012,12 @@ void LucyRTL8125::setupRTL8125()
         case CFG_METHOD_3:
         case CFG_METHOD_4:
         case CFG_METHOD_5: {
-            int timeout;
-            for (timeout = 0; timeout < 10; timeout++) {
-                if ((rtl8125_mac_ocp_read(tp, 0xE00E) & BIT_13)==0)
-                    break;
-                mdelay(1);
-            }
+            UInt32 waited;
+            
+            if (!poll_backoff_timeout((rtl8125_mac_ocp_read(tp, 0xE00E) & BIT_13) == 0, 10000, waited))
+                DebugLog("Timeout waiting for 0xE00E.\n");
+            
+            DebugLog("Waited %uµs for 0xE00E.\n", waited);
         }
         break;
     }
@@ -862,12 +1054,152 @@ void LucyRTL8125::setupRTL8125()
 
     WriteReg8(Cfg9346, ReadReg8(Cfg9346) & ~Cfg9346_Unlock);
     
+    enablePtpRTL8125();
+    
     /* Enable all known interrupts by setting the interrupt mask. */
     WriteReg32(IMR0_8125, intrMask);
+    traceEvent(kTraceIntrMask, intrMask);
 
     udelay(10);
 }
 
+/* Per link stage of the chip setup. setupRTL8125() has been done once
+ * by enableRTL8125() and the MAC keeps its configuration across link
+ * changes, as setLinkDown() only stops DMA. Open the rx gate and apply
+ * the settings depending on speed and duplex.
+ */
+void LucyRTL8125::setupLinkRTL8125()
+{
+    struct rtl8125_private *tp = &linuxData;
+
+    rtl8125_disable_rxdvgate(tp);
+
+    if (tp->mcfg == CFG_METHOD_2) {
+        if (ReadReg16(PHYstatus) & FullDup)
+            WriteReg32(TxConfig, (ReadReg32(TxConfig) | (BIT_24 | BIT_25)) & ~BIT_19);
+        else
+            WriteReg32(TxConfig, (ReadReg32(TxConfig) | BIT_25) & ~(BIT_19 | BIT_24));
+    }
+
+    if ((tp->mcfg == CFG_METHOD_2 || tp->mcfg == CFG_METHOD_3 ||
+         tp->mcfg == CFG_METHOD_4 || tp->mcfg == CFG_METHOD_5) &&
+        (ReadReg16(PHYstatus) & _10bps))
+            rtl8125_enable_eee_plus(tp);
+}
+
+/* Commands of PTP_TIME_CORRECT_CMD_8125 as used by Realtek's r8125_ptp.c. */
+enum {
+    kPtpCmdSetLocalTime = 0,
+    kPtpCmdAdjustLocalTime,
+    kPtpCmdLatchedLocalTime,
+};
+
+/*
+ * Start the PTP clock of chips which have one. It's set to the calendar
+ * time only the first time. Later on the time saved by ptpSaveTime()
+ * before the chip was reset or powered down is restored, advanced by
+ * the time which has passed in between. The chip's clock is never
+ * adjusted otherwise, it serves as the time base of ptpClock.
+ */
+void LucyRTL8125::enablePtpRTL8125()
+{
+    struct rtl8125_private *tp = &linuxData;
+    clock_sec_t sec;
+    clock_nsec_t ns;
+    UInt64 now, elapsed;
+    UInt16 ptpCtrl;
+    
+    if (!tp->HwSuppPtpVer)
+        return;
+    
+    /* Clear PTP interrupts and use the MAC as the clock's source. */
+    WriteReg8(PTP_ISR_8125, 0xff);
+    rtl8125_mac_ocp_write(tp, 0xDC00, rtl8125_mac_ocp_read(tp, 0xDC00) | BIT_6);
+
+    ptpCtrl = (BIT_0 | BIT_3 | BIT_4 | BIT_6 | BIT_10 | BIT_12);
+    
+    if (tp->ptp_master_mode)
+        ptpCtrl |= BIT_1;
+    
+    WriteReg16(PTP_CTRL_8125, ptpCtrl);
+    
+    if (!ptpStarted) {
+        clock_get_calendar_nanotime(&sec, &ns);
+        ptpSetTime(sec, ns);
+        
+        now = sec * kPtpNsPerSec + ns;
+        ptpClockSet(&ptpClock, now, now);
+        ptpClock.ppb = 0;
+        ptpStarted = true;
+    } else if (ptpSavedTime) {
+        clock_get_uptime(&now);
+        absolutetime_to_nanoseconds(now - ptpSavedStamp, &elapsed);
+        elapsed += ptpSavedTime;
+        ptpSetTime(elapsed / 1000000000ULL, (UInt32)(elapsed % 1000000000ULL));
+    }
+    ptpSavedTime = 0;
+    
+    DebugLog("PTP clock enabled.\n");
+}
+
+/* Save the PTP clock's time before the chip is reset or powered down. */
+void LucyRTL8125::ptpSaveTime()
+{
+    if (!linuxData.HwSuppPtpVer || !ptpStarted || ptpSavedTime)
+        return;
+    
+    ptpSavedTime = ptpHwTime();
+    clock_get_uptime(&ptpSavedStamp);
+}
+
+void LucyRTL8125::ptpGetTime(UInt64 *sec, UInt32 *ns)
+{
+    UInt64 s;
+    
+    WriteReg16(PTP_TIME_CORRECT_CMD_8125, (kPtpCmdLatchedLocalTime | PTP_EXEC_CMD));
+    udelay(1);
+    
+    *ns = ReadReg32(PTP_LOCAL_Time_NS_8125);
+    s = ReadReg16(PTP_LOCAL_Time_S_8125 + 4);
+    *sec = (s << 32) | ReadReg32(PTP_LOCAL_Time_S_8125);
+}
+
+void LucyRTL8125::ptpSetTime(UInt64 sec, UInt32 ns)
+{
+    WriteReg32(PTP_SOFT_CONFIG_Time_NS_8125, ns);
+    WriteReg32(PTP_SOFT_CONFIG_Time_S_8125, (UInt32)sec);
+    WriteReg16(PTP_SOFT_CONFIG_Time_S_8125 + 4, (UInt16)(sec >> 32));
+    WriteReg16(PTP_TIME_CORRECT_CMD_8125, (kPtpCmdSetLocalTime | PTP_EXEC_CMD));
+}
+
+/* The chip's clock in ns, the time base of ptpClock. */
+UInt64 LucyRTL8125::ptpHwTime()
+{
+    UInt64 sec;
+    UInt32 ns;
+    
+    ptpGetTime(&sec, &ns);
+        
+    return sec * kPtpNsPerSec + ns;
+}
+        
+/* Time stamp of the last event message sent, valid after PTP_ISR_TOK. */
+UInt64 LucyRTL8125::ptpEgressTime()
+{
+    struct rtl8125_private *tp = &linuxData;
+    UInt64 sec;
+    UInt32 ns;
+        
+    ns = (rtl8125_mac_ocp_read(tp, PTP_EGRESS_TIME_BASE_NS_8125 + 2) & 0x3fff) << 16;
+    ns |= rtl8125_mac_ocp_read(tp, PTP_EGRESS_TIME_BASE_NS_8125);
+    
+    sec = rtl8125_mac_ocp_read(tp, PTP_EGRESS_TIME_BASE_S_8125 + 4);
+    sec = (sec << 16) | rtl8125_mac_ocp_read(tp, PTP_EGRESS_TIME_BASE_S_8125 + 2);
+    sec = (sec << 16) | rtl8125_mac_ocp_read(tp, PTP_EGRESS_TIME_BASE_S_8125);
+    
+    return sec * kPtpNsPerSec + ns;
+}
+
 void LucyRTL8125::setPhyMedium()
 {
     struct rtl8125_private *tp = netdev_priv(&linuxData);
@@ -1341,12 +1673,50 @@ void LucyRTL8125::powerDownPLL()
         }
 }
 
+/*
+ * The PHY keeps its MCU ram code and parameters as long as it stays
+ * powered. In case we configured it before, it has completed UPS
+ * resume and still reports our ram code version, both the patch and
+ * the parameter tables can be skipped.
+ */
+bool LucyRTL8125::phyConfigIntact()
+{
+    struct rtl8125_private *tp = &linuxData;
+    bool result = false;
+    
+    if (!phyConfigured)
+        goto done;
+    
+    switch (tp->mcfg) {
+        case CFG_METHOD_2:
+        case CFG_METHOD_3:
+        case CFG_METHOD_4:
+        case CFG_METHOD_5:
+            /* PHY state 3 is LAN on. */
+            if (rtl8125_is_ups_resume(tp) ||
+                ((mdio_direct_read_phy_ocp(tp, 0xA420) & 0x7) != 3))
+                break;
+            
+            result = rtl8125_check_hw_phy_mcu_code_ver(tp);
+            break;
+    }
+    
+done:
+    return result;
+}
+
 void LucyRTL8125::configPhyHardware()
 {
     struct rtl8125_private *tp = &linuxData;
 
     if (tp->resume_not_chg_speed) return;
     
+    if (phyConfigIntact()) {
+        DebugLog("PHY ram code 0x%04x intact, skip PHY configuration.\n", tp->hw_ram_code_ver);
+        goto common;
+    }
+    phyConfigured = false;
+    
     tp->phy_reset_enable(tp);
     
     if (HW_DASH_SUPPORT_TYPE_3(tp) && tp->HwPkgDet == 0x06) return;
@@ -1354,6 +1724,10 @@ void LucyRTL8125::configPhyHardware()
     rtl8125_set_hw_phy_before_init_phy_mcu(tp);
     
     rtl8125_init_hw_phy_mcu(tp);
+    markPhase(kPhasePhyPatch);
+    
+    /* The PHY MCU patch may have changed any PHY register. */
+    rtl8125_invalidate_ocp_shadow(&tp->phy_ocp_shadow);
     
     switch (tp->mcfg) {
         case CFG_METHOD_2:
@@ -1369,6 +1743,9 @@ void LucyRTL8125::configPhyHardware()
             configPhyHardware8125b2();
             break;
     }
+    phyConfigured = HW_HAS_WRITE_PHY_MCU_RAM_CODE(tp);
+    
+common:
     
     //legacy force mode(Chap 22)
     switch (tp->mcfg) {
@@ -1401,129 +1778,65 @@ void LucyRTL8125::configPhyHardware()
     }
 }
 
+static const struct rtl8125_phy_cfg phy_cfg_8125a_1[] = {
+    PHY_CFG_CLEAR_SET(0xAD40, 0x03FF, 0x84),
+
+    PHY_CFG_SET(0xAD4E, BIT_4),
+    PHY_CFG_CLEAR_SET(0xAD16, 0x03FF, 0x0006),
+    PHY_CFG_CLEAR_SET(0xAD32, 0x003F, 0x0006),
+    PHY_CFG_CLEAR(0xAC08, BIT_12),
+    PHY_CFG_CLEAR(0xAC08, BIT_8),
+    PHY_CFG_CLEAR_SET(0xAC8A, BIT_15|BIT_14|BIT_13|BIT_12, BIT_14|BIT_13|BIT_12),
+    PHY_CFG_SET(0xAD18, BIT_10),
+    PHY_CFG_SET(0xAD1A, 0x3FF),
+    PHY_CFG_SET(0xAD1C, 0x3FF),
+
+    PHY_CFG_WRITE(0xA436, 0x80EA),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0xC400),
+    PHY_CFG_WRITE(0xA436, 0x80EB),
+    PHY_CFG_CLEAR_SET(0xA438, 0x0700, 0x0300),
+    PHY_CFG_WRITE(0xA436, 0x80F8),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x1C00),
+    PHY_CFG_WRITE(0xA436, 0x80F1),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x3000),
+
+    PHY_CFG_WRITE(0xA436, 0x80FE),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0xA500),
+    PHY_CFG_WRITE(0xA436, 0x8102),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x5000),
+    PHY_CFG_WRITE(0xA436, 0x8105),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x3300),
+    PHY_CFG_WRITE(0xA436, 0x8100),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x7000),
+    PHY_CFG_WRITE(0xA436, 0x8104),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0xF000),
+    PHY_CFG_WRITE(0xA436, 0x8106),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x6500),
+    PHY_CFG_WRITE(0xA436, 0x80DC),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0xED00),
+    PHY_CFG_WRITE(0xA436, 0x80DF),
+    PHY_CFG_SET(0xA438, BIT_8),
+    PHY_CFG_WRITE(0xA436, 0x80E1),
+    PHY_CFG_CLEAR(0xA438, BIT_8),
+
+    PHY_CFG_CLEAR_SET(0xBF06, 0x003F, 0x38),
+
+    PHY_CFG_WRITE(0xA436, 0x819F),
+    PHY_CFG_WRITE(0xA438, 0xD0B6),
+
+    PHY_CFG_WRITE(0xBC34, 0x5555),
+    PHY_CFG_CLEAR_SET(0xBF0A, BIT_11|BIT_10|BIT_9, BIT_11|BIT_9),
+
+    PHY_CFG_CLEAR(0xA5C0, BIT_10),
+
+    PHY_CFG_SET(0xA442, BIT_11),
+};
+
 void LucyRTL8125::configPhyHardware8125a1()
 {
     struct rtl8125_private *tp = &linuxData;
-
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAD40,
-                            0x03FF,
-                            0x84
-                            );
-    
-    SetEthPhyOcpBit(tp, 0xAD4E, BIT_4);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAD16,
-                            0x03FF,
-                            0x0006
-                            );
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAD32,
-                            0x003F,
-                            0x0006
-                            );
-    ClearEthPhyOcpBit(tp, 0xAC08, BIT_12);
-    ClearEthPhyOcpBit(tp, 0xAC08, BIT_8);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAC8A,
-                            BIT_15|BIT_14|BIT_13|BIT_12,
-                            BIT_14|BIT_13|BIT_12
-                            );
-    SetEthPhyOcpBit(tp, 0xAD18, BIT_10);
-    SetEthPhyOcpBit(tp, 0xAD1A, 0x3FF);
-    SetEthPhyOcpBit(tp, 0xAD1C, 0x3FF);
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80EA);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0xC400
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80EB);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0x0700,
-                            0x0300
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80F8);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x1C00
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80F1);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x3000
-                            );
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80FE);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0xA500
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x8102);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x5000
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x8105);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x3300
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x8100);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x7000
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x8104);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0xF000
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x8106);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x6500
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80DC);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0xED00
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80DF);
-    SetEthPhyOcpBit(tp, 0xA438, BIT_8);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80E1);
-    ClearEthPhyOcpBit(tp, 0xA438, BIT_8);
-    
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xBF06,
-                            0x003F,
-                            0x38
-                            );
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x819F);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xD0B6);
-    
-    mdio_direct_write_phy_ocp(tp, 0xBC34, 0x5555);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xBF0A,
-                            BIT_11|BIT_10|BIT_9,
-                            BIT_11|BIT_9
-                            );
-    
-    ClearEthPhyOcpBit(tp, 0xA5C0, BIT_10);
-    
-    SetEthPhyOcpBit(tp, 0xA442, BIT_11);
+    
+    rtl8125_apply_phy_cfg_table(tp, phy_cfg_8125a_1, ARRAY_SIZE(phy_cfg_8125a_1));
     
     //enable aldps
     //GPHY OCP 0xA430 bit[2] = 0x1 (en_aldps)
@@ -1534,204 +1847,159 @@ void LucyRTL8125::configPhyHardware8125a1()
     }
 }
 
+static const struct rtl8125_phy_cfg phy_cfg_8125a_2[] = {
+    PHY_CFG_SET(0xAD4E, BIT_4),
+    PHY_CFG_CLEAR_SET(0xAD16, 0x03FF, 0x03FF),
+    PHY_CFG_CLEAR_SET(0xAD32, 0x003F, 0x0006),
+    PHY_CFG_CLEAR(0xAC08, BIT_12),
+    PHY_CFG_CLEAR(0xAC08, BIT_8),
+    PHY_CFG_CLEAR_SET(0xACC0, BIT_1|BIT_0, BIT_1),
+    PHY_CFG_CLEAR_SET(0xAD40, BIT_7|BIT_6|BIT_5, BIT_6),
+    PHY_CFG_CLEAR_SET(0xAD40, BIT_2|BIT_1|BIT_0, BIT_2),
+    PHY_CFG_CLEAR(0xAC14, BIT_7),
+    PHY_CFG_CLEAR(0xAC80, BIT_9|BIT_8),
+    PHY_CFG_CLEAR_SET(0xAC5E, BIT_2|BIT_1|BIT_0, BIT_1),
+    PHY_CFG_WRITE(0xAD4C, 0x00A8),
+    PHY_CFG_WRITE(0xAC5C, 0x01FF),
+    PHY_CFG_CLEAR_SET(0xAC8A, BIT_7|BIT_6|BIT_5|BIT_4, BIT_5|BIT_4),
+    PHY_CFG_WRITE(0xB87C, 0x8157),
+    PHY_CFG_CLEAR_SET(0xB87E, 0xFF00, 0x0500),
+    PHY_CFG_WRITE(0xB87C, 0x8159),
+    PHY_CFG_CLEAR_SET(0xB87E, 0xFF00, 0x0700),
+
+    PHY_CFG_WRITE(0xB87C, 0x80A2),
+    PHY_CFG_WRITE(0xB87E, 0x0153),
+    PHY_CFG_WRITE(0xB87C, 0x809C),
+    PHY_CFG_WRITE(0xB87E, 0x0153),
+
+    PHY_CFG_WRITE(0xA436, 0x81B3),
+    PHY_CFG_WRITE(0xA438, 0x0043),
+    PHY_CFG_WRITE(0xA438, 0x00A7),
+    PHY_CFG_WRITE(0xA438, 0x00D6),
+    PHY_CFG_WRITE(0xA438, 0x00EC),
+    PHY_CFG_WRITE(0xA438, 0x00F6),
+    PHY_CFG_WRITE(0xA438, 0x00FB),
+    PHY_CFG_WRITE(0xA438, 0x00FD),
+    PHY_CFG_WRITE(0xA438, 0x00FF),
+    PHY_CFG_WRITE(0xA438, 0x00BB),
+    PHY_CFG_WRITE(0xA438, 0x0058),
+    PHY_CFG_WRITE(0xA438, 0x0029),
+    PHY_CFG_WRITE(0xA438, 0x0013),
+    PHY_CFG_WRITE(0xA438, 0x0009),
+    PHY_CFG_WRITE(0xA438, 0x0004),
+    PHY_CFG_WRITE(0xA438, 0x0002),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+    PHY_CFG_WRITE(0xA438, 0x0000),
+
+    PHY_CFG_WRITE(0xA436, 0x8257),
+    PHY_CFG_WRITE(0xA438, 0x020F),
+
+    PHY_CFG_WRITE(0xA436, 0x80EA),
+    PHY_CFG_WRITE(0xA438, 0x7843),
+
+    PHY_CFG_MCU_PATCH_REQUEST(),
+
+    PHY_CFG_CLEAR(0xB896, BIT_0),
+    PHY_CFG_CLEAR(0xB892, 0xFF00),
+
+    PHY_CFG_WRITE(0xB88E, 0xC091),
+    PHY_CFG_WRITE(0xB890, 0x6E12),
+    PHY_CFG_WRITE(0xB88E, 0xC092),
+    PHY_CFG_WRITE(0xB890, 0x1214),
+    PHY_CFG_WRITE(0xB88E, 0xC094),
+    PHY_CFG_WRITE(0xB890, 0x1516),
+    PHY_CFG_WRITE(0xB88E, 0xC096),
+    PHY_CFG_WRITE(0xB890, 0x171B),
+    PHY_CFG_WRITE(0xB88E, 0xC098),
+    PHY_CFG_WRITE(0xB890, 0x1B1C),
+    PHY_CFG_WRITE(0xB88E, 0xC09A),
+    PHY_CFG_WRITE(0xB890, 0x1F1F),
+    PHY_CFG_WRITE(0xB88E, 0xC09C),
+    PHY_CFG_WRITE(0xB890, 0x2021),
+    PHY_CFG_WRITE(0xB88E, 0xC09E),
+    PHY_CFG_WRITE(0xB890, 0x2224),
+    PHY_CFG_WRITE(0xB88E, 0xC0A0),
+    PHY_CFG_WRITE(0xB890, 0x2424),
+    PHY_CFG_WRITE(0xB88E, 0xC0A2),
+    PHY_CFG_WRITE(0xB890, 0x2424),
+    PHY_CFG_WRITE(0xB88E, 0xC0A4),
+    PHY_CFG_WRITE(0xB890, 0x2424),
+    PHY_CFG_WRITE(0xB88E, 0xC018),
+    PHY_CFG_WRITE(0xB890, 0x0AF2),
+    PHY_CFG_WRITE(0xB88E, 0xC01A),
+    PHY_CFG_WRITE(0xB890, 0x0D4A),
+    PHY_CFG_WRITE(0xB88E, 0xC01C),
+    PHY_CFG_WRITE(0xB890, 0x0F26),
+    PHY_CFG_WRITE(0xB88E, 0xC01E),
+    PHY_CFG_WRITE(0xB890, 0x118D),
+    PHY_CFG_WRITE(0xB88E, 0xC020),
+    PHY_CFG_WRITE(0xB890, 0x14F3),
+    PHY_CFG_WRITE(0xB88E, 0xC022),
+    PHY_CFG_WRITE(0xB890, 0x175A),
+    PHY_CFG_WRITE(0xB88E, 0xC024),
+    PHY_CFG_WRITE(0xB890, 0x19C0),
+    PHY_CFG_WRITE(0xB88E, 0xC026),
+    PHY_CFG_WRITE(0xB890, 0x1C26),
+    PHY_CFG_WRITE(0xB88E, 0xC089),
+    PHY_CFG_WRITE(0xB890, 0x6050),
+    PHY_CFG_WRITE(0xB88E, 0xC08A),
+    PHY_CFG_WRITE(0xB890, 0x5F6E),
+    PHY_CFG_WRITE(0xB88E, 0xC08C),
+    PHY_CFG_WRITE(0xB890, 0x6E6E),
+    PHY_CFG_WRITE(0xB88E, 0xC08E),
+    PHY_CFG_WRITE(0xB890, 0x6E6E),
+    PHY_CFG_WRITE(0xB88E, 0xC090),
+    PHY_CFG_WRITE(0xB890, 0x6E12),
+
+    PHY_CFG_SET(0xB896, BIT_0),
+
+    PHY_CFG_MCU_PATCH_RELEASE(),
+
+    PHY_CFG_SET(0xD068, BIT_13),
+
+    PHY_CFG_WRITE(0xA436, 0x81A2),
+    PHY_CFG_SET(0xA438, BIT_8),
+    PHY_CFG_CLEAR_SET(0xB54C, 0xFF00, 0xDB00),
+
+    PHY_CFG_CLEAR(0xA454, BIT_0),
+
+    PHY_CFG_SET(0xA5D4, BIT_5),
+    PHY_CFG_CLEAR(0xAD4E, BIT_4),
+    PHY_CFG_CLEAR(0xA86A, BIT_0),
+
+    PHY_CFG_SET(0xA442, BIT_11),
+};
+
 void LucyRTL8125::configPhyHardware8125a2()
 {
     struct rtl8125_private *tp = &linuxData;
-
-    SetEthPhyOcpBit(tp, 0xAD4E, BIT_4);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAD16,
-                            0x03FF,
-                            0x03FF
-                            );
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAD32,
-                            0x003F,
-                            0x0006
-                            );
-    ClearEthPhyOcpBit(tp, 0xAC08, BIT_12);
-    ClearEthPhyOcpBit(tp, 0xAC08, BIT_8);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xACC0,
-                            BIT_1|BIT_0,
-                            BIT_1
-                            );
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAD40,
-                            BIT_7|BIT_6|BIT_5,
-                            BIT_6
-                            );
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAD40,
-                            BIT_2|BIT_1|BIT_0,
-                            BIT_2
-                            );
-    ClearEthPhyOcpBit(tp, 0xAC14, BIT_7);
-    ClearEthPhyOcpBit(tp, 0xAC80, BIT_9|BIT_8);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAC5E,
-                            BIT_2|BIT_1|BIT_0,
-                            BIT_1
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xAD4C, 0x00A8);
-    mdio_direct_write_phy_ocp(tp, 0xAC5C, 0x01FF);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAC8A,
-                            BIT_7|BIT_6|BIT_5|BIT_4,
-                            BIT_5|BIT_4
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8157);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xB87E,
-                            0xFF00,
-                            0x0500
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8159);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xB87E,
-                            0xFF00,
-                            0x0700
-                            );
     
     WriteReg16(EEE_TXIDLE_TIMER_8125, mtu + ETH_HLEN + 0x20);
     
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x80A2);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x0153);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x809C);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x0153);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x81B3);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0043);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00A7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00D6);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00EC);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00F6);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00FB);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00FD);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00FF);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00BB);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0058);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0029);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0013);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0009);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0004);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x8257);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x020F);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80EA);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7843);
-    
-    
-    rtl8125_set_phy_mcu_patch_request(tp);
-    
-    ClearEthPhyOcpBit(tp, 0xB896, BIT_0);
-    ClearEthPhyOcpBit(tp, 0xB892, 0xFF00);
-    
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC091);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x6E12);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC092);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x1214);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC094);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x1516);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC096);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x171B);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC098);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x1B1C);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC09A);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x1F1F);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC09C);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x2021);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC09E);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x2224);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC0A0);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x2424);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC0A2);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x2424);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC0A4);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x2424);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC018);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x0AF2);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC01A);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x0D4A);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC01C);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x0F26);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC01E);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x118D);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC020);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x14F3);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC022);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x175A);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC024);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x19C0);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC026);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x1C26);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC089);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x6050);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC08A);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x5F6E);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC08C);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x6E6E);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC08E);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x6E6E);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC090);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x6E12);
-    
-    SetEthPhyOcpBit(tp, 0xB896, BIT_0);
-    
-    rtl8125_clear_phy_mcu_patch_request(tp);
-    
-    
-    SetEthPhyOcpBit(tp, 0xD068, BIT_13);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x81A2);
-    SetEthPhyOcpBit(tp, 0xA438, BIT_8);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xB54C,
-                            0xFF00,
-                            0xDB00);
-    
-    
-    ClearEthPhyOcpBit(tp, 0xA454, BIT_0);
-    
-    
-    SetEthPhyOcpBit(tp, 0xA5D4, BIT_5);
-    ClearEthPhyOcpBit(tp, 0xAD4E, BIT_4);
-    ClearEthPhyOcpBit(tp, 0xA86A, BIT_0);
-    
-    
-    SetEthPhyOcpBit(tp, 0xA442, BIT_11);
-    
+    rtl8125_apply_phy_cfg_table(tp, phy_cfg_8125a_2, ARRAY_SIZE(phy_cfg_8125a_2));
     
     if (tp->RequirePhyMdiSwapPatch) {
         u16 adccal_offset_p0;
@@ -1884,7 +2152,6 @@ void LucyRTL8125::configPhyHardware8125a2()
                                 );
     }
     
-    
     if (aspm) {
         if (HW_HAS_WRITE_PHY_MCU_RAM_CODE(tp)) {
             rtl8125_enable_phy_aldps(tp);
@@ -1892,283 +2159,228 @@ void LucyRTL8125::configPhyHardware8125a2()
     }
 }
 
+static const struct rtl8125_phy_cfg phy_cfg_8125b_1[] = {
+    PHY_CFG_SET(0xA442, BIT_11),
+
+    PHY_CFG_SET(0xBC08, (BIT_3 | BIT_2)),
+
+    PHY_CFG_IF_RAM_CODE(2),
+        PHY_CFG_WRITE(0xA436, 0x8FFF),
+        PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x0400),
+    PHY_CFG_WRITE(0xB87C, 0x8560),
+    PHY_CFG_WRITE(0xB87E, 0x19CC),
+    PHY_CFG_WRITE(0xB87C, 0x8562),
+    PHY_CFG_WRITE(0xB87E, 0x19CC),
+    PHY_CFG_WRITE(0xB87C, 0x8564),
+    PHY_CFG_WRITE(0xB87E, 0x19CC),
+    PHY_CFG_WRITE(0xB87C, 0x8566),
+    PHY_CFG_WRITE(0xB87E, 0x147D),
+    PHY_CFG_WRITE(0xB87C, 0x8568),
+    PHY_CFG_WRITE(0xB87E, 0x147D),
+    PHY_CFG_WRITE(0xB87C, 0x856A),
+    PHY_CFG_WRITE(0xB87E, 0x147D),
+    PHY_CFG_IF_RAM_CODE(2),
+        PHY_CFG_WRITE(0xB87C, 0x8FFE),
+        PHY_CFG_WRITE(0xB87E, 0x0907),
+    PHY_CFG_CLEAR_SET(0xACDA, 0xFF00, 0xFF00),
+    PHY_CFG_CLEAR_SET(0xACDE, 0xF000, 0xF000),
+    PHY_CFG_WRITE(0xB87C, 0x80D6),
+    PHY_CFG_WRITE(0xB87E, 0x2801),
+    PHY_CFG_WRITE(0xB87C, 0x80F2),
+    PHY_CFG_WRITE(0xB87E, 0x2801),
+    PHY_CFG_WRITE(0xB87C, 0x80F4),
+    PHY_CFG_WRITE(0xB87E, 0x6077),
+    PHY_CFG_WRITE(0xB506, 0x01E7),
+    PHY_CFG_WRITE(0xAC8C, 0x0FFC),
+    PHY_CFG_WRITE(0xAC46, 0xB7B4),
+    PHY_CFG_WRITE(0xAC50, 0x0FBC),
+    PHY_CFG_WRITE(0xAC3C, 0x9240),
+    PHY_CFG_WRITE(0xAC4E, 0x0DB4),
+    PHY_CFG_WRITE(0xACC6, 0x0707),
+    PHY_CFG_WRITE(0xACC8, 0xA0D3),
+    PHY_CFG_WRITE(0xAD08, 0x0007),
+
+    PHY_CFG_WRITE(0xB87C, 0x8013),
+    PHY_CFG_WRITE(0xB87E, 0x0700),
+    PHY_CFG_WRITE(0xB87C, 0x8FB9),
+    PHY_CFG_WRITE(0xB87E, 0x2801),
+    PHY_CFG_WRITE(0xB87C, 0x8FBA),
+    PHY_CFG_WRITE(0xB87E, 0x0100),
+    PHY_CFG_WRITE(0xB87C, 0x8FBC),
+    PHY_CFG_WRITE(0xB87E, 0x1900),
+    PHY_CFG_WRITE(0xB87C, 0x8FBE),
+    PHY_CFG_WRITE(0xB87E, 0xE100),
+    PHY_CFG_WRITE(0xB87C, 0x8FC0),
+    PHY_CFG_WRITE(0xB87E, 0x0800),
+    PHY_CFG_WRITE(0xB87C, 0x8FC2),
+    PHY_CFG_WRITE(0xB87E, 0xE500),
+    PHY_CFG_WRITE(0xB87C, 0x8FC4),
+    PHY_CFG_WRITE(0xB87E, 0x0F00),
+    PHY_CFG_WRITE(0xB87C, 0x8FC6),
+    PHY_CFG_WRITE(0xB87E, 0xF100),
+    PHY_CFG_WRITE(0xB87C, 0x8FC8),
+    PHY_CFG_WRITE(0xB87E, 0x0400),
+    PHY_CFG_WRITE(0xB87C, 0x8FCa),
+    PHY_CFG_WRITE(0xB87E, 0xF300),
+    PHY_CFG_WRITE(0xB87C, 0x8FCc),
+    PHY_CFG_WRITE(0xB87E, 0xFD00),
+    PHY_CFG_WRITE(0xB87C, 0x8FCe),
+    PHY_CFG_WRITE(0xB87E, 0xFF00),
+    PHY_CFG_WRITE(0xB87C, 0x8FD0),
+    PHY_CFG_WRITE(0xB87E, 0xFB00),
+    PHY_CFG_WRITE(0xB87C, 0x8FD2),
+    PHY_CFG_WRITE(0xB87E, 0x0100),
+    PHY_CFG_WRITE(0xB87C, 0x8FD4),
+    PHY_CFG_WRITE(0xB87E, 0xF400),
+    PHY_CFG_WRITE(0xB87C, 0x8FD6),
+    PHY_CFG_WRITE(0xB87E, 0xFF00),
+    PHY_CFG_WRITE(0xB87C, 0x8FD8),
+    PHY_CFG_WRITE(0xB87E, 0xF600),
+
+    PHY_CFG_WRITE(0xB87C, 0x813D),
+    PHY_CFG_WRITE(0xB87E, 0x390E),
+    PHY_CFG_WRITE(0xB87C, 0x814F),
+    PHY_CFG_WRITE(0xB87E, 0x790E),
+    PHY_CFG_WRITE(0xB87C, 0x80B0),
+    PHY_CFG_WRITE(0xB87E, 0x0F31),
+    PHY_CFG_SET(0xBF4C, BIT_1),
+    PHY_CFG_SET(0xBCCA, (BIT_9 | BIT_8)),
+    PHY_CFG_WRITE(0xB87C, 0x8141),
+    PHY_CFG_WRITE(0xB87E, 0x320E),
+    PHY_CFG_WRITE(0xB87C, 0x8153),
+    PHY_CFG_WRITE(0xB87E, 0x720E),
+    PHY_CFG_CLEAR(0xA432, BIT_6),
+    PHY_CFG_WRITE(0xB87C, 0x8529),
+    PHY_CFG_WRITE(0xB87E, 0x050E),
+
+    PHY_CFG_WRITE(0xA436, 0x816C),
+    PHY_CFG_WRITE(0xA438, 0xC4A0),
+    PHY_CFG_WRITE(0xA436, 0x8170),
+    PHY_CFG_WRITE(0xA438, 0xC4A0),
+    PHY_CFG_WRITE(0xA436, 0x8174),
+    PHY_CFG_WRITE(0xA438, 0x04A0),
+    PHY_CFG_WRITE(0xA436, 0x8178),
+    PHY_CFG_WRITE(0xA438, 0x04A0),
+    PHY_CFG_WRITE(0xA436, 0x817C),
+    PHY_CFG_WRITE(0xA438, 0x0719),
+    PHY_CFG_IF_RAM_CODE(4),
+        PHY_CFG_WRITE(0xA436, 0x8FF4),
+        PHY_CFG_WRITE(0xA438, 0x0400),
+        PHY_CFG_WRITE(0xA436, 0x8FF1),
+        PHY_CFG_WRITE(0xA438, 0x0404),
+    PHY_CFG_WRITE(0xBF4A, 0x001B),
+    PHY_CFG_WRITE(0xB87C, 0x8033),
+    PHY_CFG_WRITE(0xB87E, 0x7C13),
+    PHY_CFG_WRITE(0xB87C, 0x8037),
+    PHY_CFG_WRITE(0xB87E, 0x7C13),
+    PHY_CFG_WRITE(0xB87C, 0x803B),
+    PHY_CFG_WRITE(0xB87E, 0xFC32),
+    PHY_CFG_WRITE(0xB87C, 0x803F),
+    PHY_CFG_WRITE(0xB87E, 0x7C13),
+    PHY_CFG_WRITE(0xB87C, 0x8043),
+    PHY_CFG_WRITE(0xB87E, 0x7C13),
+    PHY_CFG_WRITE(0xB87C, 0x8047),
+    PHY_CFG_WRITE(0xB87E, 0x7C13),
+
+    PHY_CFG_WRITE(0xB87C, 0x8145),
+    PHY_CFG_WRITE(0xB87E, 0x370E),
+    PHY_CFG_WRITE(0xB87C, 0x8157),
+    PHY_CFG_WRITE(0xB87E, 0x770E),
+    PHY_CFG_WRITE(0xB87C, 0x8169),
+    PHY_CFG_WRITE(0xB87E, 0x0D0A),
+    PHY_CFG_WRITE(0xB87C, 0x817B),
+    PHY_CFG_WRITE(0xB87E, 0x1D0A),
+
+    PHY_CFG_WRITE(0xA436, 0x8217),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x5000),
+    PHY_CFG_WRITE(0xA436, 0x821A),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x5000),
+
+    PHY_CFG_WRITE(0xA436, 0x80DA),
+    PHY_CFG_WRITE(0xA438, 0x0403),
+    PHY_CFG_WRITE(0xA436, 0x80DC),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x1000),
+    PHY_CFG_WRITE(0xA436, 0x80B3),
+    PHY_CFG_WRITE(0xA438, 0x0384),
+    PHY_CFG_WRITE(0xA436, 0x80B7),
+    PHY_CFG_WRITE(0xA438, 0x2007),
+    PHY_CFG_WRITE(0xA436, 0x80BA),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x6C00),
+    PHY_CFG_WRITE(0xA436, 0x80B5),
+    PHY_CFG_WRITE(0xA438, 0xF009),
+    PHY_CFG_WRITE(0xA436, 0x80BD),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x9F00),
+
+    PHY_CFG_WRITE(0xA436, 0x80C7),
+    PHY_CFG_WRITE(0xA438, 0xf083),
+    PHY_CFG_WRITE(0xA436, 0x80DD),
+    PHY_CFG_WRITE(0xA438, 0x03f0),
+    PHY_CFG_WRITE(0xA436, 0x80DF),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x1000),
+    PHY_CFG_WRITE(0xA436, 0x80CB),
+    PHY_CFG_WRITE(0xA438, 0x2007),
+    PHY_CFG_WRITE(0xA436, 0x80CE),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x6C00),
+    PHY_CFG_WRITE(0xA436, 0x80C9),
+    PHY_CFG_WRITE(0xA438, 0x8009),
+    PHY_CFG_WRITE(0xA436, 0x80D1),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0x8000),
+
+    PHY_CFG_WRITE(0xA436, 0x80A3),
+    PHY_CFG_WRITE(0xA438, 0x200A),
+    PHY_CFG_WRITE(0xA436, 0x80A5),
+    PHY_CFG_WRITE(0xA438, 0xF0AD),
+    PHY_CFG_WRITE(0xA436, 0x809F),
+    PHY_CFG_WRITE(0xA438, 0x6073),
+    PHY_CFG_WRITE(0xA436, 0x80A1),
+    PHY_CFG_WRITE(0xA438, 0x000B),
+    PHY_CFG_WRITE(0xA436, 0x80A9),
+    PHY_CFG_CLEAR_SET(0xA438, 0xFF00, 0xC000),
+
+    PHY_CFG_MCU_PATCH_REQUEST(),
+
+    PHY_CFG_CLEAR(0xB896, BIT_0),
+    PHY_CFG_CLEAR(0xB892, 0xFF00),
+
+    PHY_CFG_WRITE(0xB88E, 0xC23E),
+    PHY_CFG_WRITE(0xB890, 0x0000),
+    PHY_CFG_WRITE(0xB88E, 0xC240),
+    PHY_CFG_WRITE(0xB890, 0x0103),
+    PHY_CFG_WRITE(0xB88E, 0xC242),
+    PHY_CFG_WRITE(0xB890, 0x0507),
+    PHY_CFG_WRITE(0xB88E, 0xC244),
+    PHY_CFG_WRITE(0xB890, 0x090B),
+    PHY_CFG_WRITE(0xB88E, 0xC246),
+    PHY_CFG_WRITE(0xB890, 0x0C0E),
+    PHY_CFG_WRITE(0xB88E, 0xC248),
+    PHY_CFG_WRITE(0xB890, 0x1012),
+    PHY_CFG_WRITE(0xB88E, 0xC24A),
+    PHY_CFG_WRITE(0xB890, 0x1416),
+
+    PHY_CFG_SET(0xB896, BIT_0),
+
+    PHY_CFG_MCU_PATCH_RELEASE(),
+
+    PHY_CFG_SET(0xA86A, BIT_0),
+    PHY_CFG_SET(0xA6F0, BIT_0),
+
+    PHY_CFG_WRITE(0xBFA0, 0xD70D),
+    PHY_CFG_WRITE(0xBFA2, 0x4100),
+    PHY_CFG_WRITE(0xBFA4, 0xE868),
+    PHY_CFG_WRITE(0xBFA6, 0xDC59),
+    PHY_CFG_WRITE(0xB54C, 0x3C18),
+    PHY_CFG_CLEAR(0xBFA4, BIT_5),
+    PHY_CFG_WRITE(0xA436, 0x817D),
+    PHY_CFG_SET(0xA438, BIT_12),
+};
+
 void LucyRTL8125::configPhyHardware8125b1()
 {
     struct rtl8125_private *tp = &linuxData;
-
-    SetEthPhyOcpBit(tp, 0xA442, BIT_11);
-    
-    
-    SetEthPhyOcpBit(tp, 0xBC08, (BIT_3 | BIT_2));
-    
-    
-    if (HW_HAS_WRITE_PHY_MCU_RAM_CODE(tp)) {
-        mdio_direct_write_phy_ocp(tp, 0xA436, 0x8FFF);
-        ClearAndSetEthPhyOcpBit(tp,
-                                0xA438,
-                                0xFF00,
-                                0x0400
-                                );
-    }
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8560);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x19CC);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8562);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x19CC);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8564);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x19CC);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8566);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x147D);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8568);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x147D);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x856A);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x147D);
-    if (HW_HAS_WRITE_PHY_MCU_RAM_CODE(tp)) {
-        mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FFE);
-        mdio_direct_write_phy_ocp(tp, 0xB87E, 0x0907);
-    }
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xACDA,
-                            0xFF00,
-                            0xFF00
-                            );
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xACDE,
-                            0xF000,
-                            0xF000
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x80D6);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x2801);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x80F2);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x2801);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x80F4);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x6077);
-    mdio_direct_write_phy_ocp(tp, 0xB506, 0x01E7);
-    mdio_direct_write_phy_ocp(tp, 0xAC8C, 0x0FFC);
-    mdio_direct_write_phy_ocp(tp, 0xAC46, 0xB7B4);
-    mdio_direct_write_phy_ocp(tp, 0xAC50, 0x0FBC);
-    mdio_direct_write_phy_ocp(tp, 0xAC3C, 0x9240);
-    mdio_direct_write_phy_ocp(tp, 0xAC4E, 0x0DB4);
-    mdio_direct_write_phy_ocp(tp, 0xACC6, 0x0707);
-    mdio_direct_write_phy_ocp(tp, 0xACC8, 0xA0D3);
-    mdio_direct_write_phy_ocp(tp, 0xAD08, 0x0007);
-    
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8013);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x0700);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FB9);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x2801);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FBA);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x0100);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FBC);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x1900);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FBE);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0xE100);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FC0);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x0800);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FC2);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0xE500);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FC4);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x0F00);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FC6);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0xF100);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FC8);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x0400);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FCa);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0xF300);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FCc);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0xFD00);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FCe);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0xFF00);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FD0);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0xFB00);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FD2);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x0100);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FD4);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0xF400);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FD6);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0xFF00);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8FD8);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0xF600);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x813D);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x390E);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x814F);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x790E);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x80B0);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x0F31);
-    SetEthPhyOcpBit(tp, 0xBF4C, BIT_1);
-    SetEthPhyOcpBit(tp, 0xBCCA, (BIT_9 | BIT_8));
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8141);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x320E);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8153);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x720E);
-    ClearEthPhyOcpBit(tp, 0xA432, BIT_6);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8529);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x050E);
     
     WriteReg16(EEE_TXIDLE_TIMER_8125, mtu + ETH_HLEN + 0x20);
-
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x816C);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xC4A0);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x8170);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xC4A0);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x8174);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x04A0);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x8178);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x04A0);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x817C);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0719);
-    if (HW_HAS_WRITE_PHY_MCU_RAM_CODE(tp)) {
-        mdio_direct_write_phy_ocp(tp, 0xA436, 0x8FF4);
-        mdio_direct_write_phy_ocp(tp, 0xA438, 0x0400);
-        mdio_direct_write_phy_ocp(tp, 0xA436, 0x8FF1);
-        mdio_direct_write_phy_ocp(tp, 0xA438, 0x0404);
-    }
-    mdio_direct_write_phy_ocp(tp, 0xBF4A, 0x001B);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8033);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x7C13);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8037);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x7C13);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x803B);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0xFC32);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x803F);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x7C13);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8043);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x7C13);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8047);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x7C13);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8145);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x370E);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8157);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x770E);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8169);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x0D0A);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x817B);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x1D0A);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x8217);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x5000
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x821A);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x5000
-                            );
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80DA);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0403);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80DC);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x1000
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80B3);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0384);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80B7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2007);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80BA);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x6C00
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80B5);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xF009);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80BD);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x9F00
-                            );
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80C7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf083);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80DD);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x03f0);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80DF);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x1000
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80CB);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2007);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80CE);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x6C00
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80C9);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8009);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80D1);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0x8000
-                            );
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80A3);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x200A);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80A5);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xF0AD);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x809F);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6073);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80A1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x000B);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x80A9);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            0xFF00,
-                            0xC000
-                            );
-    
-    rtl8125_set_phy_mcu_patch_request(tp);
-    
-    ClearEthPhyOcpBit(tp, 0xB896, BIT_0);
-    ClearEthPhyOcpBit(tp, 0xB892, 0xFF00);
-    
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC23E);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC240);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x0103);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC242);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x0507);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC244);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x090B);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC246);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x0C0E);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC248);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x1012);
-    mdio_direct_write_phy_ocp(tp, 0xB88E, 0xC24A);
-    mdio_direct_write_phy_ocp(tp, 0xB890, 0x1416);
-    
-    SetEthPhyOcpBit(tp, 0xB896, BIT_0);
-    
-    rtl8125_clear_phy_mcu_patch_request(tp);
-    
-    
-    SetEthPhyOcpBit(tp, 0xA86A, BIT_0);
-    SetEthPhyOcpBit(tp, 0xA6F0, BIT_0);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xBFA0, 0xD70D);
-    mdio_direct_write_phy_ocp(tp, 0xBFA2, 0x4100);
-    mdio_direct_write_phy_ocp(tp, 0xBFA4, 0xE868);
-    mdio_direct_write_phy_ocp(tp, 0xBFA6, 0xDC59);
-    mdio_direct_write_phy_ocp(tp, 0xB54C, 0x3C18);
-    ClearEthPhyOcpBit(tp, 0xBFA4, BIT_5);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x817D);
-    SetEthPhyOcpBit(tp, 0xA438, BIT_12);
     
+    rtl8125_apply_phy_cfg_table(tp, phy_cfg_8125b_1, ARRAY_SIZE(phy_cfg_8125b_1));
     
     if (aspm) {
         if (HW_HAS_WRITE_PHY_MCU_RAM_CODE(tp)) {
@@ -2177,86 +2389,57 @@ void LucyRTL8125::configPhyHardware8125b1()
     }
 }
 
+static const struct rtl8125_phy_cfg phy_cfg_8125b_2[] = {
+    PHY_CFG_SET(0xA442, BIT_11),
+
+    PHY_CFG_CLEAR_SET(0xAC46, 0x00F0, 0x0090),
+    PHY_CFG_CLEAR_SET(0xAD30, 0x0003, 0x0001),
+
+    PHY_CFG_WRITE(0xB87C, 0x80F5),
+    PHY_CFG_WRITE(0xB87E, 0x760E),
+    PHY_CFG_WRITE(0xB87C, 0x8107),
+    PHY_CFG_WRITE(0xB87E, 0x360E),
+    PHY_CFG_WRITE(0xB87C, 0x8551),
+    PHY_CFG_CLEAR_SET(0xB87E, BIT_15 | BIT_14 | BIT_13 | BIT_12 | BIT_11 | BIT_10 | BIT_9 | BIT_8, BIT_11),
+
+    PHY_CFG_CLEAR_SET(0xbf00, 0xE000, 0xA000),
+    PHY_CFG_CLEAR_SET(0xbf46, 0x0F00, 0x0300),
+    PHY_CFG_WRITE(0xa436, 0x8044),
+    PHY_CFG_WRITE(0xa438, 0x2417),
+    PHY_CFG_WRITE(0xa436, 0x804A),
+    PHY_CFG_WRITE(0xa438, 0x2417),
+    PHY_CFG_WRITE(0xa436, 0x8050),
+    PHY_CFG_WRITE(0xa438, 0x2417),
+    PHY_CFG_WRITE(0xa436, 0x8056),
+    PHY_CFG_WRITE(0xa438, 0x2417),
+    PHY_CFG_WRITE(0xa436, 0x805C),
+    PHY_CFG_WRITE(0xa438, 0x2417),
+    PHY_CFG_WRITE(0xa436, 0x8062),
+    PHY_CFG_WRITE(0xa438, 0x2417),
+    PHY_CFG_WRITE(0xa436, 0x8068),
+    PHY_CFG_WRITE(0xa438, 0x2417),
+    PHY_CFG_WRITE(0xa436, 0x806E),
+    PHY_CFG_WRITE(0xa438, 0x2417),
+    PHY_CFG_WRITE(0xa436, 0x8074),
+    PHY_CFG_WRITE(0xa438, 0x2417),
+    PHY_CFG_WRITE(0xa436, 0x807A),
+    PHY_CFG_WRITE(0xa438, 0x2417),
+
+    PHY_CFG_SET(0xA4CA, BIT_6),
+
+    PHY_CFG_CLEAR_SET(0xBF84, BIT_15 | BIT_14 | BIT_13, BIT_15 | BIT_13),
+
+    PHY_CFG_WRITE(0xA436, 0x8170),
+    PHY_CFG_CLEAR_SET(0xA438, BIT_13 | BIT_10 | BIT_9 | BIT_8, BIT_15 | BIT_14 | BIT_12 | BIT_11),
+};
+
 void LucyRTL8125::configPhyHardware8125b2()
 {
     struct rtl8125_private *tp = &linuxData;
     
-    SetEthPhyOcpBit(tp, 0xA442, BIT_11);
-    
-    
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAC46,
-                            0x00F0,
-                            0x0090
-                            );
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xAD30,
-                            0x0003,
-                            0x0001
-                            );
-    
-    
     WriteReg16(EEE_TXIDLE_TIMER_8125, mtu + ETH_HLEN + 0x20);
     
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x80F5);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x760E);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8107);
-    mdio_direct_write_phy_ocp(tp, 0xB87E, 0x360E);
-    mdio_direct_write_phy_ocp(tp, 0xB87C, 0x8551);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xB87E,
-                            BIT_15 | BIT_14 | BIT_13 | BIT_12 | BIT_11 | BIT_10 | BIT_9 | BIT_8,
-                            BIT_11
-                            );
-    
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xbf00,
-                            0xE000,
-                            0xA000
-                            );
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xbf46,
-                            0x0F00,
-                            0x0300
-                            );
-    mdio_direct_write_phy_ocp(tp, 0xa436, 0x8044);
-    mdio_direct_write_phy_ocp(tp, 0xa438, 0x2417);
-    mdio_direct_write_phy_ocp(tp, 0xa436, 0x804A);
-    mdio_direct_write_phy_ocp(tp, 0xa438, 0x2417);
-    mdio_direct_write_phy_ocp(tp, 0xa436, 0x8050);
-    mdio_direct_write_phy_ocp(tp, 0xa438, 0x2417);
-    mdio_direct_write_phy_ocp(tp, 0xa436, 0x8056);
-    mdio_direct_write_phy_ocp(tp, 0xa438, 0x2417);
-    mdio_direct_write_phy_ocp(tp, 0xa436, 0x805C);
-    mdio_direct_write_phy_ocp(tp, 0xa438, 0x2417);
-    mdio_direct_write_phy_ocp(tp, 0xa436, 0x8062);
-    mdio_direct_write_phy_ocp(tp, 0xa438, 0x2417);
-    mdio_direct_write_phy_ocp(tp, 0xa436, 0x8068);
-    mdio_direct_write_phy_ocp(tp, 0xa438, 0x2417);
-    mdio_direct_write_phy_ocp(tp, 0xa436, 0x806E);
-    mdio_direct_write_phy_ocp(tp, 0xa438, 0x2417);
-    mdio_direct_write_phy_ocp(tp, 0xa436, 0x8074);
-    mdio_direct_write_phy_ocp(tp, 0xa438, 0x2417);
-    mdio_direct_write_phy_ocp(tp, 0xa436, 0x807A);
-    mdio_direct_write_phy_ocp(tp, 0xa438, 0x2417);
-    
-    
-    SetEthPhyOcpBit(tp, 0xA4CA, BIT_6);
-    
-    
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xBF84,
-                            BIT_15 | BIT_14 | BIT_13,
-                            BIT_15 | BIT_13
-                            );
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0x8170);
-    ClearAndSetEthPhyOcpBit(tp,
-                            0xA438,
-                            BIT_13 | BIT_10 | BIT_9 | BIT_8,
-                            BIT_15 | BIT_14 | BIT_12 | BIT_11
-                            );
+    rtl8125_apply_phy_cfg_table(tp, phy_cfg_8125b_2, ARRAY_SIZE(phy_cfg_8125b_2));
     
     /*
      mdio_direct_write_phy_ocp(tp, 0xBFA0, 0xD70D);
@@ -2269,7 +2452,6 @@ void LucyRTL8125::configPhyHardware8125b2()
      SetEthPhyOcpBit(tp, 0xA438, BIT_12);
      */
     
-    
     if (aspm) {
         if (HW_HAS_WRITE_PHY_MCU_RAM_CODE(tp)) {
             rtl8125_enable_phy_aldps(tp);
@@ -1663,6 +1663,80 @@ static inline u16 map_phy_ocp_addr(u16 PageNum, u8 RegNum)
     return OcpPhyAddress;
 }
 
+/*
+ * OCP registers which are written by the driver but never changed by
+ * the hardware. Reads of these are served from a shadow copy once the
+ * value is known, so that read-modify-write sequences don't have to
+ * go over the slow OCP bus again. Registers with status or self
+ * clearing bits must not be listed here.
+ */
+static const u16 rtl8125_mac_ocp_shadow_regs[] = {
+    0xC0AC, 0xC0B4, 0xD430, 0xE040, 0xE052, 0xE056, 0xE080, 0xE0C0,
+    0xE614, 0xE63E, 0xEA1C, 0xEB50, 0xEB58, 0xEB62, 0xEB6A
+};
+
+static const u16 rtl8125_phy_ocp_shadow_regs[] = {
+    0xA408, 0xA412, 0xA428, 0xA430, 0xA432, 0xA442, 0xA4A2, 0xA5D0,
+    0xA5D4, 0xA5EA, 0xA6D4, 0xA6D8
+};
+
+static_assert(ARRAY_SIZE(rtl8125_mac_ocp_shadow_regs) <= RTL8125_OCP_SHADOW_MAX, "MAC OCP shadow too small");
+static_assert(ARRAY_SIZE(rtl8125_phy_ocp_shadow_regs) <= RTL8125_OCP_SHADOW_MAX, "PHY OCP shadow too small");
+
+void rtl8125_init_ocp_shadow(struct rtl8125_private *tp)
+{
+    tp->mac_ocp_shadow.addr = rtl8125_mac_ocp_shadow_regs;
+    tp->mac_ocp_shadow.count = ARRAY_SIZE(rtl8125_mac_ocp_shadow_regs);
+    tp->phy_ocp_shadow.addr = rtl8125_phy_ocp_shadow_regs;
+    tp->phy_ocp_shadow.count = ARRAY_SIZE(rtl8125_phy_ocp_shadow_regs);
+
+    rtl8125_reset_ocp_shadow(tp);
+}
+
+/* Forget all shadowed values and restart counting the saved reads. */
+void rtl8125_reset_ocp_shadow(struct rtl8125_private *tp)
+{
+    tp->mac_ocp_shadow.valid = 0;
+    tp->mac_ocp_shadow.hits = 0;
+    tp->phy_ocp_shadow.valid = 0;
+    tp->phy_ocp_shadow.hits = 0;
+}
+
+static int rtl8125_ocp_shadow_index(struct rtl8125_ocp_shadow *shadow, u16 addr)
+{
+    u32 i;
+
+    for (i = 0; i < shadow->count; i++) {
+        if (shadow->addr[i] == addr)
+            return i;
+    }
+    return -1;
+}
+
+static bool rtl8125_ocp_shadow_read(struct rtl8125_ocp_shadow *shadow, u16 addr, u16 *value)
+{
+    int i = rtl8125_ocp_shadow_index(shadow, addr);
+
+    if ((i < 0) || !(shadow->valid & (1 << i)))
+        return false;
+
+    *value = shadow->value[i];
+    shadow->hits++;
+
+    return true;
+}
+
+static void rtl8125_ocp_shadow_update(struct rtl8125_ocp_shadow *shadow, u16 addr, u16 value)
+{
+    int i = rtl8125_ocp_shadow_index(shadow, addr);
+
+    if (i < 0)
+        return;
+
+    shadow->value[i] = value;
+    shadow->valid |= (1 << i);
+}
+
 void mdio_real_direct_write_phy_ocp(struct rtl8125_private *tp,
                                            u16 RegAddr,
                                            u16 value)
@@ -1684,6 +1758,10 @@ void mdio_real_direct_write_phy_ocp(struct rtl8125_private *tp,
         if (!(RTL_R32(tp, PHYOCP) & OCPR_Flag))
             break;
     }
+    if (i < 100)
+        rtl8125_ocp_shadow_update(&tp->phy_ocp_shadow, RegAddr, value);
+    else
+        rtl8125_invalidate_ocp_shadow(&tp->phy_ocp_shadow);
 }
 
 void mdio_direct_write_phy_ocp(struct rtl8125_private *tp,
@@ -1760,10 +1838,14 @@ static u32 mdio_real_direct_read_phy_ocp(struct rtl8125_private *tp,
 {
     u32 data32;
     int i, value = 0;
+    u16 shadow;
     
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,18)
     WARN_ON_ONCE(RegAddr % 2);
 #endif
+    if (rtl8125_ocp_shadow_read(&tp->phy_ocp_shadow, RegAddr, &shadow))
+        return shadow;
+    
     data32 = RegAddr/2;
     data32 <<= OCPR_Addr_Reg_shift;
     
@@ -1776,6 +1858,10 @@ static u32 mdio_real_direct_read_phy_ocp(struct rtl8125_private *tp,
     }
     value = RTL_R32(tp, PHYOCP) & OCPDR_Data_Mask;
     
+    /* Don't shadow the result of a timed out read. */
+    if (i < 100)
+        rtl8125_ocp_shadow_update(&tp->phy_ocp_shadow, RegAddr, value);
+    
     return value;
 }
 
@@ -1907,6 +1993,8 @@ void rtl8125_mac_ocp_write(struct rtl8125_private *tp, u16 reg_addr, u16 value)
     data32 |= OCPR_Write;
     
     RTL_W32(tp, MACOCP, data32);
+    
+    rtl8125_ocp_shadow_update(&tp->mac_ocp_shadow, reg_addr, value);
 }
 
 u16 rtl8125_mac_ocp_read(struct rtl8125_private *tp, u16 reg_addr)
@@ -1918,12 +2006,17 @@ u16 rtl8125_mac_ocp_read(struct rtl8125_private *tp, u16 reg_addr)
     WARN_ON_ONCE(reg_addr % 2);
 #endif
     
+    if (rtl8125_ocp_shadow_read(&tp->mac_ocp_shadow, reg_addr, &data16))
+        return data16;
+    
     data32 = reg_addr/2;
     data32 <<= OCPR_Addr_Reg_shift;
     
     RTL_W32(tp, MACOCP, data32);
     data16 = (u16)RTL_R32(tp, MACOCP);
     
+    rtl8125_ocp_shadow_update(&tp->mac_ocp_shadow, reg_addr, data16);
+    
     return data16;
 }
 
@@ -2558,7 +2651,7 @@ int rtl8125_eri_write(struct rtl8125_private *tp, int addr, int len, u32 value,
     return rtl8125_eri_write_with_oob_base_address(tp, addr, len, value, type, NO_BASE_ADDRESS);
 }
 
-static void
+void
 rtl8125_enable_rxdvgate(struct net_device *dev)
 {
     struct rtl8125_private *tp = netdev_priv(dev);
@@ -2676,31 +2769,23 @@ void
 rtl8125_wait_txrx_fifo_empty(struct net_device *dev)
 {
     struct rtl8125_private *tp = netdev_priv(dev);
-    int i;
+    UInt32 waited;
     
     switch (tp->mcfg) {
         case CFG_METHOD_2:
         case CFG_METHOD_3:
         case CFG_METHOD_4:
         case CFG_METHOD_5:
-            for (i = 0; i < 3000; i++) {
-                udelay(50);
-                if ((RTL_R8(tp, MCUCmd_reg) & (Txfifo_empty | Rxfifo_empty)) == (Txfifo_empty | Rxfifo_empty))
-                    break;
-                
-            }
+            poll_backoff_timeout((RTL_R8(tp, MCUCmd_reg) & (Txfifo_empty | Rxfifo_empty)) == (Txfifo_empty | Rxfifo_empty), 150000, waited);
+            dprintk("wait txrx fifo empty: %uµs.\n", waited);
             break;
     }
     
     switch (tp->mcfg) {
         case CFG_METHOD_4:
         case CFG_METHOD_5:
-            for (i = 0; i < 3000; i++) {
-                udelay(50);
-                if ((RTL_R16(tp, IntrMitigate) & (BIT_0 | BIT_1 | BIT_8)) == (BIT_0 | BIT_1 | BIT_8))
-                    break;
-                
-            }
+            poll_backoff_timeout((RTL_R16(tp, IntrMitigate) & (BIT_0 | BIT_1 | BIT_8)) == (BIT_0 | BIT_1 | BIT_8), 150000, waited);
+            dprintk("wait IntrMitigate ready: %uµs.\n", waited);
             break;
     }
 }
@@ -2882,6 +2967,7 @@ rtl8125_nic_reset(struct net_device *dev)
     
     /* Soft reset the chip. */
     RTL_W8(tp, ChipCmd, CmdReset);
+    rtl8125_invalidate_ocp_shadow(&tp->mac_ocp_shadow);
     
     /* Check that the chip has finished the reset. */
     for (i = 100; i > 0; i--) {
@@ -3021,7 +3107,7 @@ void
 rtl8125_xmii_reset_enable(struct net_device *dev)
 {
     struct rtl8125_private *tp = netdev_priv(dev);
-    int i, val = 0;
+    UInt32 waited;
     
     if (rtl8125_is_in_phy_disable_mode(dev)) {
         return;
@@ -3035,15 +3121,11 @@ rtl8125_xmii_reset_enable(struct net_device *dev)
                        ~(ADVERTISE_1000HALF | ADVERTISE_1000FULL));
     mdio_direct_write_phy_ocp(tp, 0xA5D4, mdio_direct_read_phy_ocp(tp, 0xA5D4) & ~(RTK_ADVERTISE_2500FULL));
     rtl8125_mdio_write(tp, MII_BMCR, BMCR_RESET | BMCR_ANENABLE);
+    rtl8125_invalidate_ocp_shadow(&tp->phy_ocp_shadow);
     
-    for (i = 0; i < 2500; i++) {
-        val = rtl8125_mdio_read(tp, MII_BMCR) & BMCR_RESET;
-        
-        if (!val) {
-            return;
-        }
-        
-        mdelay(1);
+    if (poll_backoff_timeout(!(rtl8125_mdio_read(tp, MII_BMCR) & BMCR_RESET), 2500000, waited)) {
+        dprintk("PHY reset: %uµs.\n", waited);
+        return;
     }
     
     if (netif_msg_link(tp))
@@ -3366,13 +3448,10 @@ void
 rtl8125_wait_ll_share_fifo_ready(struct net_device *dev)
 {
     struct rtl8125_private *tp = netdev_priv(dev);
-    int i;
+    UInt32 waited;
     
-    for (i = 0; i < 10; i++) {
-        udelay(100);
-        if (RTL_R16(tp, 0xD2) & BIT_9)
-            break;
-    }
+    poll_backoff_timeout(RTL_R16(tp, 0xD2) & BIT_9, 1000, waited);
+    dprintk("wait ll share fifo ready: %uµs.\n", waited);
 }
 
 #if DISABLED_CODE
@@ -5450,24 +5529,17 @@ void
 rtl8125_wait_phy_ups_resume(struct net_device *dev, u16 PhyState)
 {
     struct rtl8125_private *tp = netdev_priv(dev);
-    u16 TmpPhyState;
-    int i=0;
+    UInt32 waited;
     
     if (tp->mcfg == CFG_METHOD_2 ||
         tp->mcfg == CFG_METHOD_3 ||
         tp->mcfg == CFG_METHOD_4 ||
         tp->mcfg == CFG_METHOD_5) {
-        do {
-            TmpPhyState = mdio_direct_read_phy_ocp(tp, 0xA420);
-            TmpPhyState &= 0x7;
-            mdelay(1);
-            i++;
-        } while ((i < 100) && (TmpPhyState != PhyState));
+        if (!poll_backoff_timeout((mdio_direct_read_phy_ocp(tp, 0xA420) & 0x7) == PhyState, 100000, waited))
+            dprintk("wait phy ups resume timed out.\n");
+        
+        dprintk("wait phy ups resume: %uµs.\n", waited);
     }
-    
-#if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,18)
-    WARN_ON_ONCE(i == 100);
-#endif
 }
 
 void
@@ -5897,7 +5969,7 @@ rtl8125_hw_ephy_config(struct net_device *dev)
     }
 }
 
-static int
+int
 rtl8125_check_hw_phy_mcu_code_ver(struct net_device *dev)
 {
     struct rtl8125_private *tp = netdev_priv(dev);
@@ -5990,23 +6062,16 @@ rtl8125_release_phy_mcu_patch_key_lock(struct rtl8125_private *tp)
 static bool
 rtl8125_wait_phy_mcu_patch_request_ready(struct rtl8125_private *tp)
 {
-    u16 gphy_val;
-    u16 WaitCount;
-    bool bSuccess = TRUE;
-    
-    WaitCount = 0;
-    do {
-        gphy_val = mdio_direct_read_phy_ocp(tp, 0xB800);
-        gphy_val &= BIT_6;
-        udelay(100);
-        WaitCount++;
-    } while(gphy_val != BIT_6 && WaitCount < 1000);
+    UInt32 waited;
+    bool bSuccess;
     
-    if (gphy_val != BIT_6 && WaitCount == 1000) bSuccess = FALSE;
+    bSuccess = poll_backoff_timeout(mdio_direct_read_phy_ocp(tp, 0xB800) & BIT_6, 100000, waited);
     
     if (!bSuccess)
         dprintk("rtl8125_wait_phy_mcu_patch_request_ready fail.\n");
     
+    dprintk("wait phy mcu patch request ready: %uµs.\n", waited);
+    
     return bSuccess;
 }
 
@@ -6030,6 +6095,7 @@ static void
 rtl8125_set_phy_mcu_ram_code(struct net_device *dev, const u16 *ramcode, u16 codesize)
 {
     struct rtl8125_private *tp = netdev_priv(dev);
+    u64 start, now, ns;
     u16 i;
     u16 addr;
     u16 val;
@@ -6037,6 +6103,15 @@ rtl8125_set_phy_mcu_ram_code(struct net_device *dev, const u16 *ramcode, u16 cod
     if (ramcode == NULL || codesize % 2) {
         goto out;
     }
+    /*
+     * The ram code is a long stream of 0xA436/0xA438 data port writes.
+     * Check the diag lock once for the whole stream instead of once
+     * per word.
+     */
+    if (tp->rtk_enable_diag)
+        goto out;
+    
+    clock_get_uptime(&start);
     
     for (i = 0; i < codesize; i += 2) {
         addr = ramcode[i];
@@ -6044,13 +6119,273 @@ rtl8125_set_phy_mcu_ram_code(struct net_device *dev, const u16 *ramcode, u16 cod
         if (addr == 0xFFFF && val == 0xFFFF) {
             break;
         }
-        mdio_direct_write_phy_ocp(tp, addr, val);
+        mdio_real_direct_write_phy_ocp(tp, addr, val);
     }
+    clock_get_uptime(&now);
+    absolutetime_to_nanoseconds(now - start, &ns);
+    
+    dprintk("PHY MCU ram code: %u writes, %lluµs.\n", i / 2, ns / 1000);
     
 out:
     return;
 }
 
+/*
+ * Execute a PHY OCP configuration table. Each entry is either a plain
+ * write (clearmask 0xFFFF), a read-modify-write or one of the control
+ * operations which are encoded with an odd register address.
+ */
+void
+rtl8125_apply_phy_cfg_table(struct rtl8125_private *tp,
+                            const struct rtl8125_phy_cfg *cfg,
+                            u16 count)
+{
+    const struct rtl8125_phy_cfg *end = cfg + count;
+    u64 start, now, ns;
+    u16 val;
+    
+    if (tp->rtk_enable_diag) return;
+    
+    clock_get_uptime(&start);
+    
+    for (; cfg < end; cfg++) {
+        switch (cfg->addr) {
+            case PHY_CFG_CTRL_MCU_PATCH_REQUEST:
+                rtl8125_set_phy_mcu_patch_request(tp);
+                break;
+                
+            case PHY_CFG_CTRL_MCU_PATCH_RELEASE:
+                rtl8125_clear_phy_mcu_patch_request(tp);
+                break;
+                
+            case PHY_CFG_CTRL_IF_RAM_CODE:
+                if (!HW_HAS_WRITE_PHY_MCU_RAM_CODE(tp))
+                    cfg += cfg->setmask;
+                
+                break;
+                
+            default:
+                val = cfg->setmask;
+                
+                if (cfg->clearmask != 0xFFFF)
+                    val |= (mdio_direct_read_phy_ocp(tp, cfg->addr) & ~cfg->clearmask);
+                
+                mdio_real_direct_write_phy_ocp(tp, cfg->addr, val);
+                break;
+        }
+    }
+    clock_get_uptime(&now);
+    absolutetime_to_nanoseconds(now - start, &ns);
+    
+    dprintk("PHY config table: %u entries, %lluµs.\n", count, ns / 1000);
+}
+
+static const u16 phy_mcu_ram_code_8125a_1[] = {
+    0xa436, 0xA016, 0xa438, 0x0000, 0xa436, 0xA012, 0xa438, 0x0000,
+    0xa436, 0xA014, 0xa438, 0x1800, 0xa438, 0x8010, 0xa438, 0x1800,
+    0xa438, 0x8013, 0xa438, 0x1800, 0xa438, 0x8021, 0xa438, 0x1800,
+    0xa438, 0x802f, 0xa438, 0x1800, 0xa438, 0x803d, 0xa438, 0x1800,
+    0xa438, 0x8042, 0xa438, 0x1800, 0xa438, 0x8051, 0xa438, 0x1800,
+    0xa438, 0x8051, 0xa438, 0xa088, 0xa438, 0x1800, 0xa438, 0x0a50,
+    0xa438, 0x8008, 0xa438, 0xd014, 0xa438, 0xd1a3, 0xa438, 0xd700,
+    0xa438, 0x401a, 0xa438, 0xd707, 0xa438, 0x40c2, 0xa438, 0x60a6,
+    0xa438, 0xd700, 0xa438, 0x5f8b, 0xa438, 0x1800, 0xa438, 0x0a86,
+    0xa438, 0x1800, 0xa438, 0x0a6c, 0xa438, 0x8080, 0xa438, 0xd019,
+    0xa438, 0xd1a2, 0xa438, 0xd700, 0xa438, 0x401a, 0xa438, 0xd707,
+    0xa438, 0x40c4, 0xa438, 0x60a6, 0xa438, 0xd700, 0xa438, 0x5f8b,
+    0xa438, 0x1800, 0xa438, 0x0a86, 0xa438, 0x1800, 0xa438, 0x0a84,
+    0xa438, 0xd503, 0xa438, 0x8970, 0xa438, 0x0c07, 0xa438, 0x0901,
+    0xa438, 0xd500, 0xa438, 0xce01, 0xa438, 0xcf09, 0xa438, 0xd705,
+    0xa438, 0x4000, 0xa438, 0xceff, 0xa438, 0xaf0a, 0xa438, 0xd504,
+    0xa438, 0x1800, 0xa438, 0x1213, 0xa438, 0x8401, 0xa438, 0xd500,
+    0xa438, 0x8580, 0xa438, 0x1800, 0xa438, 0x1253, 0xa438, 0xd064,
+    0xa438, 0xd181, 0xa438, 0xd704, 0xa438, 0x4018, 0xa438, 0xd504,
+    0xa438, 0xc50f, 0xa438, 0xd706, 0xa438, 0x2c59, 0xa438, 0x804d,
+    0xa438, 0xc60f, 0xa438, 0xf002, 0xa438, 0xc605, 0xa438, 0xae02,
+    0xa438, 0x1800, 0xa438, 0x10fd, 0xa436, 0xA026, 0xa438, 0xffff,
+    0xa436, 0xA024, 0xa438, 0xffff, 0xa436, 0xA022, 0xa438, 0x10f4,
+    0xa436, 0xA020, 0xa438, 0x1252, 0xa436, 0xA006, 0xa438, 0x1206,
+    0xa436, 0xA004, 0xa438, 0x0a78, 0xa436, 0xA002, 0xa438, 0x0a60,
+    0xa436, 0xA000, 0xa438, 0x0a4f, 0xa436, 0xA008, 0xa438, 0x3f00,
+    0xa436, 0xA016, 0xa438, 0x0010, 0xa436, 0xA012, 0xa438, 0x0000,
+    0xa436, 0xA014, 0xa438, 0x1800, 0xa438, 0x8010, 0xa438, 0x1800,
+    0xa438, 0x8066, 0xa438, 0x1800, 0xa438, 0x807c, 0xa438, 0x1800,
+    0xa438, 0x8089, 0xa438, 0x1800, 0xa438, 0x808e, 0xa438, 0x1800,
+    0xa438, 0x80a0, 0xa438, 0x1800, 0xa438, 0x80b2, 0xa438, 0x1800,
+    0xa438, 0x80c2, 0xa438, 0xd501, 0xa438, 0xce01, 0xa438, 0xd700,
+    0xa438, 0x62db, 0xa438, 0x655c, 0xa438, 0xd73e, 0xa438, 0x60e9,
+    0xa438, 0x614a, 0xa438, 0x61ab, 0xa438, 0x0c0f, 0xa438, 0x0501,
+    0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f, 0xa438, 0x0503,
+    0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f, 0xa438, 0x0505,
+    0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f, 0xa438, 0x0509,
+    0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x653c, 0xa438, 0xd73e,
+    0xa438, 0x60e9, 0xa438, 0x614a, 0xa438, 0x61ab, 0xa438, 0x0c0f,
+    0xa438, 0x0503, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f,
+    0xa438, 0x0502, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f,
+    0xa438, 0x0506, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f,
+    0xa438, 0x050a, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0xd73e,
+    0xa438, 0x60e9, 0xa438, 0x614a, 0xa438, 0x61ab, 0xa438, 0x0c0f,
+    0xa438, 0x0505, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f,
+    0xa438, 0x0506, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f,
+    0xa438, 0x0504, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f,
+    0xa438, 0x050c, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0xd73e,
+    0xa438, 0x60e9, 0xa438, 0x614a, 0xa438, 0x61ab, 0xa438, 0x0c0f,
+    0xa438, 0x0509, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f,
+    0xa438, 0x050a, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f,
+    0xa438, 0x050c, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0x0c0f,
+    0xa438, 0x0508, 0xa438, 0x1800, 0xa438, 0x0304, 0xa438, 0xd501,
+    0xa438, 0xce01, 0xa438, 0xd73e, 0xa438, 0x60e9, 0xa438, 0x614a,
+    0xa438, 0x61ab, 0xa438, 0x0c0f, 0xa438, 0x0501, 0xa438, 0x1800,
+    0xa438, 0x0321, 0xa438, 0x0c0f, 0xa438, 0x0502, 0xa438, 0x1800,
+    0xa438, 0x0321, 0xa438, 0x0c0f, 0xa438, 0x0504, 0xa438, 0x1800,
+    0xa438, 0x0321, 0xa438, 0x0c0f, 0xa438, 0x0508, 0xa438, 0x1800,
+    0xa438, 0x0321, 0xa438, 0x1000, 0xa438, 0x0346, 0xa438, 0xd501,
+    0xa438, 0xce01, 0xa438, 0x8208, 0xa438, 0x609d, 0xa438, 0xa50f,
+    0xa438, 0x1800, 0xa438, 0x001a, 0xa438, 0x0c0f, 0xa438, 0x0503,
+    0xa438, 0x1800, 0xa438, 0x001a, 0xa438, 0x607d, 0xa438, 0x1800,
+    0xa438, 0x00ab, 0xa438, 0x1800, 0xa438, 0x00ab, 0xa438, 0xd501,
+    0xa438, 0xce01, 0xa438, 0xd700, 0xa438, 0x60fd, 0xa438, 0xa50f,
+    0xa438, 0xce00, 0xa438, 0xd500, 0xa438, 0xaa0f, 0xa438, 0x1800,
+    0xa438, 0x017b, 0xa438, 0x0c0f, 0xa438, 0x0503, 0xa438, 0xce00,
+    0xa438, 0xd500, 0xa438, 0x0c0f, 0xa438, 0x0a05, 0xa438, 0x1800,
+    0xa438, 0x017b, 0xa438, 0xd501, 0xa438, 0xce01, 0xa438, 0xd700,
+    0xa438, 0x60fd, 0xa438, 0xa50f, 0xa438, 0xce00, 0xa438, 0xd500,
+    0xa438, 0xaa0f, 0xa438, 0x1800, 0xa438, 0x01e0, 0xa438, 0x0c0f,
+    0xa438, 0x0503, 0xa438, 0xce00, 0xa438, 0xd500, 0xa438, 0x0c0f,
+    0xa438, 0x0a05, 0xa438, 0x1800, 0xa438, 0x01e0, 0xa438, 0xd700,
+    0xa438, 0x60fd, 0xa438, 0xa50f, 0xa438, 0xce00, 0xa438, 0xd500,
+    0xa438, 0xaa0f, 0xa438, 0x1800, 0xa438, 0x0231, 0xa438, 0x0c0f,
+    0xa438, 0x0503, 0xa438, 0xce00, 0xa438, 0xd500, 0xa438, 0x0c0f,
+    0xa438, 0x0a05, 0xa438, 0x1800, 0xa438, 0x0231, 0xa436, 0xA08E,
+    0xa438, 0xffff, 0xa436, 0xA08C, 0xa438, 0x0221, 0xa436, 0xA08A,
+    0xa438, 0x01ce, 0xa436, 0xA088, 0xa438, 0x0169, 0xa436, 0xA086,
+    0xa438, 0x00a6, 0xa436, 0xA084, 0xa438, 0x000d, 0xa436, 0xA082,
+    0xa438, 0x0308, 0xa436, 0xA080, 0xa438, 0x029f, 0xa436, 0xA090,
+    0xa438, 0x007f, 0xa436, 0xA016, 0xa438, 0x0020, 0xa436, 0xA012,
+    0xa438, 0x0000, 0xa436, 0xA014, 0xa438, 0x1800, 0xa438, 0x8010,
+    0xa438, 0x1800, 0xa438, 0x8017, 0xa438, 0x1800, 0xa438, 0x801b,
+    0xa438, 0x1800, 0xa438, 0x8029, 0xa438, 0x1800, 0xa438, 0x8054,
+    0xa438, 0x1800, 0xa438, 0x805a, 0xa438, 0x1800, 0xa438, 0x8064,
+    0xa438, 0x1800, 0xa438, 0x80a7, 0xa438, 0x9430, 0xa438, 0x9480,
+    0xa438, 0xb408, 0xa438, 0xd120, 0xa438, 0xd057, 0xa438, 0x1800,
+    0xa438, 0x064b, 0xa438, 0xcb80, 0xa438, 0x9906, 0xa438, 0x1800,
+    0xa438, 0x0567, 0xa438, 0xcb94, 0xa438, 0x8190, 0xa438, 0x82a0,
+    0xa438, 0x800a, 0xa438, 0x8406, 0xa438, 0x8010, 0xa438, 0xa740,
+    0xa438, 0x8dff, 0xa438, 0x1000, 0xa438, 0x07e4, 0xa438, 0xa840,
+    0xa438, 0x0000, 0xa438, 0x1800, 0xa438, 0x0773, 0xa438, 0xcb91,
+    0xa438, 0x0000, 0xa438, 0xd700, 0xa438, 0x4063, 0xa438, 0xd139,
+    0xa438, 0xf002, 0xa438, 0xd140, 0xa438, 0xd040, 0xa438, 0xb404,
+    0xa438, 0x0c0f, 0xa438, 0x0d00, 0xa438, 0x1000, 0xa438, 0x07dc,
+    0xa438, 0xa610, 0xa438, 0xa110, 0xa438, 0xa2a0, 0xa438, 0xa404,
+    0xa438, 0xd704, 0xa438, 0x4045, 0xa438, 0xa180, 0xa438, 0xd704,
+    0xa438, 0x405d, 0xa438, 0xa720, 0xa438, 0x1000, 0xa438, 0x0742,
+    0xa438, 0x1000, 0xa438, 0x07ec, 0xa438, 0xd700, 0xa438, 0x5f74,
+    0xa438, 0x1000, 0xa438, 0x0742, 0xa438, 0xd702, 0xa438, 0x7fb6,
+    0xa438, 0x8190, 0xa438, 0x82a0, 0xa438, 0x8404, 0xa438, 0x8610,
+    0xa438, 0x0c0f, 0xa438, 0x0d01, 0xa438, 0x1000, 0xa438, 0x07dc,
+    0xa438, 0x1800, 0xa438, 0x064b, 0xa438, 0x1000, 0xa438, 0x07c0,
+    0xa438, 0xd700, 0xa438, 0x5fa7, 0xa438, 0x1800, 0xa438, 0x0481,
+    0xa438, 0x0000, 0xa438, 0x94bc, 0xa438, 0x870c, 0xa438, 0xa190,
+    0xa438, 0xa00a, 0xa438, 0xa280, 0xa438, 0xa404, 0xa438, 0x8220,
+    0xa438, 0x1800, 0xa438, 0x078e, 0xa438, 0xcb92, 0xa438, 0xa840,
+    0xa438, 0xd700, 0xa438, 0x4063, 0xa438, 0xd140, 0xa438, 0xf002,
+    0xa438, 0xd150, 0xa438, 0xd040, 0xa438, 0xd703, 0xa438, 0x60a0,
+    0xa438, 0x6121, 0xa438, 0x61a2, 0xa438, 0x6223, 0xa438, 0xf02f,
+    0xa438, 0x0cf0, 0xa438, 0x0d10, 0xa438, 0x8010, 0xa438, 0xa740,
+    0xa438, 0xf00f, 0xa438, 0x0cf0, 0xa438, 0x0d20, 0xa438, 0x8010,
+    0xa438, 0xa740, 0xa438, 0xf00a, 0xa438, 0x0cf0, 0xa438, 0x0d30,
+    0xa438, 0x8010, 0xa438, 0xa740, 0xa438, 0xf005, 0xa438, 0x0cf0,
+    0xa438, 0x0d40, 0xa438, 0x8010, 0xa438, 0xa740, 0xa438, 0x1000,
+    0xa438, 0x07e4, 0xa438, 0xa610, 0xa438, 0xa008, 0xa438, 0xd704,
+    0xa438, 0x4046, 0xa438, 0xa002, 0xa438, 0xd704, 0xa438, 0x405d,
+    0xa438, 0xa720, 0xa438, 0x1000, 0xa438, 0x0742, 0xa438, 0x1000,
+    0xa438, 0x07f7, 0xa438, 0xd700, 0xa438, 0x5f74, 0xa438, 0x1000,
+    0xa438, 0x0742, 0xa438, 0xd702, 0xa438, 0x7fb5, 0xa438, 0x800a,
+    0xa438, 0x0cf0, 0xa438, 0x0d00, 0xa438, 0x1000, 0xa438, 0x07e4,
+    0xa438, 0x8010, 0xa438, 0xa740, 0xa438, 0xd701, 0xa438, 0x3ad4,
+    0xa438, 0x0537, 0xa438, 0x8610, 0xa438, 0x8840, 0xa438, 0x1800,
+    0xa438, 0x064b, 0xa438, 0x8301, 0xa438, 0x800a, 0xa438, 0x8190,
+    0xa438, 0x82a0, 0xa438, 0x8404, 0xa438, 0xa70c, 0xa438, 0x9402,
+    0xa438, 0x890c, 0xa438, 0x8840, 0xa438, 0x1800, 0xa438, 0x064b,
+    0xa436, 0xA10E, 0xa438, 0x0642, 0xa436, 0xA10C, 0xa438, 0x0686,
+    0xa436, 0xA10A, 0xa438, 0x0788, 0xa436, 0xA108, 0xa438, 0x047b,
+    0xa436, 0xA106, 0xa438, 0x065c, 0xa436, 0xA104, 0xa438, 0x0769,
+    0xa436, 0xA102, 0xa438, 0x0565, 0xa436, 0xA100, 0xa438, 0x06f9,
+    0xa436, 0xA110, 0xa438, 0x00ff, 0xa436, 0xb87c, 0xa438, 0x8530,
+    0xa436, 0xb87e, 0xa438, 0xaf85, 0xa438, 0x3caf, 0xa438, 0x8593,
+    0xa438, 0xaf85, 0xa438, 0x9caf, 0xa438, 0x85a5, 0xa438, 0xbf86,
+    0xa438, 0xd702, 0xa438, 0x5afb, 0xa438, 0xe083, 0xa438, 0xfb0c,
+    0xa438, 0x020d, 0xa438, 0x021b, 0xa438, 0x10bf, 0xa438, 0x86d7,
+    0xa438, 0x025a, 0xa438, 0xb7bf, 0xa438, 0x86da, 0xa438, 0x025a,
+    0xa438, 0xfbe0, 0xa438, 0x83fc, 0xa438, 0x0c02, 0xa438, 0x0d02,
+    0xa438, 0x1b10, 0xa438, 0xbf86, 0xa438, 0xda02, 0xa438, 0x5ab7,
+    0xa438, 0xbf86, 0xa438, 0xdd02, 0xa438, 0x5afb, 0xa438, 0xe083,
+    0xa438, 0xfd0c, 0xa438, 0x020d, 0xa438, 0x021b, 0xa438, 0x10bf,
+    0xa438, 0x86dd, 0xa438, 0x025a, 0xa438, 0xb7bf, 0xa438, 0x86e0,
+    0xa438, 0x025a, 0xa438, 0xfbe0, 0xa438, 0x83fe, 0xa438, 0x0c02,
+    0xa438, 0x0d02, 0xa438, 0x1b10, 0xa438, 0xbf86, 0xa438, 0xe002,
+    0xa438, 0x5ab7, 0xa438, 0xaf2f, 0xa438, 0xbd02, 0xa438, 0x2cac,
+    0xa438, 0x0286, 0xa438, 0x65af, 0xa438, 0x212b, 0xa438, 0x022c,
+    0xa438, 0x6002, 0xa438, 0x86b6, 0xa438, 0xaf21, 0xa438, 0x0cd1,
+    0xa438, 0x03bf, 0xa438, 0x8710, 0xa438, 0x025a, 0xa438, 0xb7bf,
+    0xa438, 0x870d, 0xa438, 0x025a, 0xa438, 0xb7bf, 0xa438, 0x8719,
+    0xa438, 0x025a, 0xa438, 0xb7bf, 0xa438, 0x8716, 0xa438, 0x025a,
+    0xa438, 0xb7bf, 0xa438, 0x871f, 0xa438, 0x025a, 0xa438, 0xb7bf,
+    0xa438, 0x871c, 0xa438, 0x025a, 0xa438, 0xb7bf, 0xa438, 0x8728,
+    0xa438, 0x025a, 0xa438, 0xb7bf, 0xa438, 0x8725, 0xa438, 0x025a,
+    0xa438, 0xb7bf, 0xa438, 0x8707, 0xa438, 0x025a, 0xa438, 0xfbad,
+    0xa438, 0x281c, 0xa438, 0xd100, 0xa438, 0xbf87, 0xa438, 0x0a02,
+    0xa438, 0x5ab7, 0xa438, 0xbf87, 0xa438, 0x1302, 0xa438, 0x5ab7,
+    0xa438, 0xbf87, 0xa438, 0x2202, 0xa438, 0x5ab7, 0xa438, 0xbf87,
+    0xa438, 0x2b02, 0xa438, 0x5ab7, 0xa438, 0xae1a, 0xa438, 0xd101,
+    0xa438, 0xbf87, 0xa438, 0x0a02, 0xa438, 0x5ab7, 0xa438, 0xbf87,
+    0xa438, 0x1302, 0xa438, 0x5ab7, 0xa438, 0xbf87, 0xa438, 0x2202,
+    0xa438, 0x5ab7, 0xa438, 0xbf87, 0xa438, 0x2b02, 0xa438, 0x5ab7,
+    0xa438, 0xd101, 0xa438, 0xbf87, 0xa438, 0x3402, 0xa438, 0x5ab7,
+    0xa438, 0xbf87, 0xa438, 0x3102, 0xa438, 0x5ab7, 0xa438, 0xbf87,
+    0xa438, 0x3d02, 0xa438, 0x5ab7, 0xa438, 0xbf87, 0xa438, 0x3a02,
+    0xa438, 0x5ab7, 0xa438, 0xbf87, 0xa438, 0x4302, 0xa438, 0x5ab7,
+    0xa438, 0xbf87, 0xa438, 0x4002, 0xa438, 0x5ab7, 0xa438, 0xbf87,
+    0xa438, 0x4c02, 0xa438, 0x5ab7, 0xa438, 0xbf87, 0xa438, 0x4902,
+    0xa438, 0x5ab7, 0xa438, 0xd100, 0xa438, 0xbf87, 0xa438, 0x2e02,
+    0xa438, 0x5ab7, 0xa438, 0xbf87, 0xa438, 0x3702, 0xa438, 0x5ab7,
+    0xa438, 0xbf87, 0xa438, 0x4602, 0xa438, 0x5ab7, 0xa438, 0xbf87,
+    0xa438, 0x4f02, 0xa438, 0x5ab7, 0xa438, 0xaf35, 0xa438, 0x7ff8,
+    0xa438, 0xfaef, 0xa438, 0x69bf, 0xa438, 0x86e3, 0xa438, 0x025a,
+    0xa438, 0xfbbf, 0xa438, 0x86fb, 0xa438, 0x025a, 0xa438, 0xb7bf,
+    0xa438, 0x86e6, 0xa438, 0x025a, 0xa438, 0xfbbf, 0xa438, 0x86fe,
+    0xa438, 0x025a, 0xa438, 0xb7bf, 0xa438, 0x86e9, 0xa438, 0x025a,
+    0xa438, 0xfbbf, 0xa438, 0x8701, 0xa438, 0x025a, 0xa438, 0xb7bf,
+    0xa438, 0x86ec, 0xa438, 0x025a, 0xa438, 0xfbbf, 0xa438, 0x8704,
+    0xa438, 0x025a, 0xa438, 0xb7bf, 0xa438, 0x86ef, 0xa438, 0x0262,
+    0xa438, 0x7cbf, 0xa438, 0x86f2, 0xa438, 0x0262, 0xa438, 0x7cbf,
+    0xa438, 0x86f5, 0xa438, 0x0262, 0xa438, 0x7cbf, 0xa438, 0x86f8,
+    0xa438, 0x0262, 0xa438, 0x7cef, 0xa438, 0x96fe, 0xa438, 0xfc04,
+    0xa438, 0xf8fa, 0xa438, 0xef69, 0xa438, 0xbf86, 0xa438, 0xef02,
+    0xa438, 0x6273, 0xa438, 0xbf86, 0xa438, 0xf202, 0xa438, 0x6273,
+    0xa438, 0xbf86, 0xa438, 0xf502, 0xa438, 0x6273, 0xa438, 0xbf86,
+    0xa438, 0xf802, 0xa438, 0x6273, 0xa438, 0xef96, 0xa438, 0xfefc,
+    0xa438, 0x0420, 0xa438, 0xb540, 0xa438, 0x53b5, 0xa438, 0x4086,
+    0xa438, 0xb540, 0xa438, 0xb9b5, 0xa438, 0x40c8, 0xa438, 0xb03a,
+    0xa438, 0xc8b0, 0xa438, 0xbac8, 0xa438, 0xb13a, 0xa438, 0xc8b1,
+    0xa438, 0xba77, 0xa438, 0xbd26, 0xa438, 0xffbd, 0xa438, 0x2677,
+    0xa438, 0xbd28, 0xa438, 0xffbd, 0xa438, 0x2840, 0xa438, 0xbd26,
+    0xa438, 0xc8bd, 0xa438, 0x2640, 0xa438, 0xbd28, 0xa438, 0xc8bd,
+    0xa438, 0x28bb, 0xa438, 0xa430, 0xa438, 0x98b0, 0xa438, 0x1eba,
+    0xa438, 0xb01e, 0xa438, 0xdcb0, 0xa438, 0x1e98, 0xa438, 0xb09e,
+    0xa438, 0xbab0, 0xa438, 0x9edc, 0xa438, 0xb09e, 0xa438, 0x98b1,
+    0xa438, 0x1eba, 0xa438, 0xb11e, 0xa438, 0xdcb1, 0xa438, 0x1e98,
+    0xa438, 0xb19e, 0xa438, 0xbab1, 0xa438, 0x9edc, 0xa438, 0xb19e,
+    0xa438, 0x11b0, 0xa438, 0x1e22, 0xa438, 0xb01e, 0xa438, 0x33b0,
+    0xa438, 0x1e11, 0xa438, 0xb09e, 0xa438, 0x22b0, 0xa438, 0x9e33,
+    0xa438, 0xb09e, 0xa438, 0x11b1, 0xa438, 0x1e22, 0xa438, 0xb11e,
+    0xa438, 0x33b1, 0xa438, 0x1e11, 0xa438, 0xb19e, 0xa438, 0x22b1,
+    0xa438, 0x9e33, 0xa438, 0xb19e, 0xa436, 0xb85e, 0xa438, 0x2f71,
+    0xa436, 0xb860, 0xa438, 0x20d9, 0xa436, 0xb862, 0xa438, 0x2109,
+    0xa436, 0xb864, 0xa438, 0x34e7, 0xa436, 0xb878, 0xa438, 0x000f,
+    0xFFFF, 0xFFFF
+};
+
 static void
 rtl8125_real_set_phy_mcu_8125a_1(struct net_device *dev)
 {
@@ -6062,820 +6397,10 @@ rtl8125_real_set_phy_mcu_8125a_1(struct net_device *dev)
     SetEthPhyOcpBit(tp, 0xB820, BIT_7);
     
     
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA016);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA012);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA014);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8013);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8021);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x802f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x803d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8042);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8051);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8051);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa088);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a50);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8008);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd014);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd1a3);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x401a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd707);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x40c2);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60a6);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5f8b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a86);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a6c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8080);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd019);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd1a2);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x401a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd707);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x40c4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60a6);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5f8b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a86);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a84);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd503);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8970);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c07);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0901);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xcf09);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd705);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xceff);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaf0a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1213);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8401);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8580);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1253);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd064);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd181);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd704);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4018);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xc50f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd706);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2c59);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x804d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xc60f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xc605);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xae02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x10fd);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA026);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA024);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA022);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x10f4);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA020);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1252);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA006);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1206);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA004);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a78);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a60);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a4f);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA008);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x3f00);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA016);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0010);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA012);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA014);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8066);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x807c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8089);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x808e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x80a0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x80b2);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x80c2);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x62db);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x655c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd73e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60e9);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x614a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x61ab);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0503);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0505);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0509);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x653c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd73e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60e9);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x614a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x61ab);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0503);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0502);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0506);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x050a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd73e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60e9);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x614a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x61ab);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0505);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0506);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x050c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd73e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60e9);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x614a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x61ab);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0509);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x050a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x050c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0508);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0304);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd73e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60e9);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x614a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x61ab);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0321);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0502);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0321);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0321);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0508);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0321);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0346);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8208);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x609d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa50f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x001a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0503);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x001a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x607d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00ab);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00ab);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60fd);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa50f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaa0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x017b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0503);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a05);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x017b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60fd);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa50f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaa0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x01e0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0503);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a05);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x01e0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60fd);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa50f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaa0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0231);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0503);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a05);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0231);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA08E);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA08C);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0221);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA08A);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x01ce);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA088);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0169);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA086);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00a6);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA084);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x000d);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA082);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0308);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA080);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x029f);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA090);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x007f);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA016);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0020);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA012);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA014);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8017);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x801b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8029);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8054);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x805a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8064);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x80a7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x9430);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x9480);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb408);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd120);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd057);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x064b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xcb80);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x9906);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0567);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xcb94);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8190);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x82a0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x800a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8406);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8dff);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07e4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa840);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0773);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xcb91);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4063);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd139);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd140);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd040);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb404);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07dc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa610);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa110);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa2a0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa404);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd704);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4045);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa180);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd704);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x405d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa720);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0742);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07ec);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5f74);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0742);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd702);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7fb6);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8190);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x82a0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8404);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8610);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07dc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x064b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07c0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5fa7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0481);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x94bc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x870c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa190);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa00a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa280);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa404);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8220);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x078e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xcb92);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa840);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4063);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd140);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd150);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd040);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd703);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60a0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6121);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x61a2);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6223);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf02f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d10);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf00f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d20);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf00a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d30);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf005);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d40);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07e4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa610);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa008);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd704);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4046);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd704);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x405d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa720);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0742);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07f7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5f74);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0742);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd702);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7fb5);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x800a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07e4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x3ad4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0537);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8610);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8840);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x064b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8301);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x800a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8190);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x82a0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8404);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa70c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x9402);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x890c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8840);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x064b);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA10E);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0642);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA10C);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0686);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA10A);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0788);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA108);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x047b);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA106);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x065c);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA104);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0769);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA102);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0565);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA100);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x06f9);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA110);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00ff);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb87c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8530);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb87e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaf85);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x3caf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8593);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaf85);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x9caf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x85a5);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf86);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd702);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5afb);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xe083);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfb0c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x020d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x021b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x10bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86d7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86da);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfbe0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x83fc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1b10);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf86);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xda02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf86);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xdd02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5afb);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xe083);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfd0c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x020d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x021b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x10bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86dd);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86e0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfbe0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x83fe);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1b10);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf86);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xe002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaf2f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbd02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2cac);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0286);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x65af);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x212b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x022c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86b6);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaf21);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cd1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x03bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8710);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x870d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8719);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8716);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x871f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x871c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8728);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8725);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8707);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfbad);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x281c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd100);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1302);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2202);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2b02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xae1a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd101);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1302);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2202);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2b02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd101);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x3402);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x3102);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x3d02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x3a02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4302);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4c02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4902);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd100);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2e02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x3702);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4602);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf87);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4f02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ab7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaf35);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7ff8);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfaef);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x69bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86e3);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfbbf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86fb);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86e6);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfbbf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86fe);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86e9);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfbbf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86ec);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfbbf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8704);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x025a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7bf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86ef);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0262);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7cbf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86f2);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0262);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7cbf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86f5);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0262);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7cbf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x86f8);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0262);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7cef);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x96fe);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfc04);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf8fa);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xef69);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf86);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xef02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6273);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf86);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf202);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6273);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf86);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf502);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6273);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbf86);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf802);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6273);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xef96);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfefc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0420);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb540);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x53b5);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4086);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb540);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb9b5);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x40c8);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb03a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xc8b0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbac8);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb13a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xc8b1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xba77);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbd26);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffbd);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2677);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbd28);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffbd);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2840);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbd26);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xc8bd);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2640);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbd28);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xc8bd);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x28bb);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa430);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x98b0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1eba);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb01e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xdcb0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1e98);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb09e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbab0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x9edc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb09e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x98b1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1eba);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb11e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xdcb1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1e98);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb19e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbab1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x9edc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb19e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x11b0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1e22);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb01e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x33b0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1e11);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb09e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x22b0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x9e33);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb09e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x11b1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1e22);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb11e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x33b1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1e11);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb19e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x22b1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x9e33);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb19e);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb85e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2f71);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb860);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x20d9);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb862);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x2109);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb864);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x34e7);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb878);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x000f);
+    rtl8125_set_phy_mcu_ram_code(dev,
+                                 phy_mcu_ram_code_8125a_1,
+                                 ARRAY_SIZE(phy_mcu_ram_code_8125a_1)
+                                 );
     
     
     ClearEthPhyOcpBit(tp, 0xB820, BIT_7);
@@ -6896,6 +6421,147 @@ rtl8125_set_phy_mcu_8125a_1(struct net_device *dev)
     rtl8125_clear_phy_mcu_patch_request(tp);
 }
 
+static const u16 phy_mcu_ram_code_8125a_2[] = {
+    0xa436, 0xA016, 0xa438, 0x0000, 0xa436, 0xA012, 0xa438, 0x0000,
+    0xa436, 0xA014, 0xa438, 0x1800, 0xa438, 0x8010, 0xa438, 0x1800,
+    0xa438, 0x808b, 0xa438, 0x1800, 0xa438, 0x808f, 0xa438, 0x1800,
+    0xa438, 0x8093, 0xa438, 0x1800, 0xa438, 0x8097, 0xa438, 0x1800,
+    0xa438, 0x809d, 0xa438, 0x1800, 0xa438, 0x80a1, 0xa438, 0x1800,
+    0xa438, 0x80aa, 0xa438, 0xd718, 0xa438, 0x607b, 0xa438, 0x40da,
+    0xa438, 0xf00e, 0xa438, 0x42da, 0xa438, 0xf01e, 0xa438, 0xd718,
+    0xa438, 0x615b, 0xa438, 0x1000, 0xa438, 0x1456, 0xa438, 0x1000,
+    0xa438, 0x14a4, 0xa438, 0x1000, 0xa438, 0x14bc, 0xa438, 0xd718,
+    0xa438, 0x5f2e, 0xa438, 0xf01c, 0xa438, 0x1000, 0xa438, 0x1456,
+    0xa438, 0x1000, 0xa438, 0x14a4, 0xa438, 0x1000, 0xa438, 0x14bc,
+    0xa438, 0xd718, 0xa438, 0x5f2e, 0xa438, 0xf024, 0xa438, 0x1000,
+    0xa438, 0x1456, 0xa438, 0x1000, 0xa438, 0x14a4, 0xa438, 0x1000,
+    0xa438, 0x14bc, 0xa438, 0xd718, 0xa438, 0x5f2e, 0xa438, 0xf02c,
+    0xa438, 0x1000, 0xa438, 0x1456, 0xa438, 0x1000, 0xa438, 0x14a4,
+    0xa438, 0x1000, 0xa438, 0x14bc, 0xa438, 0xd718, 0xa438, 0x5f2e,
+    0xa438, 0xf034, 0xa438, 0xd719, 0xa438, 0x4118, 0xa438, 0xd504,
+    0xa438, 0xac11, 0xa438, 0xd501, 0xa438, 0xce01, 0xa438, 0xa410,
+    0xa438, 0xce00, 0xa438, 0xd500, 0xa438, 0x4779, 0xa438, 0xd504,
+    0xa438, 0xac0f, 0xa438, 0xae01, 0xa438, 0xd500, 0xa438, 0x1000,
+    0xa438, 0x1444, 0xa438, 0xf034, 0xa438, 0xd719, 0xa438, 0x4118,
+    0xa438, 0xd504, 0xa438, 0xac22, 0xa438, 0xd501, 0xa438, 0xce01,
+    0xa438, 0xa420, 0xa438, 0xce00, 0xa438, 0xd500, 0xa438, 0x4559,
+    0xa438, 0xd504, 0xa438, 0xac0f, 0xa438, 0xae01, 0xa438, 0xd500,
+    0xa438, 0x1000, 0xa438, 0x1444, 0xa438, 0xf023, 0xa438, 0xd719,
+    0xa438, 0x4118, 0xa438, 0xd504, 0xa438, 0xac44, 0xa438, 0xd501,
+    0xa438, 0xce01, 0xa438, 0xa440, 0xa438, 0xce00, 0xa438, 0xd500,
+    0xa438, 0x4339, 0xa438, 0xd504, 0xa438, 0xac0f, 0xa438, 0xae01,
+    0xa438, 0xd500, 0xa438, 0x1000, 0xa438, 0x1444, 0xa438, 0xf012,
+    0xa438, 0xd719, 0xa438, 0x4118, 0xa438, 0xd504, 0xa438, 0xac88,
+    0xa438, 0xd501, 0xa438, 0xce01, 0xa438, 0xa480, 0xa438, 0xce00,
+    0xa438, 0xd500, 0xa438, 0x4119, 0xa438, 0xd504, 0xa438, 0xac0f,
+    0xa438, 0xae01, 0xa438, 0xd500, 0xa438, 0x1000, 0xa438, 0x1444,
+    0xa438, 0xf001, 0xa438, 0x1000, 0xa438, 0x1456, 0xa438, 0xd718,
+    0xa438, 0x5fac, 0xa438, 0xc48f, 0xa438, 0x1000, 0xa438, 0x141b,
+    0xa438, 0xd504, 0xa438, 0x8010, 0xa438, 0x1800, 0xa438, 0x121a,
+    0xa438, 0xd0b4, 0xa438, 0xd1bb, 0xa438, 0x1800, 0xa438, 0x0898,
+    0xa438, 0xd0b4, 0xa438, 0xd1bb, 0xa438, 0x1800, 0xa438, 0x0a0e,
+    0xa438, 0xd064, 0xa438, 0xd18a, 0xa438, 0x1800, 0xa438, 0x0b7e,
+    0xa438, 0x401c, 0xa438, 0xd501, 0xa438, 0xa804, 0xa438, 0x8804,
+    0xa438, 0x1800, 0xa438, 0x053b, 0xa438, 0xd500, 0xa438, 0xa301,
+    0xa438, 0x1800, 0xa438, 0x0648, 0xa438, 0xc520, 0xa438, 0xa201,
+    0xa438, 0xd701, 0xa438, 0x252d, 0xa438, 0x1646, 0xa438, 0xd708,
+    0xa438, 0x4006, 0xa438, 0x1800, 0xa438, 0x1646, 0xa438, 0x1800,
+    0xa438, 0x0308, 0xa436, 0xA026, 0xa438, 0x0307, 0xa436, 0xA024,
+    0xa438, 0x1645, 0xa436, 0xA022, 0xa438, 0x0647, 0xa436, 0xA020,
+    0xa438, 0x053a, 0xa436, 0xA006, 0xa438, 0x0b7c, 0xa436, 0xA004,
+    0xa438, 0x0a0c, 0xa436, 0xA002, 0xa438, 0x0896, 0xa436, 0xA000,
+    0xa438, 0x11a1, 0xa436, 0xA008, 0xa438, 0xff00, 0xa436, 0xA016,
+    0xa438, 0x0010, 0xa436, 0xA012, 0xa438, 0x0000, 0xa436, 0xA014,
+    0xa438, 0x1800, 0xa438, 0x8010, 0xa438, 0x1800, 0xa438, 0x8015,
+    0xa438, 0x1800, 0xa438, 0x801a, 0xa438, 0x1800, 0xa438, 0x801a,
+    0xa438, 0x1800, 0xa438, 0x801a, 0xa438, 0x1800, 0xa438, 0x801a,
+    0xa438, 0x1800, 0xa438, 0x801a, 0xa438, 0x1800, 0xa438, 0x801a,
+    0xa438, 0xad02, 0xa438, 0x1000, 0xa438, 0x02d7, 0xa438, 0x1800,
+    0xa438, 0x00ed, 0xa438, 0x0c0f, 0xa438, 0x0509, 0xa438, 0xc100,
+    0xa438, 0x1800, 0xa438, 0x008f, 0xa436, 0xA08E, 0xa438, 0xffff,
+    0xa436, 0xA08C, 0xa438, 0xffff, 0xa436, 0xA08A, 0xa438, 0xffff,
+    0xa436, 0xA088, 0xa438, 0xffff, 0xa436, 0xA086, 0xa438, 0xffff,
+    0xa436, 0xA084, 0xa438, 0xffff, 0xa436, 0xA082, 0xa438, 0x008d,
+    0xa436, 0xA080, 0xa438, 0x00eb, 0xa436, 0xA090, 0xa438, 0x0103,
+    0xa436, 0xA016, 0xa438, 0x0020, 0xa436, 0xA012, 0xa438, 0x0000,
+    0xa436, 0xA014, 0xa438, 0x1800, 0xa438, 0x8010, 0xa438, 0x1800,
+    0xa438, 0x8014, 0xa438, 0x1800, 0xa438, 0x8018, 0xa438, 0x1800,
+    0xa438, 0x8024, 0xa438, 0x1800, 0xa438, 0x8051, 0xa438, 0x1800,
+    0xa438, 0x8055, 0xa438, 0x1800, 0xa438, 0x8072, 0xa438, 0x1800,
+    0xa438, 0x80dc, 0xa438, 0x0000, 0xa438, 0x0000, 0xa438, 0x0000,
+    0xa438, 0xfffd, 0xa438, 0x0000, 0xa438, 0x0000, 0xa438, 0x0000,
+    0xa438, 0xfffd, 0xa438, 0x8301, 0xa438, 0x800a, 0xa438, 0x8190,
+    0xa438, 0x82a0, 0xa438, 0x8404, 0xa438, 0xa70c, 0xa438, 0x9402,
+    0xa438, 0x890c, 0xa438, 0x8840, 0xa438, 0xa380, 0xa438, 0x1800,
+    0xa438, 0x066e, 0xa438, 0xcb91, 0xa438, 0xd700, 0xa438, 0x4063,
+    0xa438, 0xd139, 0xa438, 0xf002, 0xa438, 0xd140, 0xa438, 0xd040,
+    0xa438, 0xb404, 0xa438, 0x0c0f, 0xa438, 0x0d00, 0xa438, 0x1000,
+    0xa438, 0x07e0, 0xa438, 0xa610, 0xa438, 0xa110, 0xa438, 0xa2a0,
+    0xa438, 0xa404, 0xa438, 0xd704, 0xa438, 0x4085, 0xa438, 0xa180,
+    0xa438, 0xa404, 0xa438, 0x8280, 0xa438, 0xd704, 0xa438, 0x405d,
+    0xa438, 0xa720, 0xa438, 0x1000, 0xa438, 0x0743, 0xa438, 0x1000,
+    0xa438, 0x07f0, 0xa438, 0xd700, 0xa438, 0x5f74, 0xa438, 0x1000,
+    0xa438, 0x0743, 0xa438, 0xd702, 0xa438, 0x7fb6, 0xa438, 0x8190,
+    0xa438, 0x82a0, 0xa438, 0x8404, 0xa438, 0x8610, 0xa438, 0x0000,
+    0xa438, 0x0c0f, 0xa438, 0x0d01, 0xa438, 0x1000, 0xa438, 0x07e0,
+    0xa438, 0x1800, 0xa438, 0x066e, 0xa438, 0xd158, 0xa438, 0xd04d,
+    0xa438, 0x1800, 0xa438, 0x03d4, 0xa438, 0x94bc, 0xa438, 0x870c,
+    0xa438, 0x8380, 0xa438, 0xd10d, 0xa438, 0xd040, 0xa438, 0x1000,
+    0xa438, 0x07c4, 0xa438, 0xd700, 0xa438, 0x5fb4, 0xa438, 0xa190,
+    0xa438, 0xa00a, 0xa438, 0xa280, 0xa438, 0xa404, 0xa438, 0xa220,
+    0xa438, 0xd130, 0xa438, 0xd040, 0xa438, 0x1000, 0xa438, 0x07c4,
+    0xa438, 0xd700, 0xa438, 0x5fb4, 0xa438, 0xbb80, 0xa438, 0xd1c4,
+    0xa438, 0xd074, 0xa438, 0xa301, 0xa438, 0xd704, 0xa438, 0x604b,
+    0xa438, 0xa90c, 0xa438, 0x1800, 0xa438, 0x0556, 0xa438, 0xcb92,
+    0xa438, 0xd700, 0xa438, 0x4063, 0xa438, 0xd116, 0xa438, 0xf002,
+    0xa438, 0xd119, 0xa438, 0xd040, 0xa438, 0xd703, 0xa438, 0x60a0,
+    0xa438, 0x6241, 0xa438, 0x63e2, 0xa438, 0x6583, 0xa438, 0xf054,
+    0xa438, 0xd701, 0xa438, 0x611e, 0xa438, 0xd701, 0xa438, 0x40da,
+    0xa438, 0x0cf0, 0xa438, 0x0d10, 0xa438, 0xa010, 0xa438, 0x8740,
+    0xa438, 0xf02f, 0xa438, 0x0cf0, 0xa438, 0x0d50, 0xa438, 0x8010,
+    0xa438, 0xa740, 0xa438, 0xf02a, 0xa438, 0xd701, 0xa438, 0x611e,
+    0xa438, 0xd701, 0xa438, 0x40da, 0xa438, 0x0cf0, 0xa438, 0x0d20,
+    0xa438, 0xa010, 0xa438, 0x8740, 0xa438, 0xf021, 0xa438, 0x0cf0,
+    0xa438, 0x0d60, 0xa438, 0x8010, 0xa438, 0xa740, 0xa438, 0xf01c,
+    0xa438, 0xd701, 0xa438, 0x611e, 0xa438, 0xd701, 0xa438, 0x40da,
+    0xa438, 0x0cf0, 0xa438, 0x0d30, 0xa438, 0xa010, 0xa438, 0x8740,
+    0xa438, 0xf013, 0xa438, 0x0cf0, 0xa438, 0x0d70, 0xa438, 0x8010,
+    0xa438, 0xa740, 0xa438, 0xf00e, 0xa438, 0xd701, 0xa438, 0x611e,
+    0xa438, 0xd701, 0xa438, 0x40da, 0xa438, 0x0cf0, 0xa438, 0x0d40,
+    0xa438, 0xa010, 0xa438, 0x8740, 0xa438, 0xf005, 0xa438, 0x0cf0,
+    0xa438, 0x0d80, 0xa438, 0x8010, 0xa438, 0xa740, 0xa438, 0x1000,
+    0xa438, 0x07e8, 0xa438, 0xa610, 0xa438, 0xd704, 0xa438, 0x405d,
+    0xa438, 0xa720, 0xa438, 0xd700, 0xa438, 0x5ff4, 0xa438, 0xa008,
+    0xa438, 0xd704, 0xa438, 0x4046, 0xa438, 0xa002, 0xa438, 0x1000,
+    0xa438, 0x0743, 0xa438, 0x1000, 0xa438, 0x07fb, 0xa438, 0xd703,
+    0xa438, 0x7f6f, 0xa438, 0x7f4e, 0xa438, 0x7f2d, 0xa438, 0x7f0c,
+    0xa438, 0x800a, 0xa438, 0x0cf0, 0xa438, 0x0d00, 0xa438, 0x1000,
+    0xa438, 0x07e8, 0xa438, 0x8010, 0xa438, 0xa740, 0xa438, 0x1000,
+    0xa438, 0x0743, 0xa438, 0xd702, 0xa438, 0x7fb5, 0xa438, 0xd701,
+    0xa438, 0x3ad4, 0xa438, 0x0556, 0xa438, 0x8610, 0xa438, 0x1800,
+    0xa438, 0x066e, 0xa438, 0xd1f5, 0xa438, 0xd049, 0xa438, 0x1800,
+    0xa438, 0x01ec, 0xa436, 0xA10E, 0xa438, 0x01ea, 0xa436, 0xA10C,
+    0xa438, 0x06a9, 0xa436, 0xA10A, 0xa438, 0x078a, 0xa436, 0xA108,
+    0xa438, 0x03d2, 0xa436, 0xA106, 0xa438, 0x067f, 0xa436, 0xA104,
+    0xa438, 0x0665, 0xa436, 0xA102, 0xa438, 0x0000, 0xa436, 0xA100,
+    0xa438, 0x0000, 0xa436, 0xA110, 0xa438, 0x00fc, 0xa436, 0xb87c,
+    0xa438, 0x8530, 0xa436, 0xb87e, 0xa438, 0xaf85, 0xa438, 0x3caf,
+    0xa438, 0x8545, 0xa438, 0xaf85, 0xa438, 0x45af, 0xa438, 0x8545,
+    0xa438, 0xee82, 0xa438, 0xf900, 0xa438, 0x0103, 0xa438, 0xaf03,
+    0xa438, 0xb7f8, 0xa438, 0xe0a6, 0xa438, 0x00e1, 0xa438, 0xa601,
+    0xa438, 0xef01, 0xa438, 0x58f0, 0xa438, 0xa080, 0xa438, 0x37a1,
+    0xa438, 0x8402, 0xa438, 0xae16, 0xa438, 0xa185, 0xa438, 0x02ae,
+    0xa438, 0x11a1, 0xa438, 0x8702, 0xa438, 0xae0c, 0xa438, 0xa188,
+    0xa438, 0x02ae, 0xa438, 0x07a1, 0xa438, 0x8902, 0xa438, 0xae02,
+    0xa438, 0xae1c, 0xa438, 0xe0b4, 0xa438, 0x62e1, 0xa438, 0xb463,
+    0xa438, 0x6901, 0xa438, 0xe4b4, 0xa438, 0x62e5, 0xa438, 0xb463,
+    0xa438, 0xe0b4, 0xa438, 0x62e1, 0xa438, 0xb463, 0xa438, 0x6901,
+    0xa438, 0xe4b4, 0xa438, 0x62e5, 0xa438, 0xb463, 0xa438, 0xfc04,
+    0xa436, 0xb85e, 0xa438, 0x03b3, 0xa436, 0xb860, 0xa438, 0xffff,
+    0xa436, 0xb862, 0xa438, 0xffff, 0xa436, 0xb864, 0xa438, 0xffff,
+    0xa436, 0xb878, 0xa438, 0x0001, 0xFFFF, 0xFFFF
+};
+
 static void
 rtl8125_real_set_phy_mcu_8125a_2(struct net_device *dev)
 {
@@ -6907,562 +6573,10 @@ rtl8125_real_set_phy_mcu_8125a_2(struct net_device *dev)
     SetEthPhyOcpBit(tp, 0xB820, BIT_7);
     
     
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA016);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA012);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA014);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x808b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x808f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8093);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8097);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x809d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x80a1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x80aa);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd718);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x607b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x40da);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf00e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x42da);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf01e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd718);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x615b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1456);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x14a4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x14bc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd718);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5f2e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf01c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1456);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x14a4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x14bc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd718);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5f2e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf024);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1456);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x14a4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x14bc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd718);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5f2e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf02c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1456);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x14a4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x14bc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd718);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5f2e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf034);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd719);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4118);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xac11);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa410);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4779);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xac0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xae01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1444);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf034);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd719);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4118);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xac22);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa420);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4559);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xac0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xae01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1444);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf023);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd719);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4118);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xac44);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa440);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4339);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xac0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xae01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1444);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf012);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd719);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4118);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xac88);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa480);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xce00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4119);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xac0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xae01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1444);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf001);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1456);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd718);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5fac);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xc48f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x141b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd504);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x121a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd0b4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd1bb);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0898);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd0b4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd1bb);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a0e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd064);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd18a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0b7e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x401c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd501);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa804);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8804);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x053b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd500);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa301);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0648);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xc520);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa201);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x252d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1646);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd708);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4006);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1646);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0308);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA026);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0307);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA024);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1645);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA022);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0647);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA020);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x053a);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA006);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0b7c);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA004);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0a0c);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0896);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x11a1);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA008);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xff00);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA016);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0010);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA012);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA014);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8015);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x801a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x801a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x801a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x801a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x801a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x801a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xad02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x02d7);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00ed);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0509);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xc100);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x008f);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA08E);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA08C);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA08A);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA088);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA086);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA084);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA082);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x008d);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA080);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00eb);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA090);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0103);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA016);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0020);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA012);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA014);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8014);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8018);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8024);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8051);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8055);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8072);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x80dc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfffd);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfffd);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8301);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x800a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8190);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x82a0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8404);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa70c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x9402);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x890c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8840);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa380);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x066e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xcb91);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4063);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd139);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd140);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd040);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb404);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07e0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa610);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa110);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa2a0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa404);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd704);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4085);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa180);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa404);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8280);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd704);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x405d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa720);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0743);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07f0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5f74);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0743);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd702);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7fb6);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8190);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x82a0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8404);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8610);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0c0f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07e0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x066e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd158);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd04d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x03d4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x94bc);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x870c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8380);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd10d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd040);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07c4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5fb4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa190);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa00a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa280);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa404);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa220);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd130);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd040);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07c4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5fb4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xbb80);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd1c4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd074);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa301);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd704);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x604b);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa90c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0556);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xcb92);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4063);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd116);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd119);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd040);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd703);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x60a0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6241);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x63e2);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6583);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf054);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x611e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x40da);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d10);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf02f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d50);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf02a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x611e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x40da);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d20);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf021);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d60);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf01c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x611e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x40da);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d30);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf013);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d70);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf00e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x611e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x40da);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d40);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf005);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d80);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07e8);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa610);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd704);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x405d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa720);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd700);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x5ff4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa008);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd704);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x4046);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa002);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0743);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07fb);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd703);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7f6f);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7f4e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7f2d);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7f0c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x800a);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0cf0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0d00);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07e8);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8010);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa740);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1000);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0743);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd702);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x7fb5);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd701);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x3ad4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0556);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8610);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x066e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd1f5);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xd049);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x1800);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x01ec);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA10E);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x01ea);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA10C);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x06a9);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA10A);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x078a);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA108);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x03d2);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA106);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x067f);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA104);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0665);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA102);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA100);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0000);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xA110);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00fc);
-    
-    
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb87c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8530);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb87e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaf85);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x3caf);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8545);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaf85);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x45af);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8545);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xee82);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xf900);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0103);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xaf03);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb7f8);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xe0a6);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x00e1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa601);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xef01);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x58f0);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa080);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x37a1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8402);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xae16);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa185);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x02ae);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x11a1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8702);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xae0c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xa188);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x02ae);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x07a1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x8902);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xae02);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xae1c);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xe0b4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x62e1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb463);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6901);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xe4b4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x62e5);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb463);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xe0b4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x62e1);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb463);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x6901);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xe4b4);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x62e5);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xb463);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xfc04);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb85e);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x03b3);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb860);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb862);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb864);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0xffff);
-    mdio_direct_write_phy_ocp(tp, 0xA436, 0xb878);
-    mdio_direct_write_phy_ocp(tp, 0xA438, 0x0001);
+    rtl8125_set_phy_mcu_ram_code(dev,
+                                 phy_mcu_ram_code_8125a_2,
+                                 ARRAY_SIZE(phy_mcu_ram_code_8125a_2)
+                                 );
     
     
     ClearEthPhyOcpBit(tp, 0xB820, BIT_7);
@@ -8385,7 +7499,10 @@ rtl8125_init_hw_phy_mcu(struct net_device *dev)
     u8 require_disable_phy_disable_mode = FALSE;
     
     if (tp->NotWrRamCodeToMicroP == TRUE) return;
-    if (rtl8125_check_hw_phy_mcu_code_ver(dev)) return;
+    if (rtl8125_check_hw_phy_mcu_code_ver(dev)) {
+        dprintk("PHY MCU ram code 0x%04x already loaded.\n", tp->hw_ram_code_ver);
+        return;
+    }
     
     if (HW_SUPPORT_CHECK_PHY_DISABLE_MODE(tp) && rtl8125_is_in_phy_disable_mode(dev))
         require_disable_phy_disable_mode = TRUE;
@@ -1809,6 +1809,20 @@ enum rtl8125_fc_mode {
     rtl8125_fc_default
 };
 
+/*
+ * Write-through shadow of OCP registers holding configuration only,
+ * indexed like the address list it has been initialized with.
+ */
+#define RTL8125_OCP_SHADOW_MAX  32
+
+struct rtl8125_ocp_shadow {
+    const u16 *addr;
+    u32 count;
+    u32 valid;
+    u32 hits;
+    u16 value[RTL8125_OCP_SHADOW_MAX];
+};
+
 struct rtl8125_private {
     void __iomem *mmio_addr;    /* memory map physical address */
     struct pci_dev *pci_dev;    /* Index of PCI device */
@@ -2149,6 +2163,9 @@ struct rtl8125_private {
     UInt32 s0MagicPacket;
     UInt32 configEEE;
     UInt32 configASPM;
+
+    struct rtl8125_ocp_shadow mac_ocp_shadow;
+    struct rtl8125_ocp_shadow phy_ocp_shadow;
 };
 
 #if DISABLED_CODE
@@ -2313,6 +2330,7 @@ int rtl8125_get_mac_address(struct net_device *dev);
 void rtl8125_phy_power_down(struct net_device *dev);
 void rtl8125_phy_restart_nway(struct net_device *dev);
 void rtl8125_phy_setup_force_mode(struct net_device *dev, u32 speed, u8 duplex);
+void rtl8125_enable_rxdvgate(struct net_device *dev);
 void rtl8125_disable_rxdvgate(struct net_device *dev);
 void rtl8125_powerup_pll(struct net_device *dev);
 void rtl8125_hw_ephy_config(struct net_device *dev);
@@ -2341,6 +2359,39 @@ void ClearEthPhyOcpBit(struct rtl8125_private *tp, u16 addr, u16 mask);
 void SetEthPhyOcpBit(struct rtl8125_private *tp,  u16 addr, u16 mask);
 void ClearAndSetEthPhyOcpBit(struct rtl8125_private *tp, u16 addr, u16 clearmask, u16 setmask);
 
+/*
+ * PHY OCP configuration tables. PHY OCP registers are word aligned, so
+ * odd addresses are free to encode control operations.
+ */
+struct rtl8125_phy_cfg {
+    u16 addr;
+    u16 clearmask;
+    u16 setmask;
+};
+
+#define PHY_CFG_CTRL_MCU_PATCH_REQUEST  0x0001
+#define PHY_CFG_CTRL_MCU_PATCH_RELEASE  0x0003
+#define PHY_CFG_CTRL_IF_RAM_CODE        0x0005
+
+#define PHY_CFG_WRITE(addr, value)      { (addr), 0xFFFF, (u16)(value) }
+#define PHY_CFG_CLEAR_SET(addr, clearmask, setmask) { (addr), (u16)(clearmask), (u16)(setmask) }
+#define PHY_CFG_SET(addr, mask)         { (addr), 0, (u16)(mask) }
+#define PHY_CFG_CLEAR(addr, mask)       { (addr), (u16)(mask), 0 }
+#define PHY_CFG_MCU_PATCH_REQUEST()     { PHY_CFG_CTRL_MCU_PATCH_REQUEST, 0, 0 }
+#define PHY_CFG_MCU_PATCH_RELEASE()     { PHY_CFG_CTRL_MCU_PATCH_RELEASE, 0, 0 }
+/* Skip the next n entries unless the PHY MCU ram code has been written. */
+#define PHY_CFG_IF_RAM_CODE(n)          { PHY_CFG_CTRL_IF_RAM_CODE, 0, (n) }
+
+void rtl8125_apply_phy_cfg_table(struct rtl8125_private *tp, const struct rtl8125_phy_cfg *cfg, u16 count);
+
+void rtl8125_init_ocp_shadow(struct rtl8125_private *tp);
+void rtl8125_reset_ocp_shadow(struct rtl8125_private *tp);
+
+static inline void rtl8125_invalidate_ocp_shadow(struct rtl8125_ocp_shadow *shadow)
+{
+    shadow->valid = 0;
+}
+
 u32 mdio_direct_read_phy_ocp(struct rtl8125_private *tp, u16 RegAddr);
 void mdio_real_direct_write_phy_ocp(struct rtl8125_private *tp, u16 RegAddr, u16 value);
 void mdio_direct_write_phy_ocp(struct rtl8125_private *tp, u16 RegAddr, u16 value);
@@ -2350,6 +2401,7 @@ void rtl8125_disable_exit_l1_mask(struct rtl8125_private *tp);
 void rtl8125_wait_ll_share_fifo_ready(struct net_device *dev);
 
 void rtl8125_init_hw_phy_mcu(struct net_device *dev);
+int rtl8125_check_hw_phy_mcu_code_ver(struct net_device *dev);
 void rtl8125_set_hw_phy_before_init_phy_mcu(struct net_device *dev);
 void rtl8125_enable_phy_aldps(struct rtl8125_private *tp);
 bool rtl8125_set_phy_mcu_patch_request(struct rtl8125_private *tp);
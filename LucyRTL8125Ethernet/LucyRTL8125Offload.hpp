@@ -0,0 +1,164 @@
+/* LucyRTL8125Offload.hpp -- RTL8125 checksum offload tables.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*
+* This driver is based on Realtek's r8125 Linux driver (9.003.04).
+*/
+
+#ifndef LucyRTL8125Offload_hpp
+#define LucyRTL8125Offload_hpp
+
+/*
+ * This header doesn't include anything so that the tests in
+ * Tools/RtlStats can build the tables in user space. The includer
+ * provides the descriptor bits, the MBUF_CSUM_* flags, kMacHdrLen,
+ * kIPv6HdrLen, IPPROTO_TCP, memcpy() and OSSwapHostToBigInt16().
+ */
+
+/* Offload classes used to index the Tx descriptor template table. */
+enum RtlTxOffloadClass {
+    kTxOffloadNone = 0,
+    kTxOffloadIP,
+    kTxOffloadTCPv4,
+    kTxOffloadUDPv4,
+    kTxOffloadTCPv6,
+    kTxOffloadUDPv6,
+    kTxOffloadTSO4,
+    kTxOffloadTSO6,
+    kTxOffloadCount
+};
+
+/* Precomputed opts1/opts2 bits of a Tx descriptor for one offload class. */
+typedef struct RtlTxDescTmpl {
+    UInt32 opts1;
+    UInt32 opts2;
+} RtlTxDescTmpl;
+
+/* Checksum result for one combination of Rx descriptor status bits. */
+typedef struct RtlRxCsumResult {
+    UInt32 performed;
+    UInt32 value;
+} RtlRxCsumResult;
+
+/*
+ * Precomputed descriptor bits for each offload class. outputStart()
+ * only has to add length, MSS, TCP header offset and VLAN tag.
+ */
+static const RtlTxDescTmpl txDescTmplTable[kTxOffloadCount] = {
+    /* kTxOffloadNone */
+    { 0, 0 },
+    /* kTxOffloadIP */
+    { 0, (UInt32)TxIPCS_C },
+    /* kTxOffloadTCPv4 */
+    { 0, (UInt32)(TxIPCS_C | TxTCPCS_C) },
+    /* kTxOffloadUDPv4 */
+    { 0, (UInt32)(TxIPCS_C | TxUDPCS_C) },
+    /* kTxOffloadTCPv6 */
+    { 0, (UInt32)(TxTCPCS_C | TxIPV6F_C | (((kMacHdrLen + kIPv6HdrLen) & TCPHO_MAX) << TCPHO_SHIFT)) },
+    /* kTxOffloadUDPv6 */
+    { 0, (UInt32)(TxUDPCS_C | TxIPV6F_C | (((kMacHdrLen + kIPv6HdrLen) & TCPHO_MAX) << TCPHO_SHIFT)) },
+    /* kTxOffloadTSO4 */
+    { GiantSendv4, 0 },
+    /* kTxOffloadTSO6 */
+    { GiantSendv6, 0 },
+};
+
+/*
+ * Folds the checksum request bits kChecksumIP, kChecksumTCP, kChecksumUDP
+ * (bits 0-2) and kChecksumTCPIPv6, kChecksumUDPIPv6 (bits 5-6) into a
+ * 5 bit index for txCsumClassMap[].
+ */
+#define txCsumClassIndex(flags) (((flags) & 0x07) | (((flags) >> 2) & 0x18))
+
+static constexpr UInt8 txCsumClass(UInt32 index)
+{
+    return (index & 0x02) ? kTxOffloadTCPv4 :
+           (index & 0x08) ? kTxOffloadTCPv6 :
+           (index & 0x04) ? kTxOffloadUDPv4 :
+           (index & 0x10) ? kTxOffloadUDPv6 :
+           (index & 0x01) ? kTxOffloadIP : kTxOffloadNone;
+}
+
+#define TX_CSUM_CLASS4(n) txCsumClass(n), txCsumClass(n + 1), txCsumClass(n + 2), txCsumClass(n + 3)
+
+/* Maps a checksum request to its offload class, generated at compile time. */
+static const UInt8 txCsumClassMap[32] = {
+    TX_CSUM_CLASS4(0), TX_CSUM_CLASS4(4), TX_CSUM_CLASS4(8), TX_CSUM_CLASS4(12),
+    TX_CSUM_CLASS4(16), TX_CSUM_CLASS4(20), TX_CSUM_CLASS4(24), TX_CSUM_CLASS4(28)
+};
+
+/*
+ * The Rx checksum status is folded into a 6 bit index: bits 0-4 are
+ * RxTCPF, RxUDPF, RxIPF, RxTCPT and RxUDPT from opts1, bit 5 is RxV4F
+ * from opts2.
+ */
+#define rxCsumIndex(status1, status2) ((((status1) >> 14) & 0x1f) | (((status2) >> 25) & 0x20))
+
+/*
+ * The same index from a v3 descriptor, where all of the bits are in
+ * opts2: RxTCPF_v3, RxUDPF_v3 and RxIPF_v3 are bits 24-26, RxTCPT_v3,
+ * RxUDPT_v3 and RxV4F bits 28-30.
+ */
+#define rxCsumIndexV3(status2) ((((status2) >> 24) & 0x07) | (((status2) >> 25) & 0x38))
+
+static constexpr RtlRxCsumResult rxCsumResult(UInt32 index)
+{
+    return {
+        (((index & 0x20) && !(index & 0x04)) ? (MBUF_CSUM_DID_IP | MBUF_CSUM_IP_GOOD) : 0U) |
+        ((((index & 0x08) && !(index & 0x01)) || ((index & 0x10) && !(index & 0x02))) ? (MBUF_CSUM_DID_DATA | MBUF_CSUM_PSEUDO_HDR) : 0U),
+        /* Fake a valid checksum value for good TCP/UDP packets. */
+        (((index & 0x08) && !(index & 0x01)) || ((index & 0x10) && !(index & 0x02))) ? 0xffffU : 0U
+    };
+}
+
+#define RX_CSUM_RESULT4(n) rxCsumResult(n), rxCsumResult(n + 1), rxCsumResult(n + 2), rxCsumResult(n + 3)
+#define RX_CSUM_RESULT16(n) RX_CSUM_RESULT4(n), RX_CSUM_RESULT4(n + 4), RX_CSUM_RESULT4(n + 8), RX_CSUM_RESULT4(n + 12)
+
+/* Generated at compile time from the rules in rxCsumResult(). */
+static const RtlRxCsumResult rxCsumResultTable[64] = {
+    RX_CSUM_RESULT16(0), RX_CSUM_RESULT16(16), RX_CSUM_RESULT16(32), RX_CSUM_RESULT16(48)
+};
+
+/*
+ * Computes the TCP pseudo header checksum (without length) over the
+ * source and destination addresses. len must be a multiple of 8. The
+ * addresses are summed as 64 bit words in memory order, deferring the
+ * carries to a single fold at the end. As the one's complement sum is
+ * independent of byte order, the result can be stored into the TCP
+ * header without swapping.
+ */
+static inline UInt16 pseudoHdrCsum(const void *addr, UInt32 len)
+{
+    const UInt8 *p = (const UInt8 *)addr;
+    UInt64 sum = OSSwapHostToBigInt16(IPPROTO_TCP);
+    UInt64 val;
+    UInt32 i;
+    
+    for (i = 0; i < len; i += sizeof(UInt64)) {
+        memcpy(&val, p + i, sizeof(UInt64));
+        sum += val;
+        sum += (sum < val);
+    }
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    
+    return (UInt16)sum;
+}
+
+#endif /* LucyRTL8125Offload_hpp */
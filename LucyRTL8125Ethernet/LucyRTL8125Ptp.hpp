@@ -0,0 +1,178 @@
+/* LucyRTL8125Ptp.hpp -- RTL8125 PTP clock model and event frame parser.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*
+* This driver is based on Realtek's r8125 Linux driver (9.003.04).
+*/
+
+#ifndef LucyRTL8125Ptp_hpp
+#define LucyRTL8125Ptp_hpp
+
+/*
+ * Like LucyRTL8125Offload.hpp this header doesn't include anything, so
+ * that the tests in Tools/RtlStats can use it in user space. The
+ * includer provides RtlPtpStamp and kRtlPtpMaxFreqPpb.
+ */
+
+#define kPtpNsPerSec    1000000000LL
+
+/* Layer 2 ethertype and UDP port of PTP event messages. */
+#define kPtpEtherType   0x88F7
+#define kPtpEventPort   319
+
+/* Length of the common PTP message header. */
+#define kPtpHdrLen      34
+
+/*
+ * The chip's clock runs freely at the rate of its oscillator. The PTP
+ * clock is derived from it in software, its time at hardware time hw is
+ *
+ *   basePtp + (hw - baseHw) * (1 + ppb / 10^9)
+ *
+ * Every change moves the base to the current time first, so that a new
+ * rate only applies from then on and the clock stays continuous. The
+ * chip's time stamps are converted the same way, so that they agree
+ * with the clock.
+ */
+typedef struct RtlPtpClock {
+    UInt64 baseHw;      /* hardware time in ns */
+    UInt64 basePtp;     /* PTP time in ns at baseHw */
+    SInt64 ppb;         /* rate offset in parts per billion */
+} RtlPtpClock;
+
+/*
+ * Converts hardware time hw to PTP time. The elapsed time is split at
+ * whole seconds, so that the products don't overflow for any rate
+ * within kRtlPtpMaxFreqPpb. hw may be older than baseHw.
+ */
+static inline UInt64 ptpClockTime(const RtlPtpClock *clock, UInt64 hw)
+{
+    SInt64 elapsed = (SInt64)(hw - clock->baseHw);
+    SInt64 corr;
+    
+    corr = ((elapsed / kPtpNsPerSec) * clock->ppb) + (((elapsed % kPtpNsPerSec) * clock->ppb) / kPtpNsPerSec);
+    
+    return clock->basePtp + (UInt64)(elapsed + corr);
+}
+
+static inline void ptpClockSet(RtlPtpClock *clock, UInt64 hw, UInt64 time)
+{
+    clock->baseHw = hw;
+    clock->basePtp = time;
+}
+
+/* Steps the clock by delta ns at hardware time hw, not below zero. */
+static inline void ptpClockAdjust(RtlPtpClock *clock, UInt64 hw, SInt64 delta)
+{
+    UInt64 now = ptpClockTime(clock, hw);
+    
+    if ((delta < 0) && ((UInt64)(-delta) > now))
+        now = 0;
+    else
+        now += delta;
+    
+    ptpClockSet(clock, hw, now);
+}
+
+/* Changes the rate at hardware time hw. */
+static inline void ptpClockSetRate(RtlPtpClock *clock, UInt64 hw, SInt64 ppb)
+{
+    ptpClockSet(clock, hw, ptpClockTime(clock, hw));
+    clock->ppb = ppb;
+}
+
+static inline UInt32 ptpRead16(const UInt8 *p)
+{
+    return ((UInt32)p[0] << 8) | p[1];
+}
+
+/*
+ * Returns the PTP header of an event message (Sync, Delay_Req,
+ * Pdelay_Req or Pdelay_Resp) in the frame at data or NULL, if it's none.
+ * Layer 2 and UDP over IPv4 or IPv6 without extension headers are
+ * recognized, with up to one VLAN tag in the frame. The message header
+ * must be within the first len bytes.
+ */
+static inline const UInt8 *ptpEventHeader(const UInt8 *data, UInt32 len)
+{
+    const UInt8 *ip;
+    UInt32 offset = 12;
+    UInt32 type;
+    
+    if (len < (offset + 2))
+        goto none;
+    
+    type = ptpRead16(data + offset);
+    
+    if (type == 0x8100) {
+        offset += 4;
+        
+        if (len < (offset + 2))
+            goto none;
+        
+        type = ptpRead16(data + offset);
+    }
+    offset += 2;
+    ip = data + offset;
+    
+    if (type == 0x0800) {
+        /* No fragments, no options beyond the header length. */
+        if ((len < (offset + 20)) || ((ip[0] >> 4) != 4) || ((ip[0] & 0x0f) < 5) ||
+            (ip[9] != 17) || (ptpRead16(ip + 6) & 0x3fff))
+            goto none;
+        
+        offset += (ip[0] & 0x0f) * 4;
+    } else if (type == 0x86DD) {
+        if ((len < (offset + 40)) || ((ip[0] >> 4) != 6) || (ip[6] != 17))
+            goto none;
+        
+        offset += 40;
+    } else if (type != kPtpEtherType) {
+        goto none;
+    }
+    if (type != kPtpEtherType) {
+        if ((len < (offset + 8)) || (ptpRead16(data + offset + 2) != kPtpEventPort))
+            goto none;
+        
+        offset += 8;
+    }
+    /* Event messages are those with a type below 4. */
+    if ((len < (offset + kPtpHdrLen)) || ((data[offset] & 0x0f) > 3))
+        goto none;
+    
+    return data + offset;
+    
+none:
+    return NULL;
+}
+
+/* Fills in a time stamp record for the message with header hdr. */
+static inline void ptpFillStamp(RtlPtpStamp *stamp, const UInt8 *hdr, UInt64 time, UInt32 direction)
+{
+    UInt32 i;
+    
+    stamp->time = time;
+    stamp->direction = (UInt8)direction;
+    stamp->messageType = hdr[0] & 0x0f;
+    stamp->sequenceId = (UInt16)ptpRead16(hdr + 30);
+    stamp->domain = hdr[4];
+    stamp->reserved = 0;
+    
+    for (i = 0; i < sizeof(stamp->sourcePort); i++)
+        stamp->sourcePort[i] = hdr[20 + i];
+}
+
+#endif /* LucyRTL8125Ptp_hpp */
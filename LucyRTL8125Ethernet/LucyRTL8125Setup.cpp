@@ -35,6 +35,7 @@ void LucyRTL8125::getParams()
     OSBoolean *tso6;
     OSBoolean *csoV6;
     OSBoolean *noASPM;
+    OSBoolean *latency;
     OSString *versionString;
     OSString *fbAddr;
     UInt32 usInterval;
@@ -73,6 +74,14 @@ void LucyRTL8125::getParams()
         
         IOLog("TCP/IPv6 checksum offload %s.\n", enableCSO6 ? onName : offName);
         
+        latency = OSDynamicCast(OSBoolean, params->getObject(kRxLatencyName));
+        latEnable[kLatPathRx] = (latency) ? latency->getValue() : false;
+        
+        latency = OSDynamicCast(OSBoolean, params->getObject(kTxLatencyName));
+        latEnable[kLatPathTx] = (latency) ? latency->getValue() : false;
+        
+        DebugLog("Latency histograms: rx %s, tx %s.\n", latEnable[kLatPathRx] ? onName : offName, latEnable[kLatPathTx] ? onName : offName);
+        
         pollInt = OSDynamicCast(OSNumber, params->getObject(kPollInt2500Name));
 
         if (pollInt) {
@@ -231,11 +240,71 @@ bool LucyRTL8125::initEventSources(IOService *provider)
     }
     workLoop->addEventSource(timerSource);
 
+    txStallSource = IOTimerEventSource::timerEventSource(this, OSMemberFunctionCast(IOTimerEventSource::Action, this, &LucyRTL8125::txStallAction));
+    
+    if (!txStallSource) {
+        IOLog("Failed to create IOTimerEventSource.\n");
+        goto error3;
+    }
+    workLoop->addEventSource(txStallSource);
+
+    pktGenSource = IOTimerEventSource::timerEventSource(this, OSMemberFunctionCast(IOTimerEventSource::Action, this, &LucyRTL8125::pktGenTimerAction));
+    
+    if (!pktGenSource) {
+        IOLog("Failed to create IOTimerEventSource.\n");
+        goto error4;
+    }
+    workLoop->addEventSource(pktGenSource);
+
+    captureSource = IOTimerEventSource::timerEventSource(this, OSMemberFunctionCast(IOTimerEventSource::Action, this, &LucyRTL8125::captureTimerAction));
+    
+    if (!captureSource) {
+        IOLog("Failed to create IOTimerEventSource.\n");
+        goto error5;
+    }
+    workLoop->addEventSource(captureSource);
+
+    statsPageSource = IOTimerEventSource::timerEventSource(this, OSMemberFunctionCast(IOTimerEventSource::Action, this, &LucyRTL8125::statsPageTimerAction));
+    
+    if (!statsPageSource) {
+        IOLog("Failed to create IOTimerEventSource.\n");
+        goto error6;
+    }
+    workLoop->addEventSource(statsPageSource);
+
+    ptpTxSource = IOTimerEventSource::timerEventSource(this, OSMemberFunctionCast(IOTimerEventSource::Action, this, &LucyRTL8125::ptpTxTimerAction));
+    
+    if (!ptpTxSource) {
+        IOLog("Failed to create IOTimerEventSource.\n");
+        goto error7;
+    }
+    workLoop->addEventSource(ptpTxSource);
+    
     result = true;
     
 done:
     return result;
     
+error7:
+    workLoop->removeEventSource(statsPageSource);
+    RELEASE(statsPageSource);
+    
+error6:
+    workLoop->removeEventSource(captureSource);
+    RELEASE(captureSource);
+
+error5:
+    workLoop->removeEventSource(pktGenSource);
+    RELEASE(pktGenSource);
+
+error4:
+    workLoop->removeEventSource(txStallSource);
+    RELEASE(txStallSource);
+
+error3:
+    workLoop->removeEventSource(timerSource);
+    RELEASE(timerSource);
+
 error2:
     workLoop->removeEventSource(interruptSource);
     RELEASE(interruptSource);
@@ -254,6 +323,7 @@ bool LucyRTL8125::setupRxResources()
     mbuf_t m;
     UInt64 offset = 0;
     UInt32 numSegs = 1;
+    UInt32 descSize = rxDescV3 ? kRxDescSizeV3 : kRxDescSize;
     UInt32 i;
     UInt32 opts1;
     bool result = false;
@@ -268,7 +338,7 @@ bool LucyRTL8125::setupRxResources()
     rxMbufArray = (mbuf_t *)rxBufArrayMem;
 
     /* Create receiver descriptor array. */
-    rxBufDesc = IOBufferMemoryDescriptor::inTaskWithPhysicalMask(kernel_task, (kIODirectionInOut | kIOMemoryPhysicallyContiguous | kIOMemoryHostPhysicallyContiguous | kIOMapInhibitCache), kRxDescSize, 0xFFFFFFFFFFFFFF00ULL);
+    rxBufDesc = IOBufferMemoryDescriptor::inTaskWithPhysicalMask(kernel_task, (kIODirectionInOut | kIOMemoryPhysicallyContiguous | kIOMemoryHostPhysicallyContiguous | kIOMapInhibitCache), descSize, 0xFFFFFFFFFFFFFF00ULL);
     
     if (!rxBufDesc) {
         IOLog("Couldn't alloc rxBufDesc.\n");
@@ -278,7 +348,7 @@ bool LucyRTL8125::setupRxResources()
         IOLog("rxBufDesc->prepare() failed.\n");
         goto error_prep;
     }
-    rxDescArray = (RtlRxDesc *)rxBufDesc->getBytesNoCopy();
+    rxDescArray = rxBufDesc->getBytesNoCopy();
 
     rxDescDmaCmd = IODMACommand::withSpecification(kIODMACommandOutputHost64, 64, 0, IODMACommand::kMapped, 0, 1, mapper, NULL);
     
@@ -300,8 +370,8 @@ bool LucyRTL8125::setupRxResources()
     rxPhyAddr = seg.fIOVMAddr;
     
     /* Initialize rxDescArray. */
-    bzero(rxDescArray, kRxDescSize);
-    rxDescArray[kRxLastDesc].opts1 = OSSwapHostToLittleInt32(RingEnd);
+    bzero(rxDescArray, descSize);
+    *rxDescOpts1(kRxLastDesc) = OSSwapHostToLittleInt32(RingEnd);
 
     for (i = 0; i < kNumRxDesc; i++) {
         rxMbufArray[i] = NULL;
@@ -331,9 +401,9 @@ bool LucyRTL8125::setupRxResources()
         }
         opts1 = (UInt32)rxSegment.length;
         opts1 |= (i == kRxLastDesc) ? (RingEnd | DescOwn) : DescOwn;
-        rxDescArray[i].opts1 = OSSwapHostToLittleInt32(opts1);
-        rxDescArray[i].opts2 = 0;
-        rxDescArray[i].addr = OSSwapHostToLittleInt64(rxSegment.location);
+        *rxDescAddr(i) = OSSwapHostToLittleInt64(rxSegment.location);
+        *rxDescOpts2(i) = 0;
+        *rxDescOpts1(i) = OSSwapHostToLittleInt32(opts1);
     }
     /*
      * Allocate some spare mbufs and keep them in a buffer pool, to
@@ -509,8 +579,10 @@ error_buff:
 bool LucyRTL8125::setupStatResources()
 {
     IODMACommand::Segment64 seg;
+    OSDictionary *group;
     UInt64 offset = 0;
     UInt32 numSegs = 1;
+    UInt32 i, j;
     bool result = false;
 
     /* Create statistics dump buffer. */
@@ -549,6 +621,99 @@ bool LucyRTL8125::setupStatResources()
     /* Initialize statData. */
     bzero(statData, sizeof(RtlStatData));
 
+    /* Allocate the per context blocks of the data path counters. */
+    pathCounters = (RtlPathCounters *)IOMallocAligned(sizeof(RtlPathCounters) * kPathContextCount, 64);
+    
+    if (!pathCounters) {
+        IOLog("Couldn't alloc pathCounters.\n");
+        goto error_segm;
+    }
+    bzero(pathCounters, sizeof(RtlPathCounters) * kPathContextCount);
+
+    /* All members of the RTL8125 family dump the extended counters. */
+    switch (linuxData.mcfg) {
+        case CFG_METHOD_2:
+        case CFG_METHOD_3:
+        case CFG_METHOD_4:
+        case CFG_METHOD_5:
+            statCount = kStatCount;
+            break;
+            
+        default:
+            statCount = kStatLegacyCount;
+            break;
+    }
+    /*
+     * The accumulated counters are published as "HardwareStatistics"
+     * with a sub-dictionary for each group of counters.
+     */
+    statDict = OSDictionary::withCapacity(4);
+    
+    if (statDict) {
+        for (i = 0; i < statCount; i++) {
+            group = OSDynamicCast(OSDictionary, statDict->getObject(statCounters[i].group));
+            
+            if (!group) {
+                group = OSDictionary::withCapacity(16);
+                
+                if (!group)
+                    continue;
+                
+                statDict->setObject(statCounters[i].group, group);
+                group->release();
+            }
+            statNums[i] = OSNumber::withNumber(statTotals[i], 64);
+            
+            if (statNums[i])
+                group->setObject(statCounters[i].name, statNums[i]);
+        }
+        setProperty("HardwareStatistics", statDict);
+    }
+    pathDict = OSDictionary::withCapacity(kPathCount);
+    
+    if (pathDict) {
+        for (i = 0; i < kPathCount; i++) {
+            pathNums[i] = OSNumber::withNumber(0ULL, 64);
+            
+            if (pathNums[i])
+                pathDict->setObject(pathCounterNames[i], pathNums[i]);
+        }
+        setProperty("DataPathStatistics", pathDict);
+    }
+    latDict = OSDictionary::withCapacity(kLatPathCount);
+    
+    if (latDict) {
+        for (i = 0; i < kLatPathCount; i++) {
+            group = OSDictionary::withCapacity(kLatValueCount);
+            
+            if (!group)
+                continue;
+            
+            for (j = 0; j < kLatValueCount; j++) {
+                latNums[i][j] = OSNumber::withNumber(0ULL, 64);
+                
+                if (latNums[i][j])
+                    group->setObject(latValueNames[j], latNums[i][j]);
+            }
+            latDict->setObject(latPathNames[i], group);
+            group->release();
+        }
+        setProperty("LatencyStatistics", latDict);
+    }
+    /* Create the statistics page shared with user clients. */
+    statsPageDesc = IOBufferMemoryDescriptor::withOptions(kIODirectionOut | kIOMemoryKernelUserShared, round_page(sizeof(RtlStatsPage)), PAGE_SIZE);
+    
+    if (statsPageDesc) {
+        statsPage = (RtlStatsPage *)statsPageDesc->getBytesNoCopy();
+        bzero(statsPage, statsPageDesc->getLength());
+        statsPage->version = kRtlStatsPageVersion;
+        statsPage->size = sizeof(RtlStatsPage);
+        statsPage->rxRingSize = kNumRxDesc;
+        statsPage->txRingSize = kNumTxDesc;
+        statsPage->pathCount = kPathCount;
+    } else {
+        IOLog("Couldn't alloc statistics page.\n");
+    }
     result = true;
     
 done:
@@ -568,6 +733,331 @@ error_prep:
     goto done;
 }
 
+/*
+ * Allocate the buffer for the frames posted by the self test. It's
+ * not required for normal operation, so a failure isn't fatal.
+ */
+bool LucyRTL8125::setupGenResources()
+{
+    IODMACommand::Segment64 seg;
+    UInt64 offset = 0;
+    UInt32 numSegs = 1;
+    bool result = false;
+    
+    genBufDesc = IOBufferMemoryDescriptor::inTaskWithPhysicalMask(kernel_task, (kIODirectionOut | kIOMemoryPhysicallyContiguous | kIOMemoryHostPhysicallyContiguous), kGenBufSize, 0xFFFFFFFFFFFFFF00ULL);
+    
+    if (!genBufDesc) {
+        IOLog("Couldn't alloc genBufDesc.\n");
+        goto done;
+    }
+    
+    if (genBufDesc->prepare() != kIOReturnSuccess) {
+        IOLog("genBufDesc->prepare() failed.\n");
+        goto error_prep;
+    }
+    genBuf = (UInt8 *)genBufDesc->getBytesNoCopy();
+    
+    genDmaCmd = IODMACommand::withSpecification(kIODMACommandOutputHost64, 64, 0, IODMACommand::kMapped, 0, 1);
+    
+    if (!genDmaCmd) {
+        IOLog("Couldn't alloc genDmaCmd.\n");
+        goto error_dma;
+    }
+    
+    if (genDmaCmd->setMemoryDescriptor(genBufDesc) != kIOReturnSuccess) {
+        IOLog("setMemoryDescriptor() failed.\n");
+        goto error_set_desc;
+    }
+    
+    if (genDmaCmd->gen64IOVMSegments(&offset, &seg, &numSegs) != kIOReturnSuccess) {
+        IOLog("gen64IOVMSegments() failed.\n");
+        goto error_segm;
+    }
+    genPhyAddr = seg.fIOVMAddr;
+    bzero(genBuf, kGenBufSize);
+    result = true;
+    
+done:
+    return result;
+    
+error_segm:
+    genDmaCmd->clearMemoryDescriptor();
+    
+error_set_desc:
+    RELEASE(genDmaCmd);
+    
+error_dma:
+    genBufDesc->complete();
+    genBuf = NULL;
+    
+error_prep:
+    RELEASE(genBufDesc);
+    goto done;
+}
+
+void LucyRTL8125::freeGenResources()
+{
+    if (genBufDesc) {
+        genBufDesc->complete();
+        genBufDesc->release();
+        genBufDesc = NULL;
+        genBuf = NULL;
+        genPhyAddr = (IOPhysicalAddress64)NULL;
+    }
+    if (genDmaCmd) {
+        genDmaCmd->clearMemoryDescriptor();
+        genDmaCmd->release();
+        genDmaCmd = NULL;
+    }
+}
+
+/*
+ * The capture area itself is allocated when a capture is started, as
+ * its size is chosen by the client.
+ */
+bool LucyRTL8125::setupCaptureResources()
+{
+    bool result = false;
+    
+    captureLock[kRtlCaptureRx] = IOSimpleLockAlloc();
+    
+    if (!captureLock[kRtlCaptureRx]) {
+        IOLog("Couldn't alloc captureLock.\n");
+        goto done;
+    }
+    captureLock[kRtlCaptureTx] = IOSimpleLockAlloc();
+    
+    if (!captureLock[kRtlCaptureTx]) {
+        IOLog("Couldn't alloc captureLock.\n");
+        goto error_lock;
+    }
+    result = true;
+    
+done:
+    return result;
+    
+error_lock:
+    IOSimpleLockFree(captureLock[kRtlCaptureRx]);
+    captureLock[kRtlCaptureRx] = NULL;
+    goto done;
+}
+
+void LucyRTL8125::freeCaptureResources()
+{
+    UInt32 i;
+    
+    clear_bit(__CAPTURE, &stateFlags);
+    captureHdr = NULL;
+    RELEASE(captureDesc);
+    
+    for (i = 0; i < kRtlCaptureRingCount; i++) {
+        if (captureLock[i]) {
+            IOSimpleLockFree(captureLock[i]);
+            captureLock[i] = NULL;
+        }
+    }
+}
+
+/*
+ * The lock protects the clock model and the time stamp queue, which
+ * rxInterrupt() also uses outside of the workloop while polling.
+ */
+bool LucyRTL8125::setupPtpResources()
+{
+    bool result = false;
+    
+    ptpLock = IOSimpleLockAlloc();
+    
+    if (!ptpLock) {
+        IOLog("Couldn't alloc ptpLock.\n");
+        goto done;
+    }
+    result = true;
+    
+done:
+    return result;
+}
+
+void LucyRTL8125::freePtpResources()
+{
+    ptpStampEnable = false;
+    
+    if (ptpLock) {
+        IOSimpleLockFree(ptpLock);
+        ptpLock = NULL;
+    }
+}
+
+/*
+ * The lock lives as long as the driver, as rxInterrupt() may still be
+ * polled outside of the workloop while a user queue is stopped. The
+ * area is allocated when a user queue is started.
+ */
+bool LucyRTL8125::setupUserQueueResources()
+{
+    bool result = false;
+    
+    userQueueLock = IOSimpleLockAlloc();
+    
+    if (!userQueueLock) {
+        IOLog("Couldn't alloc userQueueLock.\n");
+        goto done;
+    }
+    result = true;
+    
+done:
+    return result;
+}
+
+void LucyRTL8125::freeUserQueueResources()
+{
+    clear_bit(__USER_QUEUE, &stateFlags);
+    freeUserQueueArea();
+    
+    if (userQueueLock) {
+        IOSimpleLockFree(userQueueLock);
+        userQueueLock = NULL;
+    }
+}
+
+/*
+ * Allocate the area shared with the user queue's consumer, wire its
+ * buffers for DMA and create the descriptor ring of the second tx
+ * queue, which stays private to the driver.
+ */
+bool LucyRTL8125::setupUserQueueArea()
+{
+    IODMACommand::Segment64 seg;
+    UInt64 offset;
+    UInt32 numSegs;
+    UInt32 i;
+    bool result = false;
+    
+    userQueueDesc = IOBufferMemoryDescriptor::inTaskWithPhysicalMask(kernel_task, (kIODirectionInOut | kIOMemoryKernelUserShared), kUserQueueSize, 0xFFFFFFFFFFFFF000ULL);
+    
+    if (!userQueueDesc) {
+        IOLog("Couldn't alloc userQueueDesc.\n");
+        goto done;
+    }
+    userQueueDmaCmd = IODMACommand::withSpecification(kIODMACommandOutputHost64, 64, PAGE_SIZE, IODMACommand::kMapped, 0, 1, mapper, NULL);
+    
+    if (!userQueueDmaCmd) {
+        IOLog("Couldn't alloc userQueueDmaCmd.\n");
+        goto error_dma;
+    }
+    if (userQueueDmaCmd->setMemoryDescriptor(userQueueDesc) != kIOReturnSuccess) {
+        IOLog("setMemoryDescriptor() failed.\n");
+        goto error_set_desc;
+    }
+    offset = kUserQueueBufOffset;
+    
+    for (i = 0; i < kUserQueuePages; i++) {
+        numSegs = 1;
+        
+        if ((userQueueDmaCmd->gen64IOVMSegments(&offset, &seg, &numSegs) != kIOReturnSuccess) || (seg.fLength != PAGE_SIZE)) {
+            IOLog("gen64IOVMSegments() failed.\n");
+            goto error_segm;
+        }
+        userQueuePages[i] = seg.fIOVMAddr;
+    }
+    userQueueHdr = (RtlUserQueueHeader *)userQueueDesc->getBytesNoCopy();
+    bzero(userQueueHdr, kUserQueueBufOffset);
+    userQueueSlots[kRtlUserQueueTx] = (RtlUserSlot *)((UInt8 *)userQueueHdr + kUserQueueSlotOffset);
+    userQueueSlots[kRtlUserQueueRx] = userQueueSlots[kRtlUserQueueTx] + kRtlUserQueueSlots;
+    userQueueBufs = (UInt8 *)userQueueHdr + kUserQueueBufOffset;
+    
+    /* Create the descriptor ring of the second tx queue. */
+    userTxBufDesc = IOBufferMemoryDescriptor::inTaskWithPhysicalMask(kernel_task, (kIODirectionInOut | kIOMemoryPhysicallyContiguous | kIOMemoryHostPhysicallyContiguous | kIOMapInhibitCache), kUserTxDescSize, 0xFFFFFFFFFFFFFF00ULL);
+    
+    if (!userTxBufDesc) {
+        IOLog("Couldn't alloc userTxBufDesc.\n");
+        goto error_segm;
+    }
+    if (userTxBufDesc->prepare() != kIOReturnSuccess) {
+        IOLog("userTxBufDesc->prepare() failed.\n");
+        goto error_tx_prep;
+    }
+    userTxDescArray = (RtlTxDesc *)userTxBufDesc->getBytesNoCopy();
+    
+    userTxDmaCmd = IODMACommand::withSpecification(kIODMACommandOutputHost64, 64, 0, IODMACommand::kMapped, 0, 1, mapper, NULL);
+    
+    if (!userTxDmaCmd) {
+        IOLog("Couldn't alloc userTxDmaCmd.\n");
+        goto error_tx_dma;
+    }
+    if (userTxDmaCmd->setMemoryDescriptor(userTxBufDesc) != kIOReturnSuccess) {
+        IOLog("setMemoryDescriptor() failed.\n");
+        goto error_tx_set_desc;
+    }
+    offset = 0;
+    numSegs = 1;
+    
+    if (userTxDmaCmd->gen64IOVMSegments(&offset, &seg, &numSegs) != kIOReturnSuccess) {
+        IOLog("gen64IOVMSegments() failed.\n");
+        goto error_tx_segm;
+    }
+    userTxPhyAddr = seg.fIOVMAddr;
+    bzero(userTxDescArray, kUserTxDescSize);
+    userTxDescArray[kRtlUserQueueSlots - 1].opts1 = OSSwapHostToLittleInt32(RingEnd);
+    result = true;
+    
+done:
+    return result;
+    
+error_tx_segm:
+    userTxDmaCmd->clearMemoryDescriptor();
+
+error_tx_set_desc:
+    RELEASE(userTxDmaCmd);
+
+error_tx_dma:
+    userTxBufDesc->complete();
+    userTxDescArray = NULL;
+
+error_tx_prep:
+    RELEASE(userTxBufDesc);
+
+error_segm:
+    userQueueDmaCmd->clearMemoryDescriptor();
+    userQueueHdr = NULL;
+
+error_set_desc:
+    RELEASE(userQueueDmaCmd);
+
+error_dma:
+    RELEASE(userQueueDesc);
+    goto done;
+}
+
+/*
+ * DMA of the second tx queue must have been stopped. The consumer's
+ * mapping keeps the shared area alive.
+ */
+void LucyRTL8125::freeUserQueueArea()
+{
+    if (userTxBufDesc) {
+        userTxBufDesc->complete();
+        userTxBufDesc->release();
+        userTxBufDesc = NULL;
+        userTxDescArray = NULL;
+        userTxPhyAddr = (IOPhysicalAddress64)NULL;
+    }
+    if (userTxDmaCmd) {
+        userTxDmaCmd->clearMemoryDescriptor();
+        userTxDmaCmd->release();
+        userTxDmaCmd = NULL;
+    }
+    if (userQueueDmaCmd) {
+        userQueueDmaCmd->clearMemoryDescriptor();
+        userQueueDmaCmd->release();
+        userQueueDmaCmd = NULL;
+    }
+    userQueueHdr = NULL;
+    userQueueSlots[kRtlUserQueueTx] = userQueueSlots[kRtlUserQueueRx] = NULL;
+    userQueueBufs = NULL;
+    RELEASE(userQueueDesc);
+}
+
 void LucyRTL8125::freeRxResources()
 {
     UInt32 i;
@@ -626,6 +1116,32 @@ void LucyRTL8125::freeTxResources()
 
 void LucyRTL8125::freeStatResources()
 {
+    UInt32 i, j;
+    
+    for (i = 0; i < kStatCount; i++)
+        RELEASE(statNums[i]);
+    
+    RELEASE(statDict);
+    
+    for (i = 0; i < kPathCount; i++)
+        RELEASE(pathNums[i]);
+    
+    RELEASE(pathDict);
+    
+    for (i = 0; i < kLatPathCount; i++) {
+        for (j = 0; j < kLatValueCount; j++)
+            RELEASE(latNums[i][j]);
+    }
+    RELEASE(latDict);
+    
+    statsPage = NULL;
+    RELEASE(statsPageDesc);
+    
+    if (pathCounters) {
+        IOFreeAligned(pathCounters, sizeof(RtlPathCounters) * kPathContextCount);
+        pathCounters = NULL;
+    }
+    
     if (statBufDesc) {
         statBufDesc->complete();
         statBufDesc->release();
@@ -643,7 +1159,6 @@ void LucyRTL8125::clearRxTxRings()
 {
     mbuf_t m;
     UInt32 lastIndex = kTxLastDesc;
-    UInt32 opts1;
     UInt32 i;
     
     DebugLog("clearDescriptors() ===>\n");
@@ -661,16 +1176,56 @@ void LucyRTL8125::clearRxTxRings()
     txDirtyDescIndex = txNextDescIndex = 0;
     txNumFreeDesc = kNumTxDesc;
     
-    lastIndex = kRxLastDesc;
+    for (i = 0; i < kNumRxDesc; i++)
+        rearmRxDesc(i);
     
-    for (i = 0; i < kNumRxDesc; i++) {
-        opts1 = rxBufferSize;
-        opts1 |= (i == kRxLastDesc) ? (RingEnd | DescOwn) : DescOwn;
-        rxDescArray[i].opts1 = OSSwapHostToLittleInt32(opts1);
-        rxDescArray[i].opts2 = 0;
-    }
     rxNextDescIndex = 0;
     deadlockWarn = 0;
     
+    if (userTxDescArray)
+        clearUserQueue();
+    
     DebugLog("clearDescriptors() <===\n");
 }
+
+/*
+ * Used instead of clearRxTxRings() with DMA stopped when the chip
+ * isn't reset. The chip's ring positions stay where they are, so the
+ * driver's rx position is moved to the chip's by dropping the frames
+ * which haven't been processed yet. It's the first descriptor the chip
+ * still owns. tx descriptors which haven't been sent stay queued, the
+ * completed ones are reclaimed by txInterrupt() as usual.
+ */
+void LucyRTL8125::syncRxTxRings()
+{
+    UInt32 i;
+    
+    for (i = 0; i < kNumRxDesc; i++) {
+        if (*rxDescOpts1(rxNextDescIndex) & OSSwapHostToLittleInt32(DescOwn))
+            break;
+        
+        rearmRxDesc(rxNextDescIndex);
+        ++rxNextDescIndex &= kRxDescMask;
+    }
+    deadlockWarn = 0;
+}
+
+/*
+ * Hand Rx descriptor index back to the chip with its buffer. In the v3
+ * format the buffer's address is written again, as the chip overwrites
+ * it with the time stamp in PTP descriptors. The buffer has been mapped
+ * before, so that getPhysicalSegments() doesn't fail.
+ */
+void LucyRTL8125::rearmRxDesc(UInt32 index)
+{
+    IOPhysicalSegment rxSegment;
+    UInt32 opts1;
+    
+    if (rxDescV3 && (rxMbufCursor->getPhysicalSegments(rxMbufArray[index], &rxSegment, 1) == 1))
+        *rxDescAddr(index) = OSSwapHostToLittleInt64(rxSegment.location);
+    
+    opts1 = rxBufferSize;
+    opts1 |= (index == kRxLastDesc) ? (RingEnd | DescOwn) : DescOwn;
+    *rxDescOpts2(index) = 0;
+    *rxDescOpts1(index) = OSSwapHostToLittleInt32(opts1);
+}
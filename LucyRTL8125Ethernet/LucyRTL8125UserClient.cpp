@@ -0,0 +1,379 @@
+/* LucyRTL8125UserClient.cpp -- RTL8125 user client.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*
+* This driver is based on Realtek's r8125 Linux driver (9.003.04).
+*/
+
+#include "LucyRTL8125Ethernet.hpp"
+
+OSDefineMetaClassAndStructors(LucyRTL8125UserClient, IOUserClient)
+
+const IOExternalMethodDispatch LucyRTL8125UserClient::methods[kRtlMethodCount] = {
+    { &LucyRTL8125UserClient::methodDump, 1, 0, 0, kIOUCVariableStructureSize },
+    { &LucyRTL8125UserClient::methodPtp, 0, 0, 3, 0 },
+    { &LucyRTL8125UserClient::methodPtp, 2, 0, 0, 0 },
+    { &LucyRTL8125UserClient::methodPtp, 1, 0, 0, 0 },
+    { &LucyRTL8125UserClient::methodPtp, 1, 0, 0, 0 },
+    { &LucyRTL8125UserClient::methodPtp, 1, 0, 0, 0 },
+    { &LucyRTL8125UserClient::methodPtpStamps, 0, 0, 0, sizeof(RtlPtpStampBuffer) },
+    { &LucyRTL8125UserClient::methodSelfTest, 0, sizeof(RtlSelfTestParams), 0, sizeof(RtlSelfTestResult) },
+    { &LucyRTL8125UserClient::methodPktGen, 0, sizeof(RtlPktGenParams), 0, 0 },
+    { &LucyRTL8125UserClient::methodPktGen, 0, 0, 0, 0 },
+    { &LucyRTL8125UserClient::methodPktGen, 0, 0, 0, sizeof(RtlPktGenStatus) },
+    { &LucyRTL8125UserClient::methodCapture, 3, 0, 0, 0 },
+    { &LucyRTL8125UserClient::methodCapture, 0, 0, 0, 0 },
+    { &LucyRTL8125UserClient::methodUserQueue, 1, 0, 0, 0 },
+    { &LucyRTL8125UserClient::methodUserQueue, 0, 0, 0, 0 },
+    { &LucyRTL8125UserClient::methodUserQueue, 0, 0, 0, 0 }
+};
+
+bool LucyRTL8125UserClient::initWithTask(task_t owningTask, void *securityID, UInt32 type, OSDictionary *properties)
+{
+    bool result = false;
+    
+    if (!IOUserClient::initWithTask(owningTask, securityID, type, properties))
+        goto done;
+    
+    driver = NULL;
+    owner = owningTask;
+    privileged = (clientHasPrivilege(securityID, kIOClientPrivilegeAdministrator) == kIOReturnSuccess);
+    result = true;
+    
+done:
+    return result;
+}
+
+bool LucyRTL8125UserClient::start(IOService *provider)
+{
+    bool result = false;
+    
+    driver = OSDynamicCast(LucyRTL8125, provider);
+    
+    if (!driver) {
+        IOLog("No provider.\n");
+        goto done;
+    }
+    result = IOUserClient::start(provider);
+    
+done:
+    return result;
+}
+
+void LucyRTL8125UserClient::stop(IOService *provider)
+{
+    if (driver)
+        driver->releaseClient(this);
+    
+    driver = NULL;
+    
+    IOUserClient::stop(provider);
+}
+
+IOReturn LucyRTL8125UserClient::clientClose()
+{
+    /* Don't leave anything running on behalf of a closed client. */
+    if (driver)
+        driver->releaseClient(this);
+    
+    terminate();
+    
+    return kIOReturnSuccess;
+}
+
+/*
+ * The statistics page is mapped read-only, so that a client can't
+ * disturb other readers. The capture ring and the user queue must be
+ * writable in order to return blocks and slots. As they expose all
+ * traffic, they are restricted to administrators.
+ */
+IOReturn LucyRTL8125UserClient::clientMemoryForType(UInt32 type, IOOptionBits *options, IOMemoryDescriptor **memory)
+{
+    IOReturn result = kIOReturnUnsupported;
+    
+    if (!driver) {
+        result = kIOReturnNotAttached;
+        goto done;
+    }
+    switch (type) {
+        case kRtlMemoryStatsPage:
+            if (!driver->statsPageDesc) {
+                result = kIOReturnNoMemory;
+                break;
+            }
+            driver->statsPageDesc->retain();
+            *memory = driver->statsPageDesc;
+            *options = kIOMapReadOnly;
+            result = kIOReturnSuccess;
+            break;
+            
+        case kRtlMemoryCaptureRing:
+            if (!privileged) {
+                result = kIOReturnNotPrivileged;
+                break;
+            }
+            *memory = driver->copyCaptureMemory();
+            
+            if (!*memory) {
+                result = kIOReturnNotReady;
+                break;
+            }
+            *options = 0;
+            result = kIOReturnSuccess;
+            break;
+            
+        case kRtlMemoryUserQueue:
+            if (!privileged) {
+                result = kIOReturnNotPrivileged;
+                break;
+            }
+            *memory = driver->copyUserQueueMemory();
+            
+            if (!*memory) {
+                result = kIOReturnNotReady;
+                break;
+            }
+            *options = 0;
+            result = kIOReturnSuccess;
+            break;
+            
+        default:
+            break;
+    }
+    
+done:
+    return result;
+}
+
+IOReturn LucyRTL8125UserClient::externalMethod(uint32_t selector, IOExternalMethodArguments *arguments, IOExternalMethodDispatch *dispatch, OSObject *target, void *reference)
+{
+    if (selector >= kRtlMethodCount)
+        return kIOReturnBadArgument;
+    
+    dispatch = (IOExternalMethodDispatch *)&methods[selector];
+    
+    if (!target)
+        target = this;
+    
+    return IOUserClient::externalMethod(selector, arguments, dispatch, target, reference);
+}
+
+/*
+ * Dumps larger than the inline structure limit are returned through
+ * the output memory descriptor.
+ */
+IOReturn LucyRTL8125UserClient::methodDump(OSObject *target, void *reference, IOExternalMethodArguments *arguments)
+{
+    LucyRTL8125UserClient *client = OSDynamicCast(LucyRTL8125UserClient, target);
+    IOMemoryDescriptor *desc = arguments->structureOutputDescriptor;
+    void *buffer = NULL;
+    UInt32 capacity, size;
+    IOReturn result = kIOReturnBadArgument;
+    
+    if (!client)
+        goto done;
+    
+    if (!client->driver) {
+        result = kIOReturnNotAttached;
+        goto done;
+    }
+    if (!client->privileged) {
+        result = kIOReturnNotPrivileged;
+        goto done;
+    }
+    capacity = (UInt32)(desc ? desc->getLength() : arguments->structureOutputSize);
+    
+    if (capacity > kRtlDumpMaxSize)
+        capacity = kRtlDumpMaxSize;
+    
+    buffer = IOMalloc(capacity);
+    
+    if (!buffer) {
+        result = kIOReturnNoMemory;
+        goto done;
+    }
+    size = capacity;
+    result = client->driver->dumpState((UInt32)arguments->scalarInput[0], buffer, &size);
+    
+    if (result != kIOReturnSuccess)
+        goto done;
+    
+    if (desc) {
+        if (desc->writeBytes(0, buffer, size) != size)
+            result = kIOReturnIOError;
+        
+        arguments->structureOutputDescriptorSize = size;
+    } else {
+        memcpy(arguments->structureOutput, buffer, size);
+        arguments->structureOutputSize = size;
+    }
+    
+done:
+    if (buffer)
+        IOFree(buffer, capacity);
+    
+    return result;
+}
+
+/*
+ * The selector is passed on as the PTP request. Reading the clock is
+ * allowed for everybody, changing it requires administrator privileges.
+ */
+IOReturn LucyRTL8125UserClient::methodPtp(OSObject *target, void *reference, IOExternalMethodArguments *arguments)
+{
+    LucyRTL8125UserClient *client = OSDynamicCast(LucyRTL8125UserClient, target);
+    UInt64 values[3] = { 0, 0, 0 };
+    UInt32 i;
+    IOReturn result = kIOReturnBadArgument;
+    
+    if (!client)
+        goto done;
+    
+    if (!client->driver) {
+        result = kIOReturnNotAttached;
+        goto done;
+    }
+    if ((arguments->selector != kRtlMethodPtpGetTime) && !client->privileged) {
+        result = kIOReturnNotPrivileged;
+        goto done;
+    }
+    for (i = 0; i < arguments->scalarInputCount; i++)
+        values[i] = arguments->scalarInput[i];
+    
+    result = client->driver->ptpRequest(arguments->selector, values);
+    
+    for (i = 0; i < arguments->scalarOutputCount; i++)
+        arguments->scalarOutput[i] = values[i];
+    
+done:
+    return result;
+}
+
+/* Reading the stamps removes them, so it's restricted to administrators. */
+IOReturn LucyRTL8125UserClient::methodPtpStamps(OSObject *target, void *reference, IOExternalMethodArguments *arguments)
+{
+    LucyRTL8125UserClient *client = OSDynamicCast(LucyRTL8125UserClient, target);
+    IOReturn result = kIOReturnBadArgument;
+    
+    if (!client)
+        goto done;
+    
+    if (!client->driver) {
+        result = kIOReturnNotAttached;
+        goto done;
+    }
+    if (!client->privileged) {
+        result = kIOReturnNotPrivileged;
+        goto done;
+    }
+    result = client->driver->ptpGetStamps((RtlPtpStampBuffer *)arguments->structureOutput);
+    
+done:
+    return result;
+}
+
+/* The self test takes over the rings, so it's restricted to administrators. */
+IOReturn LucyRTL8125UserClient::methodSelfTest(OSObject *target, void *reference, IOExternalMethodArguments *arguments)
+{
+    LucyRTL8125UserClient *client = OSDynamicCast(LucyRTL8125UserClient, target);
+    IOReturn result = kIOReturnBadArgument;
+    
+    if (!client)
+        goto done;
+    
+    if (!client->driver) {
+        result = kIOReturnNotAttached;
+        goto done;
+    }
+    if (!client->privileged) {
+        result = kIOReturnNotPrivileged;
+        goto done;
+    }
+    result = client->driver->runSelfTest((const RtlSelfTestParams *)arguments->structureInput, (RtlSelfTestResult *)arguments->structureOutput);
+    
+done:
+    return result;
+}
+
+/*
+ * The selector is passed on as the generator request. Reading the
+ * status is allowed for everybody.
+ */
+IOReturn LucyRTL8125UserClient::methodPktGen(OSObject *target, void *reference, IOExternalMethodArguments *arguments)
+{
+    LucyRTL8125UserClient *client = OSDynamicCast(LucyRTL8125UserClient, target);
+    IOReturn result = kIOReturnBadArgument;
+    
+    if (!client)
+        goto done;
+    
+    if (!client->driver) {
+        result = kIOReturnNotAttached;
+        goto done;
+    }
+    if ((arguments->selector != kRtlMethodPktGenStatus) && !client->privileged) {
+        result = kIOReturnNotPrivileged;
+        goto done;
+    }
+    result = client->driver->pktGenRequest(arguments->selector, (const RtlPktGenParams *)arguments->structureInput, (RtlPktGenStatus *)arguments->structureOutput);
+    
+done:
+    return result;
+}
+
+IOReturn LucyRTL8125UserClient::methodCapture(OSObject *target, void *reference, IOExternalMethodArguments *arguments)
+{
+    LucyRTL8125UserClient *client = OSDynamicCast(LucyRTL8125UserClient, target);
+    IOReturn result = kIOReturnBadArgument;
+    
+    if (!client)
+        goto done;
+    
+    if (!client->driver) {
+        result = kIOReturnNotAttached;
+        goto done;
+    }
+    if (!client->privileged) {
+        result = kIOReturnNotPrivileged;
+        goto done;
+    }
+    result = client->driver->captureRequest(client, arguments->selector, arguments->scalarInput);
+    
+done:
+    return result;
+}
+
+IOReturn LucyRTL8125UserClient::methodUserQueue(OSObject *target, void *reference, IOExternalMethodArguments *arguments)
+{
+    LucyRTL8125UserClient *client = OSDynamicCast(LucyRTL8125UserClient, target);
+    IOReturn result = kIOReturnBadArgument;
+    
+    if (!client)
+        goto done;
+    
+    if (!client->driver) {
+        result = kIOReturnNotAttached;
+        goto done;
+    }
+    if (!client->privileged) {
+        result = kIOReturnNotPrivileged;
+        goto done;
+    }
+    result = client->driver->userQueueRequest(client, arguments->selector, (arguments->scalarInputCount) ? (UInt32)arguments->scalarInput[0] : 0);
+    
+done:
+    return result;
+}
@@ -0,0 +1,430 @@
+/* LucyRTL8125UserClient.hpp -- RTL8125 user client definitions.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*
+* This driver is based on Realtek's r8125 Linux driver (9.003.04).
+*/
+
+#ifndef LucyRTL8125UserClient_hpp
+#define LucyRTL8125UserClient_hpp
+
+/*
+ * The definitions up to the class declaration are shared with user
+ * space tools, which include this header with the IOKit framework's
+ * headers.
+ */
+#include <IOKit/IOTypes.h>
+#include <IOKit/network/IONetworkStats.h>
+#include <IOKit/network/IOEthernetStats.h>
+
+/* Memory types for IOConnectMapMemory64(). */
+enum {
+    kRtlMemoryStatsPage = 0,
+    kRtlMemoryCaptureRing,
+    kRtlMemoryUserQueue,
+};
+
+#define kRtlStatsPageVersion    1
+#define kRtlStatsPageMaxTally   48
+#define kRtlStatsPageMaxPath    32
+
+/*
+ * Statistics page shared read-only with user space. It's updated every
+ * 100ms while the interface is enabled and once more when it's disabled.
+ * The data path counters are live, the tally counters are dumped once
+ * per second.
+ *
+ * The page is protected by a sequence lock: seq is odd while an update
+ * is in progress. A reader copies the page and retries in case seq was
+ * odd before or has changed after the copy. Both reads of seq must be
+ * ordered with respect to the copy by a read barrier.
+ *
+ * tally[] holds the accumulated tally counters in the order of the
+ * "HardwareStatistics" table, path[] the counters of
+ * "DataPathStatistics".
+ */
+typedef struct RtlStatsPage {
+    volatile UInt32 seq;
+    UInt32 version;
+    UInt32 size;
+    UInt32 linkUp;
+    UInt64 updateTime;      /* ns since boot */
+    UInt32 speed;           /* Mbit/s */
+    UInt32 duplex;
+    UInt32 flowControl;
+    UInt32 mtu;
+    UInt32 rxRingSize;
+    UInt32 txRingSize;
+    UInt32 txFreeDesc;
+    UInt32 rxSpareBuffers;
+    UInt32 tallyCount;
+    UInt32 pathCount;
+    IONetworkStats netStats;
+    IOEthernetStats etherStats;
+    UInt64 tally[kRtlStatsPageMaxTally];
+    UInt64 path[kRtlStatsPageMaxPath];
+} RtlStatsPage;
+
+/* Selectors for IOConnectCallMethod(). */
+enum {
+    kRtlMethodDump = 0,     /* in: dump type, out: RtlDumpHeader + data */
+    kRtlMethodPtpGetTime,   /* out: seconds, ns, host time in ns */
+    kRtlMethodPtpSetTime,   /* in: seconds, ns */
+    kRtlMethodPtpAdjTime,   /* in: signed offset in ns */
+    kRtlMethodPtpAdjFreq,   /* in: signed rate offset in ppb */
+    kRtlMethodPtpStamps,    /* in: 1 to enable event time stamps, 0 to disable */
+    kRtlMethodPtpGetStamps, /* out: RtlPtpStampBuffer */
+    kRtlMethodSelfTest,     /* in: RtlSelfTestParams, out: RtlSelfTestResult */
+    kRtlMethodPktGenStart,  /* in: RtlPktGenParams */
+    kRtlMethodPktGenStop,
+    kRtlMethodPktGenStatus, /* out: RtlPktGenStatus */
+    kRtlMethodCaptureStart, /* in: snap length, block size, blocks per ring */
+    kRtlMethodCaptureStop,
+    kRtlMethodUserQueueStart,   /* in: rx ethertype, 0 for tx only */
+    kRtlMethodUserQueueStop,
+    kRtlMethodUserQueueTxSync,
+    kRtlMethodCount
+};
+
+/*
+ * Snapshots modeled on the proc handlers of the Linux driver. They
+ * require administrator privileges as reading the PHY selects page 0.
+ */
+enum RtlDumpType {
+    kRtlDumpMacRegs = 0,    /* 256 bytes of MAC registers */
+    kRtlDumpExtRegs,        /* 64 dwords of ERI registers */
+    kRtlDumpEthPhy,         /* 16 words of PHY registers, page 0 */
+    kRtlDumpPciePhy,        /* 31 words of PCIe PHY registers */
+    kRtlDumpTally,          /* 64 bit tally totals, see tally[] */
+    kRtlDumpRxRing,         /* RtlRingState + rx descriptors, 32 bytes in v3 format */
+    kRtlDumpTxRing,         /* RtlRingState + tx descriptors */
+    kRtlDumpTypeCount
+};
+
+#define kRtlDumpVersion 1
+
+/* Each dump starts with this header, followed by count elements. */
+typedef struct RtlDumpHeader {
+    UInt32 type;
+    UInt32 version;
+    UInt32 count;
+    UInt32 elementSize;
+    UInt64 time;            /* ns since boot */
+} RtlDumpHeader;
+
+/*
+ * Precedes the descriptors of a ring dump. The descriptors are in the
+ * chip's little endian format.
+ */
+typedef struct RtlRingState {
+    UInt32 numDesc;
+    UInt32 nextIndex;
+    UInt32 dirtyIndex;      /* tx only */
+    UInt32 numFree;         /* tx only */
+    UInt32 swTailPtr;       /* tx only */
+    UInt32 hwClosePtr;      /* tx only */
+} RtlRingState;
+
+/*
+ * The PTP clock's rate may be changed by up to kRtlPtpMaxFreqPpb in
+ * either direction. Changes of time and rate are applied to the clock
+ * in software, see LucyRTL8125Ptp.hpp.
+ */
+#define kRtlPtpMaxFreqPpb   1000000
+
+/*
+ * Time stamps of PTP event messages. While they are enabled, the driver
+ * records when Sync, Delay_Req, Pdelay_Req and Pdelay_Resp messages were
+ * sent or received, in the time of the PTP clock. As they can't be
+ * attached to the packets, clients match them to their messages by
+ * direction, messageType, sequenceId and sourcePort.
+ *
+ * The chip stamps one sent message at a time. Event messages sent while
+ * a tx stamp is pending aren't stamped and are counted in txSkipped.
+ * The driver keeps up to kRtlPtpMaxStamps stamps, kRtlMethodPtpGetStamps
+ * returns and removes them. The counters cover the time since the
+ * previous call.
+ */
+#define kRtlPtpMaxStamps    32
+
+enum {
+    kRtlPtpStampRx = 0,
+    kRtlPtpStampTx
+};
+
+typedef struct RtlPtpStamp {
+    UInt64 time;            /* ns */
+    UInt8 direction;
+    UInt8 messageType;
+    UInt16 sequenceId;
+    UInt8 domain;
+    UInt8 reserved;
+    UInt8 sourcePort[10];   /* sourcePortIdentity as sent */
+} RtlPtpStamp;
+
+typedef struct RtlPtpStampBuffer {
+    UInt32 count;
+    UInt32 dropped;         /* stamps lost as the queue was full */
+    UInt32 txSkipped;
+    UInt32 txTimeouts;      /* tx stamps the chip didn't deliver */
+    RtlPtpStamp stamp[kRtlPtpMaxStamps];
+} RtlPtpStampBuffer;
+
+/* Loopback modes of the self test. */
+enum {
+    kRtlLoopbackMAC = 0,
+    kRtlLoopbackCount
+};
+
+typedef struct RtlSelfTestParams {
+    UInt32 mode;
+    UInt32 frameSize;       /* without FCS, 60 to 1514 bytes */
+    UInt32 count;
+    UInt32 timeoutMS;
+} RtlSelfTestParams;
+
+/*
+ * Results of a self test. Frames which didn't come back before the
+ * timeout are lost, frames which came back with a wrong length or
+ * content are errors. Only frames of the test's ethertype are counted,
+ * other traffic received meanwhile goes to the stack. cpuPerFrame is
+ * the driver's busy time on the tx and rx path per frame.
+ */
+typedef struct RtlSelfTestResult {
+    UInt64 txFrames;
+    UInt64 rxFrames;
+    UInt64 lostFrames;
+    UInt64 errorFrames;
+    UInt64 duration;        /* ns */
+    UInt64 framesPerSec;
+    UInt64 mbitPerSec;
+    UInt64 cpuPerFrame;     /* ns */
+} RtlSelfTestResult;
+
+#define kRtlPktGenMaxFlows  8
+
+/*
+ * Packet generator setup. The frames are UDP datagrams from
+ * 198.18.0.1 to 198.18.0.2, port 9, one source port per flow. A burst
+ * is the number of frames the generator may post at once, which limits
+ * how far it may fall behind the rate before frames are dropped.
+ */
+typedef struct RtlPktGenParams {
+    UInt32 frameSize;       /* without FCS, 60 to 1514 bytes */
+    UInt32 rate;            /* frames per second, 0 for line rate */
+    UInt32 burst;
+    UInt32 flows;           /* 1 to kRtlPktGenMaxFlows */
+    UInt64 count;           /* 0 to run until stopped */
+    UInt8 dstAddr[6];       /* all zero for broadcast */
+    UInt8 reserved[2];
+} RtlPktGenParams;
+
+/*
+ * Packet generator counters. Dropped frames are those the generator
+ * couldn't post in time to keep up with the rate, ringFull counts the
+ * posts cut short by the descriptors reserved for normal traffic.
+ */
+typedef struct RtlPktGenStatus {
+    UInt32 running;
+    UInt32 reserved;
+    UInt64 sentFrames;
+    UInt64 droppedFrames;
+    UInt64 ringFull;
+    UInt64 duration;        /* ns */
+    UInt64 framesPerSec;
+    UInt64 mbitPerSec;
+} RtlPktGenStatus;
+
+/*
+ * Capture ring, modeled on Linux's TPACKET_V3. The mapped area starts
+ * with an RtlCaptureHeader, followed by the blocks of the rx ring and
+ * then those of the tx ring, each blockSize bytes.
+ *
+ * A block is owned by the driver while its status is kRtlBlockKernel.
+ * The driver fills it with packets and hands it to the consumer by
+ * setting status to kRtlBlockUser, either when the next packet doesn't
+ * fit or when the block's first packet is older than the retire
+ * timeout. As blocks are checked every kRtlCaptureRetireMS, a partially
+ * filled block is handed over within twice that time. The consumer
+ * processes the blocks of a ring in order and returns each one by
+ * setting status back to kRtlBlockKernel. It must issue a read barrier
+ * after seeing kRtlBlockUser and a full barrier before returning the
+ * block. If the next block is still owned by the consumer, packets are
+ * dropped and counted in the ring's drops.
+ *
+ * A block's packets start at firstOffset, each one is an
+ * RtlCapturePacket followed by capLen bytes of the frame. The next
+ * packet starts nextOffset bytes after the current one.
+ *
+ * Only the client which started the capture may stop it. It's stopped
+ * as well when that client is closed.
+ */
+#define kRtlCaptureVersion          1
+#define kRtlCaptureDefaultSnapLen   128
+#define kRtlCaptureMaxSnapLen       9216
+#define kRtlCaptureDefaultBlockSize 65536
+#define kRtlCaptureMaxBlockSize     (1024 * 1024)
+#define kRtlCaptureDefaultBlocks    16
+#define kRtlCaptureMaxBlocks        64
+#define kRtlCaptureRetireMS         10
+
+enum {
+    kRtlCaptureRx = 0,
+    kRtlCaptureTx,
+    kRtlCaptureRingCount
+};
+
+enum {
+    kRtlBlockKernel = 0,
+    kRtlBlockUser
+};
+
+typedef struct RtlCaptureRing {
+    UInt32 firstBlock;      /* offset from the start of the area */
+    UInt32 blockCount;
+    volatile UInt64 packets;
+    volatile UInt64 drops;
+} RtlCaptureRing;
+
+typedef struct RtlCaptureHeader {
+    UInt32 version;
+    UInt32 size;
+    UInt32 blockSize;
+    UInt32 snapLen;
+    UInt32 retireMS;
+    UInt32 reserved;
+    RtlCaptureRing ring[kRtlCaptureRingCount];
+} RtlCaptureHeader;
+
+typedef struct RtlCaptureBlock {
+    volatile UInt32 status;
+    UInt32 numPackets;
+    UInt32 firstOffset;
+    UInt32 length;          /* bytes used, including this header */
+    UInt64 seq;
+    UInt64 firstTime;       /* ns since boot */
+    UInt64 lastTime;
+} RtlCaptureBlock;
+
+typedef struct RtlCapturePacket {
+    UInt32 nextOffset;
+    UInt32 capLen;
+    UInt32 wireLen;         /* without FCS */
+    UInt32 status;          /* rx descriptor's opts1, 0 for tx */
+    UInt64 time;            /* ns since boot */
+    UInt16 vlanTag;
+    UInt16 reserved[3];
+} RtlCapturePacket;
+
+/*
+ * User queue, modeled on netmap. The mapped area starts with an
+ * RtlUserQueueHeader, the slots of the tx and rx ring follow at
+ * slotOffset, the packet buffers at bufOffset. A slot refers to a
+ * buffer by its index, the consumer may exchange buffers between slots
+ * as long as each one is used once.
+ *
+ * The consumer owns the slots from head up to, but not including,
+ * tail. It advances head after filling tx slots or processing rx slots,
+ * the driver advances tail. The tx ring is served by the chip's second
+ * tx queue: kRtlMethodUserQueueTxSync sends the slots up to head and
+ * reclaims the completed ones. A head which has moved past tail is
+ * counted in errors and rejected with kIOReturnBadArgument. The chip
+ * can't steer flows to its other rx queues, so frames of the chosen
+ * ethertype are copied from the normal rx ring to the rx slots as they
+ * arrive, tail being updated immediately. Frames which find no free
+ * slot are dropped.
+ *
+ * Only the client which started the user queue may sync or stop it.
+ * It's stopped as well when that client is closed.
+ */
+#define kRtlUserQueueVersion    1
+#define kRtlUserQueueSlots      256
+#define kRtlUserQueueBufs       1024
+#define kRtlUserQueueBufSize    2048
+
+enum {
+    kRtlUserQueueTx = 0,
+    kRtlUserQueueRx,
+    kRtlUserQueueRingCount
+};
+
+typedef struct RtlUserSlot {
+    UInt32 bufIndex;
+    UInt16 len;
+    UInt16 flags;
+} RtlUserSlot;
+
+typedef struct RtlUserRing {
+    UInt32 numSlots;
+    UInt32 slotOffset;      /* offset from the start of the area */
+    volatile UInt32 head;   /* written by the consumer */
+    volatile UInt32 tail;   /* written by the driver */
+    UInt64 packets;
+    UInt64 drops;
+    UInt64 errors;
+} RtlUserRing;
+
+typedef struct RtlUserQueueHeader {
+    UInt32 version;
+    UInt32 size;
+    UInt32 numBufs;
+    UInt32 bufSize;
+    UInt32 bufOffset;
+    UInt32 etherType;
+    RtlUserRing ring[kRtlUserQueueRingCount];
+} RtlUserQueueHeader;
+
+/* Size of the largest dump. */
+#define kRtlDumpMaxSize (sizeof(RtlDumpHeader) + sizeof(RtlRingState) + 1024 * 16)
+
+#ifdef KERNEL
+
+#include <IOKit/IOUserClient.h>
+
+class LucyRTL8125;
+
+class LucyRTL8125UserClient : public IOUserClient
+{
+
+    OSDeclareDefaultStructors(LucyRTL8125UserClient)
+
+public:
+    virtual bool initWithTask(task_t owningTask, void *securityID, UInt32 type, OSDictionary *properties) override;
+    virtual bool start(IOService *provider) override;
+    virtual void stop(IOService *provider) override;
+    virtual IOReturn clientClose() override;
+    virtual IOReturn clientMemoryForType(UInt32 type, IOOptionBits *options, IOMemoryDescriptor **memory) override;
+    virtual IOReturn externalMethod(uint32_t selector, IOExternalMethodArguments *arguments, IOExternalMethodDispatch *dispatch, OSObject *target, void *reference) override;
+
+private:
+    static IOReturn methodDump(OSObject *target, void *reference, IOExternalMethodArguments *arguments);
+    static IOReturn methodPtp(OSObject *target, void *reference, IOExternalMethodArguments *arguments);
+    static IOReturn methodPtpStamps(OSObject *target, void *reference, IOExternalMethodArguments *arguments);
+    static IOReturn methodSelfTest(OSObject *target, void *reference, IOExternalMethodArguments *arguments);
+    static IOReturn methodPktGen(OSObject *target, void *reference, IOExternalMethodArguments *arguments);
+    static IOReturn methodCapture(OSObject *target, void *reference, IOExternalMethodArguments *arguments);
+    static IOReturn methodUserQueue(OSObject *target, void *reference, IOExternalMethodArguments *arguments);
+
+    static const IOExternalMethodDispatch methods[kRtlMethodCount];
+
+    LucyRTL8125 *driver;
+    task_t owner;
+    bool privileged;
+};
+
+#endif /* KERNEL */
+
+#endif /* LucyRTL8125UserClient_hpp */
@@ -237,6 +237,13 @@ _OSReadInt8((base), (byteOffset))
 
 #define wmb() OSSynchronizeIO()
 
+/*
+ * Ordering of accesses to memory shared between CPUs. OSSynchronizeIO()
+ * is empty on x86, so that wmb() doesn't even stop the compiler.
+ */
+#define smp_wmb() __atomic_thread_fence(__ATOMIC_RELEASE)
+#define smp_rmb() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+
 /******************************************************************************/
 #pragma mark -
 #pragma mark Locks
@@ -266,12 +273,51 @@ if (*slock == NULL)                                   \
 
 #define spin_unlock_irqrestore(lock,flags)
 
+/*
+ * All callers of mdelay() run in thread context (work loop, command
+ * gate or start()), so millisecond delays sleep instead of spinning.
+ * Microsecond delays remain busy waits.
+ */
 #define usec_delay(x)           IODelay(x)
 #define msec_delay(x)           IOSleep(x)
 #define udelay(x)               IODelay(x)
-#define mdelay(x)               IODelay(1000*(x))
+#define mdelay(x)               IOSleep(x)
 #define msleep(x)               IOSleep(x)
 
+/*
+ * Polls cond until it becomes true or timeout_us has elapsed. The
+ * delay between two polls starts at 10µs and doubles after every
+ * attempt up to about 5ms. Delays below 1ms spin, longer ones sleep.
+ * The time spent waiting is returned in waited_us (UInt32). Evaluates
+ * to true in case cond has been met.
+ */
+#define poll_backoff_timeout(cond, timeout_us, waited_us) ({                   \
+    UInt64 __start, __now, __ns;                                               \
+    UInt32 __delay = 10;                                                       \
+    bool __done;                                                               \
+                                                                               \
+    clock_get_uptime(&__start);                                                \
+                                                                               \
+    for (;;) {                                                                 \
+        __done = (cond);                                                       \
+        clock_get_uptime(&__now);                                              \
+        absolutetime_to_nanoseconds(__now - __start, &__ns);                   \
+                                                                               \
+        if (__done || (__ns >= ((UInt64)(timeout_us) * 1000)))                 \
+            break;                                                             \
+                                                                               \
+        if (__delay < 1000)                                                    \
+            IODelay(__delay);                                                  \
+        else                                                                   \
+            IOSleep(__delay / 1000);                                           \
+                                                                               \
+        if (__delay < 4000)                                                    \
+            __delay <<= 1;                                                     \
+    }                                                                          \
+    (waited_us) = (UInt32)(__ns / 1000);                                       \
+    __done;                                                                    \
+})
+
 enum
 {
     GFP_KERNEL,
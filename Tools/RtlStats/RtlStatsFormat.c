@@ -0,0 +1,336 @@
+/* RtlStatsFormat.c -- Formatting of LucyRTL8125's diagnostics.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "RtlStatsFormat.h"
+
+typedef struct RtlBitName {
+    UInt32 bit;
+    const char *name;
+} RtlBitName;
+
+/* Interrupt status and mask bits of ISR0/IMR0. */
+static const RtlBitName intrBits[] = {
+    { 0x8000, "SYSErr" },
+    { 0x4000, "PCSTimeout" },
+    { 0x0100, "SWInt" },
+    { 0x0080, "TxDescUnavail" },
+    { 0x0040, "RxFIFOOver" },
+    { 0x0020, "LinkChg" },
+    { 0x0010, "RxDescUnavail" },
+    { 0x0008, "TxErr" },
+    { 0x0004, "TxOK" },
+    { 0x0002, "RxErr" },
+    { 0x0001, "RxOK" },
+    { 0, NULL }
+};
+
+/* Error bits of the PCI status register. */
+static const RtlBitName pciStatusBits[] = {
+    { 0x8000, "ParityError" },
+    { 0x4000, "SERR" },
+    { 0x2000, "MasterAbort" },
+    { 0x1000, "TargetAbort" },
+    { 0x0800, "SignaledTargetAbort" },
+    { 0, NULL }
+};
+
+static const char *dumpNames[kRtlDumpTypeCount] = {
+    "MAC registers",
+    "ERI registers",
+    "PHY registers",
+    "PCIe PHY registers",
+    "tally counters",
+    "rx ring",
+    "tx ring"
+};
+
+/* Same order as the driver's RtlRecoveryTier. */
+static const char *recoveryTiers[] = { "queue", "MAC", "chip" };
+
+/* Lists the names of the bits set in value, unknown ones in hex. */
+static void formatBits(char *buf, size_t size, UInt32 value, const RtlBitName *names)
+{
+    size_t len = 0;
+    
+    buf[0] = '\0';
+    
+    if (!value) {
+        snprintf(buf, size, "none");
+        return;
+    }
+    for (; names->name && (len < size); names++) {
+        if (value & names->bit) {
+            len += snprintf(buf + len, size - len, "%s%s", len ? "|" : "", names->name);
+            value &= ~names->bit;
+        }
+    }
+    if (value && (len < size))
+        snprintf(buf + len, size - len, "%s0x%x", len ? "|" : "", value);
+}
+
+static const char *tierName(UInt32 tier)
+{
+    return (tier < (sizeof(recoveryTiers) / sizeof(recoveryTiers[0]))) ? recoveryTiers[tier] : "unknown";
+}
+
+void RtlFormatTraceArgs(char *buf, size_t size, const RtlTraceRecord *record)
+{
+    const char *event = record->event;
+    char bits0[128], bits1[128];
+    
+    if (!strcmp(event, "interrupt")) {
+        formatBits(bits0, sizeof(bits0), record->arg0, intrBits);
+        formatBits(bits1, sizeof(bits1), record->arg1, intrBits);
+        snprintf(buf, size, "status %s, mask %s", bits0, bits1);
+    } else if (!strcmp(event, "intrMask")) {
+        formatBits(bits0, sizeof(bits0), record->arg0, intrBits);
+        snprintf(buf, size, "mask %s", bits0);
+    } else if (!strcmp(event, "pollMode")) {
+        formatBits(bits1, sizeof(bits1), record->arg1, intrBits);
+        snprintf(buf, size, "%s, mask %s", record->arg0 ? "on" : "off", bits1);
+    } else if (!strcmp(event, "rx")) {
+        snprintf(buf, size, "next %u, %u packets", record->arg0, record->arg1);
+    } else if (!strcmp(event, "txTail")) {
+        snprintf(buf, size, "tail %u, %u free", record->arg0, record->arg1);
+    } else if (!strcmp(event, "txClose")) {
+        snprintf(buf, size, "close %u, %u done", record->arg0, record->arg1);
+    } else if (!strcmp(event, "txHang")) {
+        /* Both pointers are 16 bit counters. */
+        snprintf(buf, size, "close %u, tail %u, %u pending", record->arg0, record->arg1,
+                 (record->arg1 - record->arg0) & 0xffff);
+    } else if (!strcmp(event, "pciError")) {
+        formatBits(bits1, sizeof(bits1), record->arg1, pciStatusBits);
+        snprintf(buf, size, "command 0x%04x, status %s", record->arg0, bits1);
+    } else if (!strcmp(event, "recovery")) {
+        snprintf(buf, size, "%s reset", tierName(record->arg0));
+    } else if (!strcmp(event, "recoveryDone")) {
+        snprintf(buf, size, "%s reset, %u µs outage", tierName(record->arg0), record->arg1);
+    } else {
+        snprintf(buf, size, "0x%08x 0x%08x", record->arg0, record->arg1);
+    }
+}
+
+void RtlPrintTimeline(FILE *out, RtlPhaseEntry *entries, unsigned int count, unsigned int width)
+{
+    RtlPhaseEntry entry;
+    UInt64 delta, maxDelta;
+    unsigned int first, end;
+    unsigned int i, j, bar;
+    
+    /* An insertion sort keeps markers with the same time in order. */
+    for (i = 1; i < count; i++) {
+        entry = entries[i];
+        
+        for (j = i; (j > 0) && (entries[j - 1].time > entry.time); j--)
+            entries[j] = entries[j - 1];
+        
+        entries[j] = entry;
+    }
+    for (first = 0; first < count; first = end) {
+        maxDelta = 0;
+        
+        for (end = first + 1; end < count; end++) {
+            delta = entries[end].time - entries[end - 1].time;
+            
+            if (!strcmp(entries[end].name, "start") || (delta > kRtlTimelineGapUS))
+                break;
+            
+            if (delta > maxDelta)
+                maxDelta = delta;
+        }
+        if (first)
+            fprintf(out, "\n");
+        
+        fprintf(out, "%llu.%06llu s since boot:\n", (unsigned long long)(entries[first].time / 1000000),
+                (unsigned long long)(entries[first].time % 1000000));
+        
+        for (i = first; i < end; i++) {
+            delta = (i > first) ? (entries[i].time - entries[i - 1].time) : 0;
+            bar = maxDelta ? (unsigned int)(((delta * width) + maxDelta - 1) / maxDelta) : 0;
+            
+            fprintf(out, "%10.3f ms %+10.3f ms  %s", (entries[i].time - entries[first].time) / 1000.0,
+                    delta / 1000.0, entries[i].name);
+            
+            if (bar) {
+                fprintf(out, "%*s", (int)(26 - strlen(entries[i].name)), "");
+                
+                for (j = 0; j < bar; j++)
+                    fputc('#', out);
+            }
+            fputc('\n', out);
+        }
+    }
+}
+
+void RtlPrintTrace(FILE *out, const char *reason, const RtlTraceRecord *records, unsigned int count)
+{
+    char args[300];
+    UInt64 last = count ? records[count - 1].time : 0;
+    unsigned int i;
+    
+    fprintf(out, "Trace snapshot for %s, %u entries:\n", reason, count);
+    
+    for (i = 0; i < count; i++) {
+        RtlFormatTraceArgs(args, sizeof(args), &records[i]);
+        fprintf(out, "%12.3f ms  %-13s %s\n", ((double)records[i].time - (double)last) / 1000.0, records[i].event, args);
+    }
+}
+
+static bool isRingDump(UInt32 type)
+{
+    return (type == kRtlDumpRxRing) || (type == kRtlDumpTxRing);
+}
+
+int RtlCheckDump(const void *dump, size_t size)
+{
+    const RtlDumpHeader *hdr = (const RtlDumpHeader *)dump;
+    size_t expected;
+    
+    if ((size < sizeof(RtlDumpHeader)) || (hdr->version != kRtlDumpVersion) || (hdr->type >= kRtlDumpTypeCount))
+        return EINVAL;
+    
+    /* Registers and counters are single values, descriptors 32 bit words. */
+    if (isRingDump(hdr->type) ? (!hdr->elementSize || (hdr->elementSize & 3)) :
+        ((hdr->elementSize > sizeof(UInt64)) || (hdr->elementSize & (hdr->elementSize - 1)) || !hdr->elementSize))
+        return EINVAL;
+    
+    expected = sizeof(RtlDumpHeader) + ((size_t)hdr->count * hdr->elementSize);
+    
+    if (isRingDump(hdr->type))
+        expected += sizeof(RtlRingState);
+    
+    return (size == expected) ? 0 : EINVAL;
+}
+
+/* Dumps are in host byte order except for the descriptors. */
+static UInt64 readValue(const UInt8 *p, UInt32 size)
+{
+    switch (size) {
+        case 1:
+            return *p;
+        
+        case 2:
+            return *(const UInt16 *)p;
+        
+        case 4:
+            return *(const UInt32 *)p;
+        
+        default:
+            return *(const UInt64 *)p;
+    }
+}
+
+static UInt32 readLE32(const UInt8 *p)
+{
+    return (UInt32)p[0] | ((UInt32)p[1] << 8) | ((UInt32)p[2] << 16) | ((UInt32)p[3] << 24);
+}
+
+static void printDesc(FILE *out, const UInt8 *desc, UInt32 size)
+{
+    UInt32 i;
+    
+    for (i = 0; i < size; i += 4)
+        fprintf(out, " %08x", readLE32(desc + i));
+}
+
+static int diffRingState(FILE *out, const RtlRingState *a, const RtlRingState *b)
+{
+    static const char *names[] = { "numDesc", "nextIndex", "dirtyIndex", "numFree", "swTailPtr", "hwClosePtr" };
+    const UInt32 *oldState = &a->numDesc;
+    const UInt32 *newState = &b->numDesc;
+    int diffs = 0;
+    UInt32 i;
+    
+    for (i = 0; i < (sizeof(names) / sizeof(names[0])); i++) {
+        if (oldState[i] != newState[i]) {
+            fprintf(out, "%-10s %u -> %u\n", names[i], oldState[i], newState[i]);
+            diffs++;
+        }
+    }
+    return diffs;
+}
+
+int RtlPrintDumpDiff(FILE *out, const void *oldDump, const void *newDump)
+{
+    const RtlDumpHeader *a = (const RtlDumpHeader *)oldDump;
+    const RtlDumpHeader *b = (const RtlDumpHeader *)newDump;
+    const UInt8 *oldData = (const UInt8 *)(a + 1);
+    const UInt8 *newData = (const UInt8 *)(b + 1);
+    UInt32 size = a->elementSize;
+    UInt64 oldValue, newValue;
+    int diffs = 0;
+    UInt32 i;
+    
+    if ((a->type != b->type) || (a->count != b->count) || (a->elementSize != b->elementSize))
+        return -1;
+    
+    fprintf(out, "%s, %.3f s apart:\n", dumpNames[a->type], ((double)b->time - (double)a->time) / 1e9);
+    
+    if (isRingDump(a->type)) {
+        diffs += diffRingState(out, (const RtlRingState *)oldData, (const RtlRingState *)newData);
+        oldData += sizeof(RtlRingState);
+        newData += sizeof(RtlRingState);
+    }
+    for (i = 0; i < a->count; i++) {
+        if (!memcmp(oldData + (i * size), newData + (i * size), size))
+            continue;
+        
+        diffs++;
+        
+        switch (a->type) {
+            case kRtlDumpMacRegs:
+            case kRtlDumpExtRegs:
+            case kRtlDumpEthPhy:
+            case kRtlDumpPciePhy:
+                /* MAC and ERI registers by address, PHY registers by number. */
+                oldValue = readValue(oldData + (i * size), size);
+                newValue = readValue(newData + (i * size), size);
+            
+                fprintf(out, "0x%03x: 0x%0*llx -> 0x%0*llx\n", (a->type < kRtlDumpEthPhy) ? (i * size) : i,
+                        (int)(size * 2), (unsigned long long)oldValue, (int)(size * 2), (unsigned long long)newValue);
+                break;
+            
+            case kRtlDumpTally:
+                oldValue = readValue(oldData + (i * size), size);
+                newValue = readValue(newData + (i * size), size);
+            
+                if (newValue >= oldValue)
+                    fprintf(out, "tally[%u]: %llu -> %llu (+%llu)\n", i, (unsigned long long)oldValue,
+                            (unsigned long long)newValue, (unsigned long long)(newValue - oldValue));
+                else
+                    fprintf(out, "tally[%u]: %llu -> %llu (reset)\n", i, (unsigned long long)oldValue,
+                            (unsigned long long)newValue);
+                break;
+            
+            default:
+                fprintf(out, "desc %u:", i);
+                printDesc(out, oldData + (i * size), size);
+                fprintf(out, " ->");
+                printDesc(out, newData + (i * size), size);
+                fputc('\n', out);
+                break;
+        }
+    }
+    fprintf(out, "%d differences\n", diffs);
+    
+    return diffs;
+}
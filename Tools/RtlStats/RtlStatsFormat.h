@@ -0,0 +1,93 @@
+/* RtlStatsFormat.h -- Formatting of LucyRTL8125's diagnostics.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#ifndef RtlStatsFormat_h
+#define RtlStatsFormat_h
+
+#include <stdio.h>
+
+#include "LucyRTL8125UserClient.hpp"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The command line tools get their input from the driver's properties
+ * and user client, the formatting here doesn't depend on IOKit so that
+ * it can be tested on Linux.
+ */
+
+/* Markers further apart than this start a new section of a timeline. */
+#define kRtlTimelineGapUS   (10 * 1000000ULL)
+
+/* One entry of the "PhaseMarkers" property. */
+typedef struct RtlPhaseEntry {
+    const char *name;
+    UInt64 time;            /* µs since boot */
+} RtlPhaseEntry;
+
+/*
+ * Print the phase markers as a timeline. entries is sorted by time in
+ * place, as markers set from the background bring-up may be out of
+ * order. Each driver start or long gap begins a new section, the bars
+ * show the time since the previous marker scaled to width columns for
+ * the longest one of the section.
+ */
+void RtlPrintTimeline(FILE *out, RtlPhaseEntry *entries, unsigned int count, unsigned int width);
+
+/* One entry of the "TraceSnapshot" property's "Entries" array. */
+typedef struct RtlTraceRecord {
+    const char *event;
+    UInt64 time;            /* µs since boot */
+    UInt32 arg0;
+    UInt32 arg1;
+} RtlTraceRecord;
+
+/*
+ * Decode the arguments of a trace record into buf, naming the
+ * interrupt and PCI status bits and the recovery tiers.
+ */
+void RtlFormatTraceArgs(char *buf, size_t size, const RtlTraceRecord *record);
+
+/*
+ * Print a trace snapshot taken for reason, one decoded record per line
+ * with its time relative to the last one, which is closest to the
+ * event that caused the snapshot.
+ */
+void RtlPrintTrace(FILE *out, const char *reason, const RtlTraceRecord *records, unsigned int count);
+
+/*
+ * Check a dump as returned by kRtlMethodDump. Returns 0 if header and
+ * size agree, EINVAL otherwise.
+ */
+int RtlCheckDump(const void *dump, size_t size);
+
+/*
+ * Print the differences between two checked dumps of the same type:
+ * registers with their old and new value, tally counters with their
+ * increase and ring descriptors along with the ring state. Returns the
+ * number of differences or -1 if the dumps can't be compared.
+ */
+int RtlPrintDumpDiff(FILE *out, const void *oldDump, const void *newDump);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RtlStatsFormat_h */
@@ -0,0 +1,147 @@
+/* RtlStatsReader.c -- Reader of LucyRTL8125's statistics page.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+
+#include "RtlStatsReader.h"
+
+/* Orders the loads before the barrier with respect to those after it. */
+#define rmb() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+
+/* Orders all memory accesses before the barrier with respect to those after it. */
+#define mb() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+int RtlStatsSnapshot(const volatile RtlStatsPage *page, RtlStatsPage *copy)
+{
+    UInt32 seq;
+    unsigned int i;
+    
+    for (i = 0; i < kRtlStatsMaxRetries; i++) {
+        seq = __atomic_load_n(&page->seq, __ATOMIC_RELAXED);
+        rmb();
+        
+        /* An update is in progress. */
+        if (seq & 1) {
+            sched_yield();
+            continue;
+        }
+        memcpy(copy, (const void *)page, sizeof(RtlStatsPage));
+        rmb();
+        
+        if (__atomic_load_n(&page->seq, __ATOMIC_RELAXED) != seq)
+            continue;
+        
+        if ((copy->version != kRtlStatsPageVersion) || (copy->size != sizeof(RtlStatsPage)) ||
+            (copy->tallyCount > kRtlStatsPageMaxTally) || (copy->pathCount > kRtlStatsPageMaxPath))
+            return EINVAL;
+        
+        return 0;
+    }
+    return EAGAIN;
+}
+
+RtlCaptureBlock *RtlCaptureNextBlock(void *area, UInt32 ring, UInt32 *index)
+{
+    RtlCaptureHeader *hdr = (RtlCaptureHeader *)area;
+    RtlCaptureBlock *block;
+    
+    block = (RtlCaptureBlock *)((UInt8 *)area + hdr->ring[ring].firstBlock + (*index * hdr->blockSize));
+    
+    if (__atomic_load_n(&block->status, __ATOMIC_RELAXED) != kRtlBlockUser)
+        return NULL;
+    
+    /* Don't read the block's content before its status. */
+    rmb();
+    
+    if (++(*index) >= hdr->ring[ring].blockCount)
+        *index = 0;
+    
+    return block;
+}
+
+void RtlCaptureReleaseBlock(RtlCaptureBlock *block)
+{
+    /* Finish reading the block before the driver may refill it. */
+    mb();
+    __atomic_store_n(&block->status, kRtlBlockKernel, __ATOMIC_RELAXED);
+}
+
+#ifdef __APPLE__
+
+io_service_t RtlStatsFindService(unsigned int index)
+{
+    io_iterator_t iter;
+    io_service_t service;
+    
+    if (IOServiceGetMatchingServices(kIOMasterPortDefault, IOServiceMatching("LucyRTL8125"), &iter) != KERN_SUCCESS)
+        return IO_OBJECT_NULL;
+    
+    while ((service = IOIteratorNext(iter)) && index) {
+        IOObjectRelease(service);
+        index--;
+    }
+    IOObjectRelease(iter);
+    
+    return service;
+}
+
+kern_return_t RtlStatsOpen(unsigned int index, RtlStatsHandle *handle)
+{
+    io_service_t service;
+    kern_return_t result;
+    
+    memset(handle, 0, sizeof(RtlStatsHandle));
+    
+    service = RtlStatsFindService(index);
+    
+    if (!service) {
+        result = kIOReturnNotFound;
+        goto done;
+    }
+    result = IOServiceOpen(service, mach_task_self(), 0, &handle->connect);
+    IOObjectRelease(service);
+    
+    if (result != KERN_SUCCESS)
+        goto done;
+    
+    result = IOConnectMapMemory64(handle->connect, kRtlMemoryStatsPage, mach_task_self(),
+                                  &handle->address, &handle->size, kIOMapAnywhere | kIOMapReadOnly);
+    
+    if (result != KERN_SUCCESS) {
+        IOServiceClose(handle->connect);
+        handle->connect = IO_OBJECT_NULL;
+    }
+    
+done:
+    return result;
+}
+
+void RtlStatsClose(RtlStatsHandle *handle)
+{
+    if (handle->address)
+        IOConnectUnmapMemory64(handle->connect, kRtlMemoryStatsPage, mach_task_self(), handle->address);
+    
+    if (handle->connect)
+        IOServiceClose(handle->connect);
+    
+    memset(handle, 0, sizeof(RtlStatsHandle));
+}
+
+#endif /* __APPLE__ */
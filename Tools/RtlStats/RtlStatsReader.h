@@ -0,0 +1,84 @@
+/* RtlStatsReader.h -- Reader of LucyRTL8125's statistics page.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#ifndef RtlStatsReader_h
+#define RtlStatsReader_h
+
+#include "LucyRTL8125UserClient.hpp"
+
+#ifdef __APPLE__
+#include <IOKit/IOKitLib.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Attempts to get a consistent copy before giving up. */
+#define kRtlStatsMaxRetries 1000
+
+/*
+ * Copy the statistics page following its sequence lock, see
+ * RtlStatsPage. Returns 0 on success, EAGAIN in case the page has been
+ * updated during each attempt and EINVAL in case of a layout mismatch.
+ */
+int RtlStatsSnapshot(const volatile RtlStatsPage *page, RtlStatsPage *copy);
+
+/*
+ * Consumer side of a capture ring, see RtlCaptureHeader. area is the
+ * mapped capture area, *index the consumer's position in the ring,
+ * starting at 0. Returns the block at *index if the driver has handed
+ * it over and advances *index, NULL otherwise. Each block must be
+ * returned with RtlCaptureReleaseBlock() once it has been processed.
+ */
+RtlCaptureBlock *RtlCaptureNextBlock(void *area, UInt32 ring, UInt32 *index);
+void RtlCaptureReleaseBlock(RtlCaptureBlock *block);
+
+#ifdef __APPLE__
+
+typedef struct RtlStatsHandle {
+    io_connect_t connect;
+    mach_vm_address_t address;
+    mach_vm_size_t size;
+} RtlStatsHandle;
+
+/*
+ * Return the index'th LucyRTL8125 instance or IO_OBJECT_NULL, the
+ * caller releases it.
+ */
+io_service_t RtlStatsFindService(unsigned int index);
+
+/*
+ * Open the index'th LucyRTL8125 instance and map its statistics page
+ * read-only. Reading the page doesn't require privileges.
+ */
+kern_return_t RtlStatsOpen(unsigned int index, RtlStatsHandle *handle);
+void RtlStatsClose(RtlStatsHandle *handle);
+
+static inline const volatile RtlStatsPage *RtlStatsGetPage(const RtlStatsHandle *handle)
+{
+    return (const volatile RtlStatsPage *)(uintptr_t)handle->address;
+}
+
+#endif /* __APPLE__ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RtlStatsReader_h */
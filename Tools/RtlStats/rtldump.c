@@ -0,0 +1,173 @@
+/* rtldump.c -- Saves and compares LucyRTL8125's register and ring dumps.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "RtlStatsReader.h"
+#include "RtlStatsFormat.h"
+
+/* Command line names of the dump types, in the order of RtlDumpType. */
+static const char *typeNames[kRtlDumpTypeCount] = { "mac", "eri", "phy", "ephy", "tally", "rx", "tx" };
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: rtldump save <mac|eri|phy|ephy|tally|rx|tx> <file> [index]\n"
+                    "       rtldump diff <old file> <new file>\n");
+}
+
+/*
+ * Read a dump saved before and check it. Returns a buffer which the
+ * caller frees or NULL.
+ */
+static void *readDump(const char *path)
+{
+    FILE *file;
+    void *buf;
+    size_t size;
+    
+    buf = malloc(kRtlDumpMaxSize + 1);
+    
+    if (!buf)
+        return NULL;
+    
+    file = fopen(path, "rb");
+    
+    if (!file) {
+        perror(path);
+        goto error;
+    }
+    size = fread(buf, 1, kRtlDumpMaxSize + 1, file);
+    fclose(file);
+    
+    if (RtlCheckDump(buf, size)) {
+        fprintf(stderr, "%s: not a complete dump of a compatible driver version.\n", path);
+        goto error;
+    }
+    return buf;
+    
+error:
+    free(buf);
+    return NULL;
+}
+
+static int diffDumps(const char *oldPath, const char *newPath)
+{
+    void *oldDump = readDump(oldPath);
+    void *newDump = readDump(newPath);
+    int result = 1;
+    
+    if (!oldDump || !newDump)
+        goto done;
+    
+    if (RtlPrintDumpDiff(stdout, oldDump, newDump) < 0) {
+        fprintf(stderr, "The dumps are of different types or ring sizes.\n");
+        goto done;
+    }
+    result = 0;
+    
+done:
+    free(oldDump);
+    free(newDump);
+    
+    return result;
+}
+
+#ifdef __APPLE__
+
+/* Requires administrator privileges like the driver's dump method. */
+static int saveDump(UInt32 type, const char *path, unsigned int index)
+{
+    RtlStatsHandle handle;
+    FILE *file = NULL;
+    void *buf;
+    size_t size = kRtlDumpMaxSize;
+    UInt64 input = type;
+    kern_return_t kr;
+    int result = 1;
+    
+    buf = malloc(kRtlDumpMaxSize);
+    
+    if (!buf)
+        return 1;
+    
+    kr = RtlStatsOpen(index, &handle);
+    
+    if (kr != KERN_SUCCESS) {
+        fprintf(stderr, "Couldn't open LucyRTL8125 instance %u: 0x%x\n", index, kr);
+        goto done;
+    }
+    kr = IOConnectCallMethod(handle.connect, kRtlMethodDump, &input, 1, NULL, 0, NULL, NULL, buf, &size);
+    RtlStatsClose(&handle);
+    
+    if (kr != KERN_SUCCESS) {
+        fprintf(stderr, "Dump failed: 0x%x\n", kr);
+        goto done;
+    }
+    file = fopen(path, "wb");
+    
+    if (!file || (fwrite(buf, 1, size, file) != size)) {
+        perror(path);
+        goto done;
+    }
+    result = 0;
+    
+done:
+    if (file)
+        fclose(file);
+    
+    free(buf);
+    
+    return result;
+}
+
+#endif /* __APPLE__ */
+
+/*
+ * Saves a dump to a file and compares two of them, e.g. before and
+ * after a link flap or a recovery. Comparing works on any host, so that
+ * dumps can be sent along with a bug report.
+ */
+int main(int argc, char *argv[])
+{
+    UInt32 type;
+    
+    if ((argc == 4) && !strcmp(argv[1], "diff"))
+        return diffDumps(argv[2], argv[3]);
+    
+    if (((argc == 4) || (argc == 5)) && !strcmp(argv[1], "save")) {
+        for (type = 0; type < kRtlDumpTypeCount; type++) {
+            if (!strcmp(argv[2], typeNames[type]))
+                break;
+        }
+        if (type == kRtlDumpTypeCount)
+            goto error;
+        
+#ifdef __APPLE__
+        return saveDump(type, argv[3], (argc == 5) ? (unsigned int)strtoul(argv[4], NULL, 0) : 0);
+#else
+        fprintf(stderr, "Saving dumps requires macOS.\n");
+        return 1;
+#endif
+    }
+    
+error:
+    usage();
+    return 1;
+}
@@ -0,0 +1,98 @@
+/* rtlphases.c -- Shows LucyRTL8125's start-up and link-up timeline.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <CoreFoundation/CoreFoundation.h>
+
+#include "RtlStatsReader.h"
+#include "RtlStatsFormat.h"
+
+#define kBarWidth   40
+#define kNameSize   32
+
+/*
+ * Usage: rtlphases [index]
+ *
+ * Renders the "PhaseMarkers" property of the index'th LucyRTL8125
+ * instance, which the driver updates after setupRTL8125() and each
+ * link-up.
+ */
+int main(int argc, char *argv[])
+{
+    io_service_t service;
+    CFArrayRef markers = NULL;
+    CFDictionaryRef dict;
+    CFStringRef name;
+    CFNumberRef time;
+    RtlPhaseEntry *entries = NULL;
+    char (*names)[kNameSize] = NULL;
+    unsigned int index = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 0) : 0;
+    CFIndex count, i;
+    unsigned int n = 0;
+    int result = 1;
+    
+    service = RtlStatsFindService(index);
+    
+    if (!service) {
+        fprintf(stderr, "LucyRTL8125 instance %u not found.\n", index);
+        goto done;
+    }
+    markers = (CFArrayRef)IORegistryEntryCreateCFProperty(service, CFSTR("PhaseMarkers"), kCFAllocatorDefault, 0);
+    IOObjectRelease(service);
+    
+    if (!markers || (CFGetTypeID(markers) != CFArrayGetTypeID())) {
+        fprintf(stderr, "No phase markers published yet.\n");
+        goto done;
+    }
+    count = CFArrayGetCount(markers);
+    entries = (RtlPhaseEntry *)calloc(count ? count : 1, sizeof(RtlPhaseEntry));
+    names = (char (*)[kNameSize])calloc(count ? count : 1, kNameSize);
+    
+    if (!entries || !names)
+        goto done;
+    
+    for (i = 0; i < count; i++) {
+        dict = (CFDictionaryRef)CFArrayGetValueAtIndex(markers, i);
+        
+        if (CFGetTypeID(dict) != CFDictionaryGetTypeID())
+            continue;
+        
+        name = (CFStringRef)CFDictionaryGetValue(dict, CFSTR("Phase"));
+        time = (CFNumberRef)CFDictionaryGetValue(dict, CFSTR("Time"));
+        
+        if (!name || !time || !CFStringGetCString(name, names[n], kNameSize, kCFStringEncodingUTF8) ||
+            !CFNumberGetValue(time, kCFNumberSInt64Type, &entries[n].time))
+            continue;
+        
+        entries[n].name = names[n];
+        n++;
+    }
+    RtlPrintTimeline(stdout, entries, n, kBarWidth);
+    result = 0;
+    
+done:
+    if (markers)
+        CFRelease(markers);
+    
+    free(entries);
+    free(names);
+    
+    return result;
+}
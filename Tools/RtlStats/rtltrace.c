@@ -0,0 +1,116 @@
+/* rtltrace.c -- Decodes LucyRTL8125's trace snapshot.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <CoreFoundation/CoreFoundation.h>
+
+#include "RtlStatsReader.h"
+#include "RtlStatsFormat.h"
+
+#define kNameSize   32
+
+static bool getNumber(CFDictionaryRef dict, CFStringRef key, CFNumberType type, void *value)
+{
+    CFNumberRef num = (CFNumberRef)CFDictionaryGetValue(dict, key);
+    
+    return num && (CFGetTypeID(num) == CFNumberGetTypeID()) && CFNumberGetValue(num, type, value);
+}
+
+/*
+ * Usage: rtltrace [index]
+ *
+ * Decodes the "TraceSnapshot" property of the index'th LucyRTL8125
+ * instance, which the driver takes on a tx hang or a PCI error.
+ */
+int main(int argc, char *argv[])
+{
+    io_service_t service;
+    CFDictionaryRef snapshot = NULL;
+    CFArrayRef entries;
+    CFDictionaryRef dict;
+    CFStringRef str;
+    RtlTraceRecord *records = NULL;
+    char (*names)[kNameSize] = NULL;
+    char reason[kNameSize] = "unknown";
+    unsigned int index = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 0) : 0;
+    CFIndex count, i;
+    unsigned int n = 0;
+    int result = 1;
+    
+    service = RtlStatsFindService(index);
+    
+    if (!service) {
+        fprintf(stderr, "LucyRTL8125 instance %u not found.\n", index);
+        goto done;
+    }
+    snapshot = (CFDictionaryRef)IORegistryEntryCreateCFProperty(service, CFSTR("TraceSnapshot"), kCFAllocatorDefault, 0);
+    IOObjectRelease(service);
+    
+    if (!snapshot || (CFGetTypeID(snapshot) != CFDictionaryGetTypeID())) {
+        fprintf(stderr, "No trace snapshot has been taken.\n");
+        goto done;
+    }
+    str = (CFStringRef)CFDictionaryGetValue(snapshot, CFSTR("Reason"));
+    
+    if (str && (CFGetTypeID(str) == CFStringGetTypeID()))
+        CFStringGetCString(str, reason, sizeof(reason), kCFStringEncodingUTF8);
+    
+    entries = (CFArrayRef)CFDictionaryGetValue(snapshot, CFSTR("Entries"));
+    
+    if (!entries || (CFGetTypeID(entries) != CFArrayGetTypeID())) {
+        fprintf(stderr, "Malformed trace snapshot.\n");
+        goto done;
+    }
+    count = CFArrayGetCount(entries);
+    records = (RtlTraceRecord *)calloc(count ? count : 1, sizeof(RtlTraceRecord));
+    names = (char (*)[kNameSize])calloc(count ? count : 1, kNameSize);
+    
+    if (!records || !names)
+        goto done;
+    
+    for (i = 0; i < count; i++) {
+        dict = (CFDictionaryRef)CFArrayGetValueAtIndex(entries, i);
+        
+        if (CFGetTypeID(dict) != CFDictionaryGetTypeID())
+            continue;
+        
+        str = (CFStringRef)CFDictionaryGetValue(dict, CFSTR("Event"));
+        
+        if (!str || !CFStringGetCString(str, names[n], kNameSize, kCFStringEncodingUTF8) ||
+            !getNumber(dict, CFSTR("Time"), kCFNumberSInt64Type, &records[n].time) ||
+            !getNumber(dict, CFSTR("Arg0"), kCFNumberSInt32Type, &records[n].arg0) ||
+            !getNumber(dict, CFSTR("Arg1"), kCFNumberSInt32Type, &records[n].arg1))
+            continue;
+        
+        records[n].event = names[n];
+        n++;
+    }
+    RtlPrintTrace(stdout, reason, records, n);
+    result = 0;
+    
+done:
+    if (snapshot)
+        CFRelease(snapshot);
+    
+    free(records);
+    free(names);
+    
+    return result;
+}
@@ -0,0 +1,358 @@
+/* BlockRingTest.c -- Tests of the capture ring's block handover.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "RtlStatsReader.h"
+
+#define kPackets    1000000
+#define kPageSize   4096
+#define kBlockSize  4096
+#define kBlocks     4
+#define kSnapLen    64
+
+/* Close a block after this many packets to emulate the retire timer. */
+#define kRetireEvery    37
+
+/* Stores before the barrier become visible before those after it. */
+#define wmb() __atomic_thread_fence(__ATOMIC_RELEASE)
+
+/* Same as LucyRTL8125's RtlCaptureState. */
+typedef struct CaptureState {
+    UInt32 block;
+    UInt32 offset;
+    UInt32 numPackets;
+    UInt64 firstTime;
+    UInt64 lastTime;
+    UInt64 seq;
+} CaptureState;
+
+typedef struct ConsumerResult {
+    UInt32 ring;
+    UInt64 packets;
+    UInt64 blocks;
+    UInt64 badSeq;
+    UInt64 badOrder;
+    UInt64 torn;
+} ConsumerResult;
+
+static UInt8 area[kPageSize + (kRtlCaptureRingCount * kBlocks * kBlockSize)];
+static RtlCaptureHeader *hdr = (RtlCaptureHeader *)area;
+static CaptureState state[kRtlCaptureRingCount];
+static volatile int producerDone;
+
+static RtlCaptureBlock *captureBlock(UInt32 ring, UInt32 index)
+{
+    return (RtlCaptureBlock *)(area + kPageSize + (((ring * kBlocks) + index) * kBlockSize));
+}
+
+/* The frame length and content are derived from the packet's number. */
+static UInt32 frameLen(UInt64 n)
+{
+    return 60 + (UInt32)(n % 1455);
+}
+
+static UInt8 frameByte(UInt64 n, UInt32 i)
+{
+    return (UInt8)(n + i);
+}
+
+/* Same protocol as LucyRTL8125::captureRetire(). */
+static void captureRetire(UInt32 ring)
+{
+    CaptureState *s = &state[ring];
+    RtlCaptureBlock *block = captureBlock(ring, s->block);
+    
+    block->numPackets = s->numPackets;
+    block->firstOffset = sizeof(RtlCaptureBlock);
+    block->length = s->offset;
+    block->seq = s->seq++;
+    block->firstTime = s->firstTime;
+    block->lastTime = s->lastTime;
+    
+    wmb();
+    __atomic_store_n(&block->status, kRtlBlockUser, __ATOMIC_RELAXED);
+    
+    if (++s->block >= kBlocks)
+        s->block = 0;
+    
+    s->numPackets = 0;
+}
+
+/*
+ * Same protocol as LucyRTL8125::captureFrame(), the packet's number
+ * serves as its time stamp.
+ */
+static void captureFrame(UInt32 ring, UInt64 n)
+{
+    CaptureState *s = &state[ring];
+    RtlCaptureBlock *block;
+    RtlCapturePacket *pkt;
+    UInt32 len = frameLen(n);
+    UInt32 capLen;
+    UInt32 size;
+    UInt32 i;
+    
+    capLen = (len < kSnapLen) ? len : kSnapLen;
+    size = (sizeof(RtlCapturePacket) + capLen + 7) & ~7;
+    
+    if (s->numPackets && (((s->offset + size) > kBlockSize) || (s->numPackets >= kRetireEvery)))
+        captureRetire(ring);
+    
+    block = captureBlock(ring, s->block);
+    
+    if (!s->numPackets) {
+        if (__atomic_load_n(&block->status, __ATOMIC_RELAXED) != kRtlBlockKernel) {
+            hdr->ring[ring].drops++;
+            return;
+        }
+        s->offset = sizeof(RtlCaptureBlock);
+        s->firstTime = n;
+    }
+    pkt = (RtlCapturePacket *)((UInt8 *)block + s->offset);
+    pkt->nextOffset = size;
+    pkt->capLen = capLen;
+    pkt->wireLen = len;
+    pkt->status = 0;
+    pkt->time = n;
+    pkt->vlanTag = 0;
+    
+    for (i = 0; i < capLen; i++)
+        ((UInt8 *)(pkt + 1))[i] = frameByte(n, i);
+    
+    s->offset += size;
+    s->numPackets++;
+    s->lastTime = n;
+    hdr->ring[ring].packets++;
+}
+
+static void initArea(void)
+{
+    UInt32 i;
+    
+    memset(area, 0, sizeof(area));
+    memset(state, 0, sizeof(state));
+    
+    hdr->version = kRtlCaptureVersion;
+    hdr->size = sizeof(area);
+    hdr->blockSize = kBlockSize;
+    hdr->snapLen = kSnapLen;
+    hdr->retireMS = kRtlCaptureRetireMS;
+    
+    for (i = 0; i < kRtlCaptureRingCount; i++) {
+        hdr->ring[i].firstBlock = kPageSize + (i * kBlocks * kBlockSize);
+        hdr->ring[i].blockCount = kBlocks;
+    }
+}
+
+/* Checks a block's packets, returns 0 if it's consistent. */
+static int checkBlock(const RtlCaptureBlock *block, UInt64 *last, ConsumerResult *res)
+{
+    const RtlCapturePacket *pkt;
+    UInt32 offset = block->firstOffset;
+    UInt32 i, j;
+    
+    for (i = 0; i < block->numPackets; i++) {
+        if ((offset + sizeof(RtlCapturePacket) > block->length) || (offset + sizeof(RtlCapturePacket) > kBlockSize))
+            return 1;
+        
+        pkt = (const RtlCapturePacket *)((const UInt8 *)block + offset);
+        
+        if ((pkt->time <= *last) || (!i && (pkt->time != block->firstTime)))
+            res->badOrder++;
+        
+        *last = pkt->time;
+        
+        if ((pkt->wireLen != frameLen(pkt->time)) || (pkt->capLen != ((pkt->wireLen < kSnapLen) ? pkt->wireLen : kSnapLen)))
+            return 1;
+        
+        for (j = 0; j < pkt->capLen; j++) {
+            if (((const UInt8 *)(pkt + 1))[j] != frameByte(pkt->time, j))
+                return 1;
+        }
+        offset += pkt->nextOffset;
+        res->packets++;
+    }
+    if ((offset != block->length) || (*last != block->lastTime))
+        return 1;
+    
+    return 0;
+}
+
+static void *producerThread(void *arg)
+{
+    UInt32 ring = (UInt32)(uintptr_t)arg;
+    UInt64 n;
+    
+    for (n = 1; n <= kPackets; n++) {
+        captureFrame(ring, n);
+        
+        /* Let the consumer catch up, even on a single CPU. */
+        if (!(n & 127))
+            sched_yield();
+    }
+    /* Hand over the last block as captureStop() does. */
+    if (state[ring].numPackets)
+        captureRetire(ring);
+    
+    return NULL;
+}
+
+static void *consumerThread(void *arg)
+{
+    ConsumerResult *res = (ConsumerResult *)arg;
+    RtlCaptureBlock *block;
+    UInt64 last = 0;
+    UInt32 index = 0;
+    int done;
+    
+    while (1) {
+        /* Read the flag first so that the last block can't be missed. */
+        done = __atomic_load_n(&producerDone, __ATOMIC_ACQUIRE);
+        block = RtlCaptureNextBlock(area, res->ring, &index);
+        
+        if (!block) {
+            if (done)
+                break;
+            
+            sched_yield();
+            continue;
+        }
+        if (block->seq != res->blocks)
+            res->badSeq++;
+        
+        if (checkBlock(block, &last, res))
+            res->torn++;
+        
+        res->blocks++;
+        RtlCaptureReleaseBlock(block);
+        
+        /* Fall behind now and then to make the producer drop packets. */
+        if (!(res->blocks & 63))
+            sched_yield();
+    }
+    return NULL;
+}
+
+/*
+ * A producer and a consumer per ring. Each packet must either be
+ * delivered intact and in order or be counted as a drop.
+ */
+static int testConcurrent(void)
+{
+    pthread_t producers[kRtlCaptureRingCount], consumers[kRtlCaptureRingCount];
+    ConsumerResult res[kRtlCaptureRingCount];
+    int failed = 0;
+    UInt32 i;
+    
+    initArea();
+    producerDone = 0;
+    memset(res, 0, sizeof(res));
+    
+    for (i = 0; i < kRtlCaptureRingCount; i++) {
+        res[i].ring = i;
+        pthread_create(&consumers[i], NULL, consumerThread, &res[i]);
+        pthread_create(&producers[i], NULL, producerThread, (void *)(uintptr_t)i);
+    }
+    for (i = 0; i < kRtlCaptureRingCount; i++)
+        pthread_join(producers[i], NULL);
+    
+    __atomic_store_n(&producerDone, 1, __ATOMIC_RELEASE);
+    
+    for (i = 0; i < kRtlCaptureRingCount; i++) {
+        pthread_join(consumers[i], NULL);
+        
+        printf("concurrent ring %u: %llu packets in %llu blocks, %llu dropped, %llu bad seq, %llu out of order, %llu torn\n", i,
+               (unsigned long long)res[i].packets, (unsigned long long)res[i].blocks,
+               (unsigned long long)hdr->ring[i].drops, (unsigned long long)res[i].badSeq,
+               (unsigned long long)res[i].badOrder, (unsigned long long)res[i].torn);
+        
+        if (res[i].badSeq || res[i].badOrder || res[i].torn || !res[i].packets ||
+            (res[i].packets != hdr->ring[i].packets) ||
+            ((res[i].packets + hdr->ring[i].drops) != kPackets))
+            failed = 1;
+    }
+    return failed;
+}
+
+/*
+ * A consumer which doesn't return its blocks gets each one once, the
+ * driver drops everything else until the next block is returned.
+ */
+static int testStalled(void)
+{
+    RtlCaptureBlock *block;
+    ConsumerResult res;
+    UInt64 last = 0;
+    UInt64 n = 1;
+    UInt32 index = 0;
+    UInt32 i;
+    int failed = 0;
+    
+    initArea();
+    memset(&res, 0, sizeof(res));
+    
+    for (; n <= 1000; n++)
+        captureFrame(kRtlCaptureRx, n);
+    
+    /* The producer has filled every block and is waiting for the first one. */
+    for (i = 0; i < kBlocks; i++) {
+        block = RtlCaptureNextBlock(area, kRtlCaptureRx, &index);
+        
+        if (!block || (block->seq != i) || checkBlock(block, &last, &res))
+            failed = 1;
+    }
+    if (!hdr->ring[kRtlCaptureRx].drops || (res.packets != hdr->ring[kRtlCaptureRx].packets) ||
+        ((res.packets + hdr->ring[kRtlCaptureRx].drops) != (n - 1)))
+        failed = 1;
+    
+    /* Returning the first block lets the producer continue there. */
+    RtlCaptureReleaseBlock(captureBlock(kRtlCaptureRx, 0));
+    captureFrame(kRtlCaptureRx, n);
+    
+    if (captureBlock(kRtlCaptureRx, 0)->status != kRtlBlockKernel)
+        failed = 1;
+    
+    captureRetire(kRtlCaptureRx);
+    
+    block = RtlCaptureNextBlock(area, kRtlCaptureRx, &index);
+    
+    if (!block || (block != captureBlock(kRtlCaptureRx, 0)) || (block->seq != kBlocks) ||
+        (block->numPackets != 1) || checkBlock(block, &last, &res))
+        failed = 1;
+    
+    printf("stalled: %s\n", failed ? "unexpected" : "ok");
+    
+    return failed;
+}
+
+int main(int argc, char *argv[])
+{
+    int failed = 0;
+    
+    failed += testStalled();
+    failed += testConcurrent();
+    
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+    
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,271 @@
+/* FormatTest.c -- Tests of the diagnostics formatting of the tools.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "RtlStatsFormat.h"
+
+static char *outBuf;
+static size_t outSize;
+
+/* The formatters write into a memory stream to compare their output. */
+static FILE *beginOutput(void)
+{
+    return open_memstream(&outBuf, &outSize);
+}
+
+/* Closes the stream, returns 0 if its content is as expected. */
+static int endOutput(FILE *out, const char *expected)
+{
+    int mismatch;
+    
+    fclose(out);
+    mismatch = (strcmp(outBuf, expected) != 0);
+    
+    if (mismatch)
+        printf("expected:\n%s\ngot:\n%s\n", expected, outBuf);
+    
+    free(outBuf);
+    outBuf = NULL;
+    
+    return mismatch;
+}
+
+/*
+ * Markers of a start-up, partly out of order, and of a link-up much
+ * later, followed by a restart of the driver.
+ */
+static int testTimeline(void)
+{
+    RtlPhaseEntry entries[] = {
+        { "start", 5000000 },
+        { "identifyChip", 5001000 },
+        { "initRTL8125", 5003000 },
+        { "PHY MCU patch", 5010000 },
+        { "ephy config", 5005000 },
+        { "setupRTL8125", 5011000 },
+        { "setLinkUp", 65000000 },
+        { "start", 65000500 },
+        { "identifyChip", 65000500 },
+    };
+    const char *expected =
+        "5.000000 s since boot:\n"
+        "     0.000 ms     +0.000 ms  start\n"
+        "     1.000 ms     +1.000 ms  identifyChip              ##\n"
+        "     3.000 ms     +2.000 ms  initRTL8125               ####\n"
+        "     5.000 ms     +2.000 ms  ephy config               ####\n"
+        "    10.000 ms     +5.000 ms  PHY MCU patch             ##########\n"
+        "    11.000 ms     +1.000 ms  setupRTL8125              ##\n"
+        "\n"
+        "65.000000 s since boot:\n"
+        "     0.000 ms     +0.000 ms  setLinkUp\n"
+        "\n"
+        "65.000500 s since boot:\n"
+        "     0.000 ms     +0.000 ms  start\n"
+        "     0.000 ms     +0.000 ms  identifyChip\n";
+    FILE *out;
+    int failed;
+    
+    out = beginOutput();
+    RtlPrintTimeline(out, entries, sizeof(entries) / sizeof(entries[0]), 10);
+    failed = endOutput(out, expected);
+    
+    out = beginOutput();
+    RtlPrintTimeline(out, entries, 0, 10);
+    failed |= endOutput(out, "");
+    
+    printf("timeline: %s\n", failed ? "unexpected" : "ok");
+    
+    return failed;
+}
+
+/* A tx hang as snapshotTrace() records it, ending with the recovery. */
+static int testTrace(void)
+{
+    static const RtlTraceRecord records[] = {
+        { "interrupt", 1000000, 0x0025, 0x8035 },
+        { "pollMode", 1000010, 1, 0x8020 },
+        { "rx", 1000100, 17, 64 },
+        { "txTail", 1000200, 65530, 3 },
+        { "txClose", 1000300, 65529, 0 },
+        { "pciError", 1000400, 0x0406, 0x2810 },
+        { "txHang", 1005000, 65529, 4 },
+        { "intrMask", 1005100, 0, 0 },
+        { "recovery", 1005200, 1, 0 },
+        { "recoveryDone", 1006700, 1, 1500 },
+        { "future", 1006800, 1, 2 },
+    };
+    const char *expected =
+        "Trace snapshot for txHang, 11 entries:\n"
+        "      -6.800 ms  interrupt     status LinkChg|TxOK|RxOK, mask SYSErr|LinkChg|RxDescUnavail|TxOK|RxOK\n"
+        "      -6.790 ms  pollMode      on, mask SYSErr|LinkChg\n"
+        "      -6.700 ms  rx            next 17, 64 packets\n"
+        "      -6.600 ms  txTail        tail 65530, 3 free\n"
+        "      -6.500 ms  txClose       close 65529, 0 done\n"
+        "      -6.400 ms  pciError      command 0x0406, status MasterAbort|SignaledTargetAbort|0x10\n"
+        "      -1.800 ms  txHang        close 65529, tail 4, 11 pending\n"
+        "      -1.700 ms  intrMask      mask none\n"
+        "      -1.600 ms  recovery      MAC reset\n"
+        "      -0.100 ms  recoveryDone  MAC reset, 1500 µs outage\n"
+        "       0.000 ms  future        0x00000001 0x00000002\n";
+    FILE *out;
+    int failed;
+    
+    out = beginOutput();
+    RtlPrintTrace(out, "txHang", records, sizeof(records) / sizeof(records[0]));
+    failed = endOutput(out, expected);
+    
+    out = beginOutput();
+    RtlPrintTrace(out, "pciError", records, 0);
+    failed |= endOutput(out, "Trace snapshot for pciError, 0 entries:\n");
+    
+    printf("trace: %s\n", failed ? "unexpected" : "ok");
+    
+    return failed;
+}
+
+static UInt64 oldBuf[512], newBuf[512];
+
+/* Sets up a dump of zeroed elements in buf, returns its data. */
+static UInt8 *makeDump(UInt64 *buf, UInt32 type, UInt32 count, UInt32 elementSize, UInt64 time, size_t *size)
+{
+    RtlDumpHeader *hdr = (RtlDumpHeader *)buf;
+    
+    *size = sizeof(RtlDumpHeader) + (count * elementSize);
+    
+    if ((type == kRtlDumpRxRing) || (type == kRtlDumpTxRing))
+        *size += sizeof(RtlRingState);
+    
+    memset(buf, 0, *size);
+    hdr->type = type;
+    hdr->version = kRtlDumpVersion;
+    hdr->count = count;
+    hdr->elementSize = elementSize;
+    hdr->time = time;
+    
+    return (UInt8 *)(hdr + 1);
+}
+
+static void putLE32(UInt8 *p, UInt32 value)
+{
+    p[0] = value & 0xff;
+    p[1] = (value >> 8) & 0xff;
+    p[2] = (value >> 16) & 0xff;
+    p[3] = value >> 24;
+}
+
+/* Compares the diff's output and its number of differences. */
+static int checkDiff(int diffs, const char *expected)
+{
+    FILE *out = beginOutput();
+    int result = RtlPrintDumpDiff(out, oldBuf, newBuf);
+    
+    return endOutput(out, expected) | (result != diffs);
+}
+
+static int testDumpDiff(void)
+{
+    RtlRingState *oldRing, *newRing;
+    UInt8 *oldData, *newData;
+    size_t oldSize, newSize;
+    int failed = 0;
+    
+    oldData = makeDump(oldBuf, kRtlDumpMacRegs, 256, 1, 1000000000, &oldSize);
+    newData = makeDump(newBuf, kRtlDumpMacRegs, 256, 1, 1500000000, &newSize);
+    oldData[0x37] = 0x0c;
+    newData[0x37] = 0x1c;
+    newData[0x80] = 0xff;
+    
+    failed |= (RtlCheckDump(oldBuf, oldSize) != 0) || (RtlCheckDump(oldBuf, oldSize - 1) != EINVAL);
+    failed |= checkDiff(2, "MAC registers, 0.500 s apart:\n"
+                           "0x037: 0x0c -> 0x1c\n"
+                           "0x080: 0x00 -> 0xff\n"
+                           "2 differences\n");
+    
+    /* PHY registers are listed by number. */
+    oldData = makeDump(oldBuf, kRtlDumpEthPhy, 16, 2, 0, &oldSize);
+    newData = makeDump(newBuf, kRtlDumpEthPhy, 16, 2, 2000000, &newSize);
+    ((UInt16 *)oldData)[1] = 0x7949;
+    ((UInt16 *)newData)[1] = 0x796d;
+    
+    failed |= checkDiff(1, "PHY registers, 0.002 s apart:\n"
+                           "0x001: 0x7949 -> 0x796d\n"
+                           "1 differences\n");
+    
+    /* A counter going backwards means the driver was reloaded. */
+    oldData = makeDump(oldBuf, kRtlDumpTally, 3, 8, 0, &oldSize);
+    newData = makeDump(newBuf, kRtlDumpTally, 3, 8, 1000000000, &newSize);
+    ((UInt64 *)oldData)[0] = 100;
+    ((UInt64 *)newData)[0] = 150;
+    ((UInt64 *)oldData)[1] = 9;
+    ((UInt64 *)newData)[1] = 9;
+    ((UInt64 *)oldData)[2] = 7;
+    ((UInt64 *)newData)[2] = 2;
+    
+    failed |= checkDiff(2, "tally counters, 1.000 s apart:\n"
+                           "tally[0]: 100 -> 150 (+50)\n"
+                           "tally[2]: 7 -> 2 (reset)\n"
+                           "2 differences\n");
+    
+    oldData = makeDump(oldBuf, kRtlDumpTxRing, 4, 16, 0, &oldSize);
+    newData = makeDump(newBuf, kRtlDumpTxRing, 4, 16, 0, &newSize);
+    oldRing = (RtlRingState *)oldData;
+    newRing = (RtlRingState *)newData;
+    oldRing->numDesc = newRing->numDesc = 4;
+    oldRing->nextIndex = 1;
+    oldRing->numFree = 3;
+    newRing->nextIndex = 3;
+    newRing->numFree = 1;
+    putLE32(newData + sizeof(RtlRingState) + 16, 0xb0000040);
+    putLE32(newData + sizeof(RtlRingState) + 24, 0x12345678);
+    putLE32(newData + sizeof(RtlRingState) + 28, 0x00000001);
+    
+    failed |= (RtlCheckDump(newBuf, newSize) != 0);
+    failed |= checkDiff(3, "tx ring, 0.000 s apart:\n"
+                           "nextIndex  1 -> 3\n"
+                           "numFree    3 -> 1\n"
+                           "desc 1: 00000000 00000000 00000000 00000000 -> b0000040 00000000 12345678 00000001\n"
+                           "3 differences\n");
+    
+    /* Dumps of different types can't be compared. */
+    makeDump(oldBuf, kRtlDumpMacRegs, 256, 1, 0, &oldSize);
+    ((RtlDumpHeader *)newBuf)->version = kRtlDumpVersion + 1;
+    
+    failed |= (RtlCheckDump(newBuf, newSize) != EINVAL);
+    failed |= checkDiff(-1, "");
+    
+    printf("dump diff: %s\n", failed ? "unexpected" : "ok");
+    
+    return failed;
+}
+
+int main(int argc, char *argv[])
+{
+    int failed = 0;
+    
+    failed += testTimeline();
+    failed += testTrace();
+    failed += testDumpDiff();
+    
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+    
+    return failed ? 1 : 0;
+}
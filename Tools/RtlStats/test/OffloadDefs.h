@@ -0,0 +1,75 @@
+/*
+ * Definitions LucyRTL8125Offload.hpp expects from its includer, copied
+ * from the driver's and the kernel's headers, which can't be used in
+ * user space.
+ */
+
+#ifndef OffloadDefs_h
+#define OffloadDefs_h
+
+#include <string.h>
+#include <netinet/in.h>
+
+#include <IOKit/IOTypes.h>
+
+#ifdef __APPLE__
+#include <libkern/OSByteOrder.h>
+#else
+#include <endian.h>
+
+/* libkern/OSByteOrder.h */
+#define OSSwapHostToBigInt16(x) htobe16(x)
+#endif
+
+/* LucyRTL8125Linux-900501.hpp */
+enum {
+    GiantSendv4 = (1 << 26),
+    GiantSendv6 = (1 << 25),
+    TxUDPCS_C   = (1U << 31),
+    TxTCPCS_C   = (1 << 30),
+    TxIPCS_C    = (1 << 29),
+    TxIPV6F_C   = (1 << 28),
+};
+
+enum {
+    RxIPF       = (1 << 16),
+    RxUDPF      = (1 << 15),
+    RxTCPF      = (1 << 14),
+    RxUDPT      = (1 << 18),
+    RxTCPT      = (1 << 17),
+    RxV4F       = (1 << 30),
+};
+
+enum {
+    RxIPF_v3    = (1 << 26),
+    RxUDPF_v3   = (1 << 25),
+    RxTCPF_v3   = (1 << 24),
+    RxUDPT_v3   = (1 << 29),
+    RxTCPT_v3   = (1 << 28),
+};
+
+#define TCPHO_SHIFT                     18
+#define TCPHO_MAX                       0x3ffU
+
+/* LucyRTL8125Ethernet.hpp */
+#define kMacHdrLen      14
+#define kIPv6HdrLen     40
+
+/* IOKit/network/IONetworkController.h */
+enum {
+    kChecksumIP                  = 0x0001,
+    kChecksumTCP                 = 0x0002,
+    kChecksumUDP                 = 0x0004,
+    kChecksumTCPIPv6             = 0x0020,
+    kChecksumUDPIPv6             = 0x0040,
+};
+
+/* sys/kpi_mbuf.h */
+enum {
+    MBUF_CSUM_DID_IP        = 0x0100,
+    MBUF_CSUM_IP_GOOD       = 0x0200,
+    MBUF_CSUM_DID_DATA      = 0x0400,
+    MBUF_CSUM_PSEUDO_HDR    = 0x0800
+};
+
+#endif /* OffloadDefs_h */
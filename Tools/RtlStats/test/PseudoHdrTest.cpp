@@ -0,0 +1,117 @@
+/* PseudoHdrTest.cpp -- Tests of the TSO pseudo header checksum.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "OffloadDefs.h"
+#include "LucyRTL8125Offload.hpp"
+
+#define kRandomHeaders  1000000
+
+/* IPv4 and IPv6 source and destination addresses in network byte order. */
+#define kIPv4AddrLen    8
+#define kIPv6AddrLen    32
+
+/*
+ * The scalar loop prepareTSO4() and prepareTSO6() used before
+ * pseudoHdrCsum(), which returns the checksum in network byte order.
+ */
+static UInt16 scalarCsum(const UInt8 *addr, UInt32 len)
+{
+    UInt32 csum32 = 6;
+    UInt16 w;
+    UInt32 i;
+    
+    for (i = 0; i < len; i += 2) {
+        memcpy(&w, addr + i, sizeof(w));
+        csum32 += ntohs(w);
+        csum32 += (csum32 >> 16);
+        csum32 &= 0xffff;
+    }
+    return htons((UInt16)csum32);
+}
+
+static int check(const UInt8 *addr, UInt32 len)
+{
+    UInt16 fast = pseudoHdrCsum(addr, len);
+    UInt16 scalar = scalarCsum(addr, len);
+    UInt32 i;
+    
+    if (fast != scalar) {
+        printf("len %u, addresses", len);
+        
+        for (i = 0; i < len; i++)
+            printf(" %02x", addr[i]);
+        
+        printf(": 0x%04x, expected 0x%04x\n", fast, scalar);
+        return 1;
+    }
+    return 0;
+}
+
+/* Fills the addresses with a constant byte to provoke the carry corner cases. */
+static int testPatterns(UInt32 len)
+{
+    UInt8 addr[kIPv6AddrLen];
+    int failed = 0;
+    int b;
+    
+    for (b = 0; b < 256; b++) {
+        memset(addr, b, len);
+        failed |= check(addr, len);
+    }
+    printf("patterns %u: %s\n", len, failed ? "mismatch" : "ok");
+    
+    return failed;
+}
+
+/* Random addresses, biased towards 0xff bytes to generate long carry chains. */
+static int testRandom(UInt32 len)
+{
+    UInt8 addr[kIPv6AddrLen];
+    int failed = 0;
+    UInt32 i, j;
+    
+    srand(8125);
+    
+    for (i = 0; i < kRandomHeaders; i++) {
+        for (j = 0; j < len; j++)
+            addr[j] = (rand() & 1) ? 0xff : (UInt8)rand();
+        
+        if (check(addr, len) && (++failed > 10))
+            break;
+    }
+    printf("random %u: %s\n", len, failed ? "mismatch" : "ok");
+    
+    return failed;
+}
+
+int main(int argc, char *argv[])
+{
+    int failed = 0;
+    
+    failed += testPatterns(kIPv4AddrLen);
+    failed += testPatterns(kIPv6AddrLen);
+    failed += testRandom(kIPv4AddrLen);
+    failed += testRandom(kIPv6AddrLen);
+    
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+    
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,389 @@
+/* PtpClockTest.cpp -- Tests of the PTP clock model and event frame parser.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "LucyRTL8125UserClient.hpp"
+#include "LucyRTL8125Ptp.hpp"
+
+/* Hardware time when the tests start, some time in 2020. */
+#define kHwStart    (1600000000ULL * kPtpNsPerSec)
+
+/* Offset of the simulated oscillator in ppb. */
+#define kDrift      37000
+
+static SInt64 absDiff(UInt64 a, UInt64 b)
+{
+    return (a > b) ? (SInt64)(a - b) : (SInt64)(b - a);
+}
+
+/* A rate offset of ppb adds ppb ns per second of hardware time. */
+static int testRate(void)
+{
+    static const SInt64 rates[] = { 0, 1, -1, 100000, -100000, kRtlPtpMaxFreqPpb, -kRtlPtpMaxFreqPpb };
+    RtlPtpClock clock;
+    UInt64 t;
+    UInt32 i;
+    int failed = 0;
+    
+    for (i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        ptpClockSet(&clock, kHwStart, 5 * kPtpNsPerSec);
+        clock.ppb = rates[i];
+        
+        t = ptpClockTime(&clock, kHwStart + kPtpNsPerSec);
+        
+        if (t != (UInt64)((6 * kPtpNsPerSec) + rates[i])) {
+            printf("rate %lld: %llu after 1 s\n", (long long)rates[i], (unsigned long long)t);
+            failed = 1;
+        }
+        t = ptpClockTime(&clock, kHwStart + (kPtpNsPerSec / 2));
+        
+        if (t != (UInt64)((5 * kPtpNsPerSec) + (kPtpNsPerSec / 2) + (rates[i] / 2))) {
+            printf("rate %lld: %llu after 0.5 s\n", (long long)rates[i], (unsigned long long)t);
+            failed = 1;
+        }
+    }
+    printf("rate: %s\n", failed ? "unexpected" : "ok");
+    
+    return failed;
+}
+
+/*
+ * Rate changes at random times must neither step the clock nor make it
+ * go backwards.
+ */
+static int testContinuity(void)
+{
+    RtlPtpClock clock;
+    UInt64 hw = kHwStart;
+    UInt64 before, after, last = 0;
+    SInt64 ppb;
+    int failed = 0;
+    int i;
+    
+    srand(8125);
+    ptpClockSet(&clock, hw, kHwStart);
+    clock.ppb = 0;
+    
+    for (i = 0; i < 100000; i++) {
+        hw += rand() % 2000000;
+        ppb = (rand() % (2 * kRtlPtpMaxFreqPpb + 1)) - kRtlPtpMaxFreqPpb;
+        
+        before = ptpClockTime(&clock, hw);
+        ptpClockSetRate(&clock, hw, ppb);
+        after = ptpClockTime(&clock, hw);
+        
+        if ((before != after) || (after < last)) {
+            printf("step %d: %llu before, %llu after, %llu last\n", i, (unsigned long long)before,
+                   (unsigned long long)after, (unsigned long long)last);
+            failed = 1;
+            break;
+        }
+        last = after;
+    }
+    printf("continuity: %s\n", failed ? "unexpected" : "ok");
+    
+    return failed;
+}
+
+/* Steps are exact, the clock doesn't go below zero. */
+static int testAdjust(void)
+{
+    RtlPtpClock clock;
+    UInt64 hw = kHwStart + 12345;
+    int failed = 0;
+    
+    ptpClockSet(&clock, kHwStart, 1000 * kPtpNsPerSec);
+    clock.ppb = 250000;
+    
+    ptpClockAdjust(&clock, hw, 5000);
+    
+    if (ptpClockTime(&clock, hw) != (1000 * kPtpNsPerSec) + 12348 + 5000)
+        failed = 1;
+    
+    ptpClockAdjust(&clock, hw, -(5000 + 3 * kPtpNsPerSec));
+    
+    if (ptpClockTime(&clock, hw) != (997 * kPtpNsPerSec) + 12348)
+        failed = 1;
+    
+    /* The rate stays as it was. */
+    if ((clock.ppb != 250000) || (ptpClockTime(&clock, hw + kPtpNsPerSec) != (998 * kPtpNsPerSec) + 12348 + 250000))
+        failed = 1;
+    
+    ptpClockAdjust(&clock, hw, -(2000 * kPtpNsPerSec));
+    
+    if (ptpClockTime(&clock, hw) != 0)
+        failed = 1;
+    
+    printf("adjust: %s\n", failed ? "unexpected" : "ok");
+    
+    return failed;
+}
+
+/*
+ * Time stamps may be older than the last change of the clock and the
+ * elapsed time may be long, the result must stay within 1 ns of the
+ * exact value.
+ */
+static int testRange(void)
+{
+    static const SInt64 elapsed[] = {
+        -1, -999999999, -kPtpNsPerSec, -7 * kPtpNsPerSec - 1,
+        1, 999999999, 86400 * kPtpNsPerSec + 1, 1000000 * kPtpNsPerSec + 123456789
+    };
+    static const SInt64 rates[] = { 1, -1, 999999, -999999, kRtlPtpMaxFreqPpb, -kRtlPtpMaxFreqPpb };
+    RtlPtpClock clock;
+    long double exact;
+    UInt64 t;
+    UInt32 i, j;
+    int failed = 0;
+    
+    for (i = 0; i < sizeof(elapsed) / sizeof(elapsed[0]); i++) {
+        for (j = 0; j < sizeof(rates) / sizeof(rates[0]); j++) {
+            ptpClockSet(&clock, kHwStart, kHwStart);
+            clock.ppb = rates[j];
+            
+            t = ptpClockTime(&clock, kHwStart + elapsed[i]);
+            exact = (long double)kHwStart + (long double)elapsed[i] * (1.0L + (long double)rates[j] / 1e9L);
+            
+            if (absDiff(t, (UInt64)(exact + 0.5L)) > 1) {
+                printf("elapsed %lld, rate %lld: %llu, exact %.1Lf\n", (long long)elapsed[i],
+                       (long long)rates[j], (unsigned long long)t, exact);
+                failed = 1;
+            }
+        }
+    }
+    printf("range: %s\n", failed ? "unexpected" : "ok");
+    
+    return failed;
+}
+
+/*
+ * A PI servo as run by a PTP daemon, which measures the clock's offset
+ * from a master once per second, must be able to compensate a drifting
+ * oscillator with the rate offset alone after an initial step.
+ */
+static int testServo(void)
+{
+    RtlPtpClock clock;
+    UInt64 t, hw;
+    SInt64 offset = 0;
+    SInt64 ppb;
+    double integral = 0;
+    int failed = 0;
+    int i;
+    
+    /* The clock starts 3 ms ahead of the master's time t. */
+    ptpClockSet(&clock, kHwStart, kHwStart + 3000000);
+    clock.ppb = 0;
+    
+    for (i = 1; i <= 120; i++) {
+        t = kHwStart + (i * kPtpNsPerSec);
+        hw = kHwStart + (i * kPtpNsPerSec) + (i * kDrift);
+        offset = (SInt64)(ptpClockTime(&clock, hw) - t);
+        
+        if ((offset > 1000000) || (offset < -1000000)) {
+            ptpClockAdjust(&clock, hw, -offset);
+            continue;
+        }
+        integral += 0.3 * offset;
+        ppb = -(SInt64)((0.7 * offset) + integral);
+        
+        if (ppb > kRtlPtpMaxFreqPpb)
+            ppb = kRtlPtpMaxFreqPpb;
+        else if (ppb < -kRtlPtpMaxFreqPpb)
+            ppb = -kRtlPtpMaxFreqPpb;
+        
+        ptpClockSetRate(&clock, hw, ppb);
+    }
+    /* A few ns and ppb of residual error are tolerated. */
+    if ((offset > 5) || (offset < -5) || ((clock.ppb + kDrift) > 10) || ((clock.ppb + kDrift) < -10))
+        failed = 1;
+    
+    printf("servo: offset %lld ns, rate %lld ppb: %s\n", (long long)offset, (long long)clock.ppb,
+           failed ? "unexpected" : "ok");
+    
+    return failed;
+}
+
+/* Writes a PTP header for messageType type at p. */
+static void putPtpHeader(UInt8 *p, UInt32 type, UInt16 seq)
+{
+    UInt32 i;
+    
+    p[0] = 0x10 | type;
+    p[1] = 2;
+    p[4] = 24;
+    
+    for (i = 0; i < 10; i++)
+        p[20 + i] = 0xa0 + i;
+    
+    p[30] = seq >> 8;
+    p[31] = seq & 0xff;
+}
+
+static void putUdp(UInt8 *p, UInt16 port)
+{
+    p[0] = port >> 8;
+    p[1] = port & 0xff;
+    p[2] = port >> 8;
+    p[3] = port & 0xff;
+}
+
+enum {
+    kFrameL2 = 0,
+    kFrameVlan,
+    kFrameIPv4,
+    kFrameIPv6,
+    kFrameCount
+};
+
+/*
+ * Builds a frame of the given kind with a PTP message of type msgType
+ * and returns its length.
+ */
+static UInt32 buildFrame(UInt8 *frame, UInt32 kind, UInt32 msgType, UInt16 port, UInt16 seq)
+{
+    UInt8 *p = frame + 12;
+    
+    memset(frame, 0, 128);
+    
+    if (kind == kFrameVlan) {
+        p[0] = 0x81;
+        p[2] = 0x00;
+        p[3] = 0x05;
+        p += 4;
+    }
+    switch (kind) {
+        case kFrameIPv4:
+            p[0] = 0x08;
+            p[2] = 0x45;
+            p[11] = 17;
+            putUdp(p + 22, port);
+            p += 30;
+            break;
+        
+        case kFrameIPv6:
+            p[0] = 0x86;
+            p[1] = 0xdd;
+            p[2] = 0x60;
+            p[8] = 17;
+            putUdp(p + 42, port);
+            p += 50;
+            break;
+        
+        default:
+            p[0] = 0x88;
+            p[1] = 0xf7;
+            p += 2;
+            break;
+    }
+    putPtpHeader(p, msgType, seq);
+    
+    return (UInt32)(p - frame) + kPtpHdrLen;
+}
+
+static int testParser(void)
+{
+    UInt8 frame[128];
+    RtlPtpStamp stamp;
+    const UInt8 *hdr;
+    UInt32 kind, type, len;
+    bool expected;
+    int failed = 0;
+    
+    for (kind = 0; kind < kFrameCount; kind++) {
+        for (type = 0; type < 16; type++) {
+            len = buildFrame(frame, kind, type, kPtpEventPort, 0x1234 + type);
+            hdr = ptpEventHeader(frame, len);
+            expected = (type < 4);
+            
+            if ((hdr != NULL) != expected) {
+                printf("frame %u, type %u: %s\n", kind, type, hdr ? "matched" : "not matched");
+                failed = 1;
+                continue;
+            }
+            if (!hdr)
+                continue;
+            
+            ptpFillStamp(&stamp, hdr, 42, kRtlPtpStampTx);
+            
+            if ((stamp.time != 42) || (stamp.direction != kRtlPtpStampTx) || (stamp.messageType != type) ||
+                (stamp.sequenceId != 0x1234 + type) || (stamp.domain != 24) ||
+                (stamp.sourcePort[0] != 0xa0) || (stamp.sourcePort[9] != 0xa9)) {
+                printf("frame %u, type %u: bad stamp\n", kind, type);
+                failed = 1;
+            }
+            /* The whole header must be in the frame. */
+            if (ptpEventHeader(frame, len - 1)) {
+                printf("frame %u, type %u: truncated header matched\n", kind, type);
+                failed = 1;
+            }
+        }
+        /* Event messages are only those sent to the event port. */
+        if (kind >= kFrameIPv4) {
+            len = buildFrame(frame, kind, 0, 320, 1);
+            
+            if (ptpEventHeader(frame, len)) {
+                printf("frame %u: general port matched\n", kind);
+                failed = 1;
+            }
+        }
+    }
+    /* Neither fragments nor other protocols. */
+    len = buildFrame(frame, kFrameIPv4, 0, kPtpEventPort, 1);
+    frame[20] = 0x20;
+    
+    if (ptpEventHeader(frame, len))
+        failed = 1;
+    
+    len = buildFrame(frame, kFrameIPv4, 0, kPtpEventPort, 1);
+    frame[23] = 6;
+    
+    if (ptpEventHeader(frame, len))
+        failed = 1;
+    
+    len = buildFrame(frame, kFrameL2, 0, 0, 1);
+    frame[12] = 0x08;
+    frame[13] = 0x06;
+    
+    if (ptpEventHeader(frame, len) || ptpEventHeader(frame, 13))
+        failed = 1;
+    
+    printf("parser: %s\n", failed ? "unexpected" : "ok");
+    
+    return failed;
+}
+
+int main(int argc, char *argv[])
+{
+    int failed = 0;
+    
+    failed += testRate();
+    failed += testContinuity();
+    failed += testAdjust();
+    failed += testRange();
+    failed += testServo();
+    failed += testParser();
+    
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+    
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,189 @@
+/* RxCsumTest.cpp -- Tests of the Rx checksum result table.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "OffloadDefs.h"
+#include "LucyRTL8125Offload.hpp"
+
+/* Random values of the status bits which don't take part in the lookup. */
+#define kNoisePatterns  1000
+
+static const UInt32 csumBits[6] = { RxTCPF, RxUDPF, RxIPF, RxTCPT, RxUDPT, RxV4F };
+static const UInt32 csumBitsV3[6] = { RxTCPF_v3, RxUDPF_v3, RxIPF_v3, RxTCPT_v3, RxUDPT_v3, RxV4F };
+
+/* The rules getChecksumResult() applied before the table. */
+static void referenceResult(UInt32 status1, UInt32 status2, UInt32 *performed, UInt32 *value)
+{
+    *performed = 0;
+    *value = 0;
+    
+    if ((status2 & RxV4F) && !(status1 & RxIPF))
+        *performed |= (MBUF_CSUM_DID_IP | MBUF_CSUM_IP_GOOD);
+    
+    if (((status1 & RxTCPT) && !(status1 & RxTCPF)) ||
+        ((status1 & RxUDPT) && !(status1 & RxUDPF))) {
+        *performed |= (MBUF_CSUM_DID_DATA | MBUF_CSUM_PSEUDO_HDR);
+        *value = 0xffff;
+    }
+}
+
+/* The same rules for a v3 descriptor, which has all of the bits in opts2. */
+static void referenceResultV3(UInt32 status2, UInt32 *performed, UInt32 *value)
+{
+    *performed = 0;
+    *value = 0;
+    
+    if ((status2 & RxV4F) && !(status2 & RxIPF_v3))
+        *performed |= (MBUF_CSUM_DID_IP | MBUF_CSUM_IP_GOOD);
+    
+    if (((status2 & RxTCPT_v3) && !(status2 & RxTCPF_v3)) ||
+        ((status2 & RxUDPT_v3) && !(status2 & RxUDPF_v3))) {
+        *performed |= (MBUF_CSUM_DID_DATA | MBUF_CSUM_PSEUDO_HDR);
+        *value = 0xffff;
+    }
+}
+
+static UInt32 randomWord(void)
+{
+    return ((UInt32)rand() << 16) ^ (UInt32)rand();
+}
+
+/*
+ * Checks one combination of checksum status bits, which are taken from
+ * status1 except RxV4F, together with the given unrelated bits.
+ */
+static int checkCombination(UInt32 combo, UInt32 noise1, UInt32 noise2)
+{
+    const UInt32 mask1 = RxTCPF | RxUDPF | RxIPF | RxTCPT | RxUDPT;
+    UInt32 status1 = noise1 & ~mask1;
+    UInt32 status2 = noise2 & ~(UInt32)RxV4F;
+    const RtlRxCsumResult *result;
+    UInt32 performed, value;
+    int i;
+    
+    for (i = 0; i < 5; i++) {
+        if (combo & (1 << i))
+            status1 |= csumBits[i];
+    }
+    if (combo & (1 << 5))
+        status2 |= RxV4F;
+    
+    referenceResult(status1, status2, &performed, &value);
+    result = &rxCsumResultTable[rxCsumIndex(status1, status2)];
+    
+    if ((result->performed != performed) || (result->value != value)) {
+        printf("status1 0x%08x, status2 0x%08x: table 0x%04x/0x%04x, reference 0x%04x/0x%04x\n",
+               status1, status2, result->performed, result->value, performed, value);
+        return 1;
+    }
+    return 0;
+}
+
+/* Same as checkCombination() for the v3 descriptor format. */
+static int checkCombinationV3(UInt32 combo, UInt32 noise2)
+{
+    const UInt32 mask2 = RxTCPF_v3 | RxUDPF_v3 | RxIPF_v3 | RxTCPT_v3 | RxUDPT_v3 | RxV4F;
+    UInt32 status2 = noise2 & ~mask2;
+    const RtlRxCsumResult *result;
+    UInt32 performed, value;
+    int i;
+    
+    for (i = 0; i < 6; i++) {
+        if (combo & (1 << i))
+            status2 |= csumBitsV3[i];
+    }
+    referenceResultV3(status2, &performed, &value);
+    result = &rxCsumResultTable[rxCsumIndexV3(status2)];
+    
+    if ((result->performed != performed) || (result->value != value)) {
+        printf("v3 status2 0x%08x: table 0x%04x/0x%04x, reference 0x%04x/0x%04x\n",
+               status2, result->performed, result->value, performed, value);
+        return 1;
+    }
+    return 0;
+}
+
+/* All 64 combinations without any other bits set. */
+static int testClean(void)
+{
+    UInt32 combo;
+    int failed = 0;
+    
+    for (combo = 0; combo < 64; combo++)
+        failed |= checkCombination(combo, 0, 0);
+    
+    printf("clean: %s\n", failed ? "mismatch" : "ok");
+    
+    return failed;
+}
+
+/* Unrelated status bits must not change the result. */
+static int testNoise(void)
+{
+    UInt32 combo;
+    int failed = 0;
+    int i;
+    
+    srand(8125);
+    
+    for (combo = 0; combo < 64; combo++) {
+        failed |= checkCombination(combo, ~0U, ~0U);
+        
+        for (i = 0; i < kNoisePatterns; i++)
+            failed |= checkCombination(combo, randomWord(), randomWord());
+    }
+    printf("noise: %s\n", failed ? "mismatch" : "ok");
+    
+    return failed;
+}
+
+/* The v3 index must lead to the same table entries. */
+static int testV3(void)
+{
+    UInt32 combo;
+    int failed = 0;
+    int i;
+    
+    srand(8125);
+    
+    for (combo = 0; combo < 64; combo++) {
+        failed |= checkCombinationV3(combo, 0);
+        failed |= checkCombinationV3(combo, ~0U);
+        
+        for (i = 0; i < kNoisePatterns; i++)
+            failed |= checkCombinationV3(combo, randomWord());
+    }
+    printf("v3: %s\n", failed ? "mismatch" : "ok");
+    
+    return failed;
+}
+
+int main(int argc, char *argv[])
+{
+    int failed = 0;
+    
+    failed += testClean();
+    failed += testNoise();
+    failed += testV3();
+    
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+    
+    return failed ? 1 : 0;
+}
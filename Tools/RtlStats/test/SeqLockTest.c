@@ -0,0 +1,202 @@
+/* SeqLockTest.c -- Tests of the statistics page's sequence lock.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "RtlStatsReader.h"
+
+#define kUpdates    200000
+#define kReaders    3
+
+/* Stores before the barrier become visible before those after it. */
+#define wmb() __atomic_thread_fence(__ATOMIC_RELEASE)
+
+static RtlStatsPage page;
+static volatile int writerDone;
+
+typedef struct ReaderResult {
+    UInt64 reads;
+    UInt64 torn;
+    UInt64 backwards;
+    UInt64 failed;
+} ReaderResult;
+
+/* Same protocol as LucyRTL8125::updateStatsPage(). */
+static void updatePage(UInt64 n)
+{
+    UInt32 i;
+    
+    __atomic_store_n(&page.seq, page.seq + 1, __ATOMIC_RELAXED);
+    wmb();
+    
+    page.updateTime = n;
+    page.speed = (UInt32)n;
+    page.txFreeDesc = (UInt32)n;
+    
+    for (i = 0; i < kRtlStatsPageMaxTally; i++)
+        page.tally[i] = n;
+    
+    /* Let the readers run into the update, even on a single CPU. */
+    if (!(n & 7))
+        sched_yield();
+    
+    for (i = 0; i < kRtlStatsPageMaxPath; i++)
+        page.path[i] = n;
+    
+    wmb();
+    __atomic_store_n(&page.seq, page.seq + 1, __ATOMIC_RELAXED);
+}
+
+static void *writerThread(void *arg)
+{
+    UInt64 n;
+    
+    for (n = 1; n <= kUpdates; n++)
+        updatePage(n);
+    
+    writerDone = 1;
+    
+    return NULL;
+}
+
+static void *readerThread(void *arg)
+{
+    ReaderResult *res = (ReaderResult *)arg;
+    RtlStatsPage copy;
+    UInt64 last = 0;
+    UInt64 n;
+    UInt32 i;
+    
+    while (!writerDone) {
+        if (RtlStatsSnapshot(&page, &copy)) {
+            res->failed++;
+            continue;
+        }
+        res->reads++;
+        n = copy.updateTime;
+        
+        if (n < last)
+            res->backwards++;
+        
+        last = n;
+        
+        if ((copy.speed != (UInt32)n) || (copy.txFreeDesc != (UInt32)n)) {
+            res->torn++;
+            continue;
+        }
+        for (i = 0; i < kRtlStatsPageMaxTally; i++) {
+            if (copy.tally[i] != n)
+                break;
+        }
+        if (i < kRtlStatsPageMaxTally) {
+            res->torn++;
+            continue;
+        }
+        for (i = 0; i < kRtlStatsPageMaxPath; i++) {
+            if (copy.path[i] != n)
+                break;
+        }
+        if (i < kRtlStatsPageMaxPath)
+            res->torn++;
+    }
+    return NULL;
+}
+
+static void initPage(void)
+{
+    memset(&page, 0, sizeof(page));
+    page.version = kRtlStatsPageVersion;
+    page.size = sizeof(RtlStatsPage);
+    page.tallyCount = kRtlStatsPageMaxTally;
+    page.pathCount = kRtlStatsPageMaxPath;
+}
+
+/* Concurrent readers must never see a mix of two updates. */
+static int testConcurrent(void)
+{
+    pthread_t writer, readers[kReaders];
+    ReaderResult res[kReaders];
+    UInt64 reads = 0, torn = 0, backwards = 0;
+    int i;
+    
+    initPage();
+    writerDone = 0;
+    memset(res, 0, sizeof(res));
+    
+    for (i = 0; i < kReaders; i++)
+        pthread_create(&readers[i], NULL, readerThread, &res[i]);
+    
+    pthread_create(&writer, NULL, writerThread, NULL);
+    pthread_join(writer, NULL);
+    
+    for (i = 0; i < kReaders; i++) {
+        pthread_join(readers[i], NULL);
+        reads += res[i].reads;
+        torn += res[i].torn;
+        backwards += res[i].backwards;
+    }
+    printf("concurrent: %llu reads, %llu torn, %llu backwards\n",
+           (unsigned long long)reads, (unsigned long long)torn, (unsigned long long)backwards);
+    
+    return (torn || backwards || !reads);
+}
+
+/* A page which stays locked makes the reader give up. */
+static int testLocked(void)
+{
+    RtlStatsPage copy;
+    int result;
+    
+    initPage();
+    page.seq = 1;
+    result = RtlStatsSnapshot(&page, &copy);
+    printf("locked: %s\n", (result == EAGAIN) ? "EAGAIN" : "unexpected");
+    
+    return (result != EAGAIN);
+}
+
+/* A page of another layout is refused. */
+static int testVersion(void)
+{
+    RtlStatsPage copy;
+    int result;
+    
+    initPage();
+    page.version = kRtlStatsPageVersion + 1;
+    result = RtlStatsSnapshot(&page, &copy);
+    printf("version: %s\n", (result == EINVAL) ? "EINVAL" : "unexpected");
+    
+    return (result != EINVAL);
+}
+
+int main(int argc, char *argv[])
+{
+    int failed = 0;
+    
+    failed += testLocked();
+    failed += testVersion();
+    failed += testConcurrent();
+    
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+    
+    return failed ? 1 : 0;
+}
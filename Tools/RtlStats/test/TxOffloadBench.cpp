@@ -0,0 +1,163 @@
+/* TxOffloadBench.cpp -- Microbenchmark of the Tx descriptor templates.
+*
+* Copyright (c) 2020 Laura Müller <laura-mueller@uni-duesseldorf.de>
+* All rights reserved.
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation; either version 2 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+* more details.
+*
+* Driver for Realtek RTL8125 PCIe 2.5GB ethernet controllers.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "OffloadDefs.h"
+#include "LucyRTL8125Offload.hpp"
+
+#define kPackets    (1 << 16)
+#define kRounds     200
+
+/* Checksum requests as the stack hands them to outputStart(). */
+static const UInt32 requestMix[] = {
+    kChecksumIP | kChecksumTCP,
+    kChecksumIP | kChecksumTCP,
+    kChecksumIP | kChecksumTCP,
+    kChecksumIP | kChecksumUDP,
+    kChecksumTCPIPv6,
+    kChecksumUDPIPv6,
+    kChecksumIP,
+    0,
+};
+
+static UInt32 requests[kPackets];
+
+/* The if/else chain outputStart() used before the template table. */
+static inline UInt32 chainOpts2(UInt32 offloadFlags)
+{
+    UInt32 opts2 = 0;
+    
+    if (offloadFlags & kChecksumTCP)
+        opts2 = (TxIPCS_C | TxTCPCS_C);
+    else if (offloadFlags & kChecksumTCPIPv6)
+        opts2 = (TxTCPCS_C | TxIPV6F_C | (((kMacHdrLen + kIPv6HdrLen) & TCPHO_MAX) << TCPHO_SHIFT));
+    else if (offloadFlags & kChecksumUDP)
+        opts2 = (TxIPCS_C | TxUDPCS_C);
+    else if (offloadFlags & kChecksumUDPIPv6)
+        opts2 = (TxUDPCS_C | TxIPV6F_C | (((kMacHdrLen + kIPv6HdrLen) & TCPHO_MAX) << TCPHO_SHIFT));
+    else if (offloadFlags & kChecksumIP)
+        opts2 = TxIPCS_C;
+    
+    return opts2;
+}
+
+/* The lookup outputStart() does now. */
+static inline UInt32 tableOpts2(UInt32 offloadFlags)
+{
+    return txDescTmplTable[txCsumClassMap[txCsumClassIndex(offloadFlags)]].opts2;
+}
+
+static __attribute__((noinline)) UInt32 runChain(void)
+{
+    UInt32 sum = 0;
+    UInt32 i;
+    
+    for (i = 0; i < kPackets; i++)
+        sum += chainOpts2(requests[i]);
+    
+    return sum;
+}
+
+static __attribute__((noinline)) UInt32 runTable(void)
+{
+    UInt32 sum = 0;
+    UInt32 i;
+    
+    for (i = 0; i < kPackets; i++)
+        sum += tableOpts2(requests[i]);
+    
+    return sum;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Nanoseconds per packet, best of kRounds to filter out interruptions. */
+static double measure(UInt32 (*run)(void), UInt32 *sum)
+{
+    double best = 0, start, t;
+    int i;
+    
+    for (i = 0; i < kRounds; i++) {
+        start = now();
+        *sum = run();
+        t = now() - start;
+        
+        if (!i || (t < best))
+            best = t;
+    }
+    return best / kPackets;
+}
+
+/* The table must match the chain for every combination of request bits. */
+static int testEquivalence(void)
+{
+    UInt32 flags;
+    int failed = 0;
+    
+    for (flags = 0; flags < 0x80; flags++) {
+        if (tableOpts2(flags) != chainOpts2(flags)) {
+            printf("flags 0x%02x: table 0x%08x, chain 0x%08x\n", flags, tableOpts2(flags), chainOpts2(flags));
+            failed = 1;
+        }
+    }
+    return failed;
+}
+
+static int bench(const char *name, UInt32 mask)
+{
+    UInt32 chainSum, tableSum;
+    double chain, table;
+    UInt32 i;
+    
+    srand(8125);
+    
+    for (i = 0; i < kPackets; i++)
+        requests[i] = requestMix[rand() & mask];
+    
+    chain = measure(runChain, &chainSum);
+    table = measure(runTable, &tableSum);
+    
+    printf("%s: chain %.2f ns/packet, table %.2f ns/packet\n", name, chain, table);
+    
+    return (chainSum != tableSum);
+}
+
+int main(int argc, char *argv[])
+{
+    int failed = 0;
+    
+    failed += testEquivalence();
+    
+    /* A bulk TCP/IPv4 transfer, then a random mix of requests. */
+    failed += bench("bulk", 0);
+    failed += bench("mixed", 7);
+    
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+    
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,17 @@
+/* Minimal stand-in for IOKit/IOTypes.h, used to build the tests on Linux. */
+
+#ifndef IOTypes_shim_h
+#define IOTypes_shim_h
+
+#include <stdint.h>
+
+typedef uint8_t UInt8;
+typedef uint16_t UInt16;
+typedef uint32_t UInt32;
+typedef uint64_t UInt64;
+typedef int8_t SInt8;
+typedef int16_t SInt16;
+typedef int32_t SInt32;
+typedef int64_t SInt64;
+
+#endif /* IOTypes_shim_h */
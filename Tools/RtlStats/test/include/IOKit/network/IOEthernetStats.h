@@ -0,0 +1,14 @@
+/*
+ * Minimal stand-in for IOKit/network/IOEthernetStats.h, used to build the
+ * tests on Linux. The layout differs from the real one, which the tests
+ * don't depend on.
+ */
+
+#ifndef IOEthernetStats_shim_h
+#define IOEthernetStats_shim_h
+
+typedef struct IOEthernetStats {
+    UInt32 counters[64];
+} IOEthernetStats;
+
+#endif /* IOEthernetStats_shim_h */
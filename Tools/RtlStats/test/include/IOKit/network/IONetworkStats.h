@@ -0,0 +1,14 @@
+/* Minimal stand-in for IOKit/network/IONetworkStats.h, used to build the tests on Linux. */
+
+#ifndef IONetworkStats_shim_h
+#define IONetworkStats_shim_h
+
+typedef struct IONetworkStats {
+    UInt32 inputPackets;
+    UInt32 inputErrors;
+    UInt32 outputPackets;
+    UInt32 outputErrors;
+    UInt32 collisions;
+} IONetworkStats;
+
+#endif /* IONetworkStats_shim_h */